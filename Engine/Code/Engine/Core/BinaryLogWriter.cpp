@@ -0,0 +1,111 @@
+#include "Engine/Core/BinaryLogWriter.hpp"
+#include "Engine/Core/LogFormat.hpp"
+#include "Engine/Core/Logger.hpp"
+#include "Engine/Time/Time.hpp"
+
+#include <string.h>
+
+
+BinaryLogWriter::~BinaryLogWriter()
+{
+    Close();
+}
+
+bool BinaryLogWriter::Open( const String& filePath )
+{
+    Close();
+    m_file = fopen( filePath.c_str(), "wb" );
+    if( nullptr == m_file )
+        return false;
+
+    m_buffer.reserve( WRITE_BUFFER_SIZE );
+    m_writtenTags.clear();
+    m_writtenFormats.clear();
+
+    LogFormat::BinaryLogHeader header;
+    memcpy( header.m_magic, LogFormat::BINARY_LOG_MAGIC, sizeof( header.m_magic ) );
+    header.m_version = LogFormat::BINARY_LOG_VERSION;
+    header.m_secondsPerTick = TimeUtils::GetSecondsPerTick();
+    header.m_startTicks = TimeUtils::GetCurrentTimeTicks();
+    WriteBytes( &header, sizeof( header ) );
+    return true;
+}
+
+void BinaryLogWriter::WriteEntry( const LogEntry* entry )
+{
+    if( !IsOpen() )
+        return;
+
+    WriteTagOnce( entry->m_tagId );
+    if( entry->m_formatId != LogFormat::INVALID_FORMAT_ID )
+        WriteFormatOnce( entry->m_formatId );
+
+    WriteValue( LogFormat::RecordType::ENTRY );
+    WriteValue( entry->m_ticks );
+    WriteValue( entry->m_threadId );
+    WriteValue( entry->m_tagId );
+    WriteValue( entry->m_formatId );
+    WriteValue( entry->m_payloadSize );
+    WriteBytes( entry->m_payload, entry->m_payloadSize );
+
+    if( (int) m_buffer.size() >= WRITE_BUFFER_SIZE )
+        Flush();
+}
+
+void BinaryLogWriter::Flush()
+{
+    if( !IsOpen() )
+        return;
+    if( !m_buffer.empty() )
+        fwrite( m_buffer.data(), 1, m_buffer.size(), m_file );
+    m_buffer.clear();
+    fflush( m_file );
+}
+
+void BinaryLogWriter::Close()
+{
+    if( !IsOpen() )
+        return;
+    Flush();
+    fclose( m_file );
+    m_file = nullptr;
+}
+
+void BinaryLogWriter::WriteTagOnce( uint tagId )
+{
+    if( tagId < m_writtenTags.size() && m_writtenTags[tagId] )
+        return;
+    if( tagId >= m_writtenTags.size() )
+        m_writtenTags.resize( tagId + 1, false );
+    m_writtenTags[tagId] = true;
+
+    WriteValue( LogFormat::RecordType::TAG );
+    WriteValue( tagId );
+    WriteString( Logger::GetTagName( tagId ) );
+}
+
+void BinaryLogWriter::WriteFormatOnce( uint formatId )
+{
+    if( formatId < m_writtenFormats.size() && m_writtenFormats[formatId] )
+        return;
+    if( formatId >= m_writtenFormats.size() )
+        m_writtenFormats.resize( formatId + 1, false );
+    m_writtenFormats[formatId] = true;
+
+    WriteValue( LogFormat::RecordType::FORMAT );
+    WriteValue( formatId );
+    WriteString( Logger::GetFormat( formatId ) );
+}
+
+void BinaryLogWriter::WriteString( const char* str )
+{
+    uint length = (uint) strlen( str );
+    WriteValue( length );
+    WriteBytes( str, length );
+}
+
+void BinaryLogWriter::WriteBytes( const void* data, size_t size )
+{
+    const Byte* bytes = (const Byte*) data;
+    m_buffer.insert( m_buffer.end(), bytes, bytes + size );
+}
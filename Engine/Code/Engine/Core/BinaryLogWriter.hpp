@@ -0,0 +1,39 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/LogEntry.hpp"
+#include <stdio.h>
+
+// Log hook target that writes entries in the LogFormat binary layout,
+// tags and format strings are written once and entries keep their packed arguments
+// Decode the result with the LogDecoder tool
+class BinaryLogWriter
+{
+public:
+    // Entries are collected and written in one call once this much is buffered
+    static constexpr int WRITE_BUFFER_SIZE = 64 * 1024;
+
+    BinaryLogWriter() {};
+    ~BinaryLogWriter();
+
+    bool Open( const String& filePath );
+    void WriteEntry( const LogEntry* entry );
+    void Flush();
+    void Close();
+
+    bool IsOpen() { return m_file != nullptr; };
+
+private:
+    void WriteTagOnce( uint tagId );
+    void WriteFormatOnce( uint formatId );
+    void WriteString( const char* str );
+    void WriteBytes( const void* data, size_t size );
+
+    template <typename T>
+    void WriteValue( const T& value ) { WriteBytes( &value, sizeof( T ) ); };
+
+private:
+    FILE* m_file = nullptr;
+    std::vector<Byte> m_buffer;
+    std::vector<bool> m_writtenTags;
+    std::vector<bool> m_writtenFormats;
+};
@@ -5,6 +5,7 @@
 #include "Engine/IO/IOUtils.hpp"
 #include "Engine/Math/Random.hpp"
 #include "Engine/Core/Profiler.hpp"
+#include "Engine/Core/ProfilerStats.hpp"
 #include "Engine/Core/PythonInterpreter.hpp"
 #include "Engine/Core/Console.hpp"
 #include "Engine/Net/Net.hpp"
@@ -105,6 +106,58 @@ void EngineCommands::RegisterAllCommands()
         Profiler::Resume();
     } );
 
+    commandSys->AddCommand( "profilerCapture", []( String str )
+    {
+        // profilerCapture [frameCount] [filePath]
+        CommandParameterParser parser( str );
+        int frameCount = 60;
+        String filePath = IOUtils::GetCurrentDir() + "/Logs/profile.json";
+        if( parser.NumOfParams() > 0 )
+            parser.GetNext( frameCount );
+        if( parser.NumOfParams() > 1 )
+            parser.GetNext( filePath );
+
+        if( Profiler::CaptureTrace( filePath, frameCount ) )
+            Console::DefaultConsole()->Printf( "Capturing %i frames to %s", frameCount, filePath.c_str() );
+        else
+            LOG_WARNING( "Could not start profiler capture to " + filePath );
+    } );
+
+    commandSys->AddCommand( "profilerExport", []( String str )
+    {
+        // profilerExport [frameCount] [filePath], writes frames already in the history
+        CommandParameterParser parser( str );
+        int frameCount = Profiler::MAX_HISTORY_LEN;
+        String filePath = IOUtils::GetCurrentDir() + "/Logs/profile.json";
+        if( parser.NumOfParams() > 0 )
+            parser.GetNext( frameCount );
+        if( parser.NumOfParams() > 1 )
+            parser.GetNext( filePath );
+
+        if( Profiler::ExportTrace( filePath, frameCount ) )
+            Console::DefaultConsole()->Printf( "Exported profiler history to %s", filePath.c_str() );
+        else
+            LOG_WARNING( "Could not export profiler history to " + filePath );
+    } );
+
+    commandSys->AddCommand( "profilerStats", []( String str )
+    {
+        // profilerStats [windowFrames], prints per scope percentiles over the window
+        CommandParameterParser parser( str );
+        int windowFrames = Profiler::MAX_HISTORY_LEN;
+        if( parser.NumOfParams() > 0 )
+            parser.GetNext( windowFrames );
+
+        ProfilerStats* stats = Profiler::GetStats();
+        if( nullptr == stats || stats->GetWindowFrames() != windowFrames )
+        {
+            Profiler::EnableStats( windowFrames );
+            Console::DefaultConsole()->Printf( "Collecting profiler stats over %i frames", windowFrames );
+            return;
+        }
+        Console::DefaultConsole()->Print( stats->ToString() );
+    } );
+
     commandSys->AddCommand( "python", []( String str )
     {
         UNUSED( str );
@@ -0,0 +1,43 @@
+#pragma once
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Math/Mat4.hpp"
+
+class Renderable;
+class GameObject;
+
+// Components the engine's entity systems know about, kept small so the
+// pools stay dense, anything a system doesn't touch every frame goes elsewhere
+
+// Local to world, there is no hierarchy between entities
+struct TransformComponent
+{
+    Vec3 m_position = Vec3::ZEROS;
+    Vec3 m_euler = Vec3::ZEROS;     // roll first, then pitch, then yaw
+    Vec3 m_scale = Vec3::ONES;
+};
+
+// Written by EntitySystems::UpdateWorldMatrices from TransformComponent
+struct WorldMatrixComponent
+{
+    Mat4 m_localToWorld;
+};
+
+struct PhysicsComponent
+{
+    Vec3 m_velocity = Vec3::ZEROS;
+    float m_drag = 0.f;
+    float m_mass = 1.f;
+};
+
+// Not owned, the entity's world matrix is copied into it every frame
+struct RenderableComponent
+{
+    Renderable* m_renderable = nullptr;
+    bool m_visible = true;
+};
+
+// Set on entities that are driven by a GameObject, see GameObject::GetEntity
+struct GameObjectComponent
+{
+    GameObject* m_gameObject = nullptr;
+};
@@ -0,0 +1,65 @@
+#include "Engine/Core/EntityRegistry.hpp"
+
+#include <atomic>
+
+EntityRegistry* EntityRegistry::s_default = nullptr;
+
+EntityRegistry* EntityRegistry::GetDefault()
+{
+    if( !s_default )
+        s_default = new EntityRegistry();
+
+    return s_default;
+}
+
+EntityRegistry::~EntityRegistry()
+{
+    for( ComponentPoolBase* pool : m_pools )
+    {
+        delete pool;
+    }
+    m_pools.clear();
+}
+
+Entity EntityRegistry::CreateEntity()
+{
+    Entity entity;
+    if( !m_freeIdxs.empty() )
+    {
+        entity.m_idx = m_freeIdxs.back();
+        m_freeIdxs.pop_back();
+    }
+    else
+    {
+        entity.m_idx = (uint) m_generations.size();
+        m_generations.push_back( 0 );
+    }
+    entity.m_generation = m_generations[entity.m_idx];
+    return entity;
+}
+
+void EntityRegistry::DestroyEntity( Entity entity )
+{
+    if( !IsAlive( entity ) )
+        return;
+
+    for( ComponentPoolBase* pool : m_pools )
+    {
+        if( pool )
+            pool->Remove( entity.m_idx );
+    }
+    ++m_generations[entity.m_idx];
+    m_freeIdxs.push_back( entity.m_idx );
+}
+
+bool EntityRegistry::IsAlive( Entity entity ) const
+{
+    return entity.m_idx < m_generations.size()
+        && m_generations[entity.m_idx] == entity.m_generation;
+}
+
+uint EntityRegistry::NextComponentTypeId()
+{
+    static std::atomic<uint> s_nextTypeId = 0;
+    return s_nextTypeId++;
+}
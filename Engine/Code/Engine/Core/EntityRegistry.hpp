@@ -0,0 +1,209 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include <type_traits>
+#include "Engine/Core/Types.hpp"
+
+// Data oriented storage for entities that don't need a GameObject
+// An entity is only an id, each component type lives in its own sparse set
+// with the components packed in one array, so systems iterate contiguous memory
+//
+// Not thread safe for adds and removes, systems can split a pool's dense
+// array across jobs as long as they only write the components they own
+
+struct Entity
+{
+    static constexpr uint INVALID_IDX = 0xffffffff;
+
+    bool IsValid() const { return m_idx != INVALID_IDX; };
+    bool operator==( const Entity& other ) const
+    {
+        return m_idx == other.m_idx && m_generation == other.m_generation;
+    };
+    bool operator!=( const Entity& other ) const { return !( *this == other ); };
+
+    uint m_idx = INVALID_IDX;
+    uint m_generation = 0;
+};
+
+//--------------------------------------------------------------------------------------
+class ComponentPoolBase
+{
+public:
+    static constexpr uint INVALID_DENSE_IDX = 0xffffffff;
+
+    virtual ~ComponentPoolBase() {};
+    virtual void Remove( uint entityIdx ) = 0;
+
+    bool Has( uint entityIdx ) const
+    {
+        return entityIdx < m_sparse.size() && m_sparse[entityIdx] != INVALID_DENSE_IDX;
+    };
+    uint GetSize() const { return (uint) m_entityIdxs.size(); };
+    // entity that owns the component at denseIdx
+    uint GetEntityIdx( uint denseIdx ) const { return m_entityIdxs[denseIdx]; };
+
+protected:
+    // entity index to dense index
+    std::vector<uint> m_sparse;
+    // dense index to entity index
+    std::vector<uint> m_entityIdxs;
+};
+
+// Components are packed in m_components, removing one moves the last into its place
+template <typename T>
+class ComponentPool : public ComponentPoolBase
+{
+public:
+    T& Add( uint entityIdx, const T& component )
+    {
+        if( Has( entityIdx ) )
+        {
+            T& existing = m_components[m_sparse[entityIdx]];
+            existing = component;
+            return existing;
+        }
+
+        if( entityIdx >= m_sparse.size() )
+            m_sparse.resize( entityIdx + 1, INVALID_DENSE_IDX );
+        m_sparse[entityIdx] = (uint) m_components.size();
+        m_entityIdxs.push_back( entityIdx );
+        m_components.push_back( component );
+        return m_components.back();
+    }
+
+    virtual void Remove( uint entityIdx ) override
+    {
+        if( !Has( entityIdx ) )
+            return;
+
+        uint denseIdx = m_sparse[entityIdx];
+        uint lastEntityIdx = m_entityIdxs.back();
+        m_components[denseIdx] = std::move( m_components.back() );
+        m_entityIdxs[denseIdx] = lastEntityIdx;
+        m_sparse[lastEntityIdx] = denseIdx;
+        m_components.pop_back();
+        m_entityIdxs.pop_back();
+        m_sparse[entityIdx] = INVALID_DENSE_IDX;
+    }
+
+    // nullptr if the entity doesn't have one
+    T* Find( uint entityIdx )
+    {
+        return Has( entityIdx ) ? &m_components[m_sparse[entityIdx]] : nullptr;
+    }
+    T& Get( uint entityIdx ) { return m_components[m_sparse[entityIdx]]; };
+
+    T* GetData() { return m_components.data(); };
+    T& GetAt( uint denseIdx ) { return m_components[denseIdx]; };
+
+private:
+    std::vector<T> m_components;
+};
+
+//--------------------------------------------------------------------------------------
+class EntityRegistry
+{
+public:
+    static EntityRegistry* GetDefault();
+    static void SetDefault( EntityRegistry* registry ) { s_default = registry; };
+
+    EntityRegistry() {};
+    ~EntityRegistry();
+    EntityRegistry( const EntityRegistry& ) = delete;
+    void operator=( const EntityRegistry& ) = delete;
+
+    Entity CreateEntity();
+    // Removes every component, the entity's index is reused with a new generation
+    void DestroyEntity( Entity entity );
+    bool IsAlive( Entity entity ) const;
+    uint GetAliveCount() const { return (uint) ( m_generations.size() - m_freeIdxs.size() ); };
+
+    template <typename T>
+    T& AddComponent( Entity entity, const T& component = T() )
+    {
+        return GetPool<T>().Add( entity.m_idx, component );
+    }
+
+    template <typename T>
+    void RemoveComponent( Entity entity )
+    {
+        GetPool<T>().Remove( entity.m_idx );
+    }
+
+    // nullptr if the entity doesn't have one or is dead
+    template <typename T>
+    T* FindComponent( Entity entity )
+    {
+        if( !IsAlive( entity ) )
+            return nullptr;
+        return GetPool<T>().Find( entity.m_idx );
+    }
+
+    template <typename T>
+    bool HasComponent( Entity entity )
+    {
+        return IsAlive( entity ) && GetPool<T>().Has( entity.m_idx );
+    }
+
+    template <typename T>
+    ComponentPool<T>& GetPool()
+    {
+        uint typeId = GetComponentTypeId<T>();
+        if( typeId >= m_pools.size() )
+            m_pools.resize( typeId + 1, nullptr );
+        if( nullptr == m_pools[typeId] )
+            m_pools[typeId] = new ComponentPool<T>();
+        return *static_cast<ComponentPool<T>*>( m_pools[typeId] );
+    }
+
+    // Calls function( Entity, T&, Others&... ) for every entity that has all of the components
+    // Walks T's pool in order, so put the rarest component first
+    template <typename T, typename... Others, typename Function>
+    void ForEach( Function function )
+    {
+        ComponentPool<T>& pool = GetPool<T>();
+        for( uint denseIdx = 0; denseIdx < pool.GetSize(); ++denseIdx )
+        {
+            uint entityIdx = pool.GetEntityIdx( denseIdx );
+            if( !HasAll<Others...>( entityIdx ) )
+                continue;
+            Entity entity;
+            entity.m_idx = entityIdx;
+            entity.m_generation = m_generations[entityIdx];
+            function( entity, pool.GetAt( denseIdx ), GetPool<Others>().Get( entityIdx )... );
+        }
+    }
+
+    // Same id in every registry
+    template <typename T>
+    static uint GetComponentTypeId()
+    {
+        static const uint s_typeId = NextComponentTypeId();
+        return s_typeId;
+    }
+
+private:
+    static uint NextComponentTypeId();
+
+    template <typename... Others>
+    typename std::enable_if<sizeof...( Others ) == 0, bool>::type HasAll( uint )
+    {
+        return true;
+    }
+
+    template <typename First, typename... Others>
+    bool HasAll( uint entityIdx )
+    {
+        return GetPool<First>().Has( entityIdx ) && HasAll<Others...>( entityIdx );
+    }
+
+    static EntityRegistry* s_default;
+
+    // indexed by entity index, bumped when the entity is destroyed
+    std::vector<uint> m_generations;
+    std::vector<uint> m_freeIdxs;
+
+    // indexed by component type id, created on first use
+    std::vector<ComponentPoolBase*> m_pools;
+};
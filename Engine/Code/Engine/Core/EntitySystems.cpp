@@ -0,0 +1,79 @@
+#include "Engine/Core/EntitySystems.hpp"
+#include "Engine/Core/EntityRegistry.hpp"
+#include "Engine/Core/EntityComponents.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/Profiler.hpp"
+#include "Engine/Renderer/Renderable.hpp"
+
+namespace EntitySystems
+{
+
+// Fewest components handed to one job, each one is only a few dozen instructions
+constexpr int PARALLEL_GRAIN = 256;
+
+void IntegratePhysics( EntityRegistry* registry, float deltaSeconds )
+{
+    PROFILER_SCOPED();
+
+    // pools are looked up before going wide, GetPool can create them
+    ComponentPool<PhysicsComponent>& physicsPool = registry->GetPool<PhysicsComponent>();
+    ComponentPool<TransformComponent>& transformPool = registry->GetPool<TransformComponent>();
+
+    JobSystem::ParallelFor( (int) physicsPool.GetSize(), [&]( int startIdx, int endIdx ) {
+        for( int denseIdx = startIdx; denseIdx < endIdx; ++denseIdx )
+        {
+            uint entityIdx = physicsPool.GetEntityIdx( denseIdx );
+            TransformComponent* transform = transformPool.Find( entityIdx );
+            if( nullptr == transform )
+                continue;
+
+            PhysicsComponent& physics = physicsPool.GetAt( denseIdx );
+            transform->m_position = transform->m_position + physics.m_velocity * deltaSeconds;
+            physics.m_velocity = physics.m_velocity - physics.m_velocity * physics.m_drag * deltaSeconds;
+        }
+    }, PARALLEL_GRAIN );
+}
+
+void UpdateWorldMatrices( EntityRegistry* registry )
+{
+    PROFILER_SCOPED();
+
+    ComponentPool<TransformComponent>& transformPool = registry->GetPool<TransformComponent>();
+    ComponentPool<WorldMatrixComponent>& matrixPool = registry->GetPool<WorldMatrixComponent>();
+
+    JobSystem::ParallelFor( (int) transformPool.GetSize(), [&]( int startIdx, int endIdx ) {
+        for( int denseIdx = startIdx; denseIdx < endIdx; ++denseIdx )
+        {
+            WorldMatrixComponent* matrix = matrixPool.Find( transformPool.GetEntityIdx( denseIdx ) );
+            if( nullptr == matrix )
+                continue;
+
+            const TransformComponent& transform = transformPool.GetAt( denseIdx );
+            matrix->m_localToWorld = Mat4::MakeFromSRT( transform.m_scale, transform.m_euler,
+                                                        transform.m_position );
+        }
+    }, PARALLEL_GRAIN );
+}
+
+void GatherRenderables( EntityRegistry* registry, std::vector<Renderable*>& out_renderables )
+{
+    PROFILER_SCOPED();
+
+    ComponentPool<RenderableComponent>& renderablePool = registry->GetPool<RenderableComponent>();
+    ComponentPool<WorldMatrixComponent>& matrixPool = registry->GetPool<WorldMatrixComponent>();
+
+    out_renderables.reserve( out_renderables.size() + renderablePool.GetSize() );
+    for( uint denseIdx = 0; denseIdx < renderablePool.GetSize(); ++denseIdx )
+    {
+        RenderableComponent& renderable = renderablePool.GetAt( denseIdx );
+        if( !renderable.m_visible || nullptr == renderable.m_renderable )
+            continue;
+
+        WorldMatrixComponent* matrix = matrixPool.Find( renderablePool.GetEntityIdx( denseIdx ) );
+        if( matrix )
+            renderable.m_renderable->SetModelMatrix( matrix->m_localToWorld );
+        out_renderables.push_back( renderable.m_renderable );
+    }
+}
+
+}
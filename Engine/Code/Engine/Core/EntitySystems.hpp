@@ -0,0 +1,19 @@
+#pragma once
+#include <vector>
+
+class EntityRegistry;
+class Renderable;
+
+// Per frame passes over the components in EntityComponents.hpp
+// Each pass walks one pool's dense array, split across the JobSystem
+namespace EntitySystems
+{
+// Moves every entity with a PhysicsComponent and a TransformComponent
+void IntegratePhysics( EntityRegistry* registry, float deltaSeconds );
+
+// Rebuilds WorldMatrixComponent from TransformComponent
+void UpdateWorldMatrices( EntityRegistry* registry );
+
+// Copies world matrices into visible renderables and appends them to out_renderables
+void GatherRenderables( EntityRegistry* registry, std::vector<Renderable*>& out_renderables );
+}
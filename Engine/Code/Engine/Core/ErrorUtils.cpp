@@ -302,6 +302,11 @@ __declspec( noreturn ) void FatalError(
                     lineNum, fileName, functionName );
 	DebuggerPrintf( "%s(%d): %s\n", filePath, lineNum, errorMessage.c_str() );
 
+	// get the log tail to disk before the dialog, the app may be killed while it is up
+	Logger::GetDefault()->LogTaggedPrintf( "FATAL ERROR", "%s(%d): %s", fileName, lineNum,
+                                           errorMessage.c_str() );
+	Logger::GetDefault()->FlushForCrash();
+
 	if( isDebuggerPresent )
 	{
 		bool isAnswerYes = SystemDialogue_YesNo(
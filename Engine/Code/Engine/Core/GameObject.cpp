@@ -7,6 +7,7 @@
 #include "Engine/Renderer/RenderSceneGraph.hpp"
 #include "Engine/Core/ContainerUtils.hpp"
 #include "Engine/Core/GameObjectManager.hpp"
+#include "Engine/Core/EntityComponents.hpp"
 #include "Engine/Renderer/MeshPrimitive.hpp"
 #include "Engine/Renderer/MeshBuilder.hpp"
 #include "Engine/Renderer/ShaderPass.hpp"
@@ -40,6 +41,8 @@ GameObject::GameObject( const String& type )
 GameObject::~GameObject()
 {
     SetGameObjectManager( nullptr );
+    if( m_entity.IsValid() )
+        EntityRegistry::GetDefault()->DestroyEntity( m_entity );
 
     if( m_renderable )
     {
@@ -70,6 +73,17 @@ void GameObject::SetGameObjectManager( GameObjectManager* manager )
         m_manager->AddGameObject( this );
 }
 
+Entity GameObject::GetEntity()
+{
+    EntityRegistry* registry = EntityRegistry::GetDefault();
+    if( !registry->IsAlive( m_entity ) )
+    {
+        m_entity = registry->CreateEntity();
+        registry->AddComponent( m_entity, GameObjectComponent{ this } );
+    }
+    return m_entity;
+}
+
 Transform& GameObject::GetTransform()
 {
     m_modelMatDirty = true;
@@ -121,6 +135,17 @@ void GameObject::RegenModelMatIfDirty() const
 void GameObject::SetShouldDie( bool shouldDie )
 {
     m_shouldDie = shouldDie;
+
+    // callbacks can reach anything, so they wait for the parallel phase to end
+    if( m_manager && m_manager->IsInParallelPhase() )
+    {
+        m_manager->DeferUntilSerial( [this]() {
+            CallDeathCallbacks();
+            OnDeath();
+        } );
+        return;
+    }
+
     CallDeathCallbacks();
     OnDeath();
 }
@@ -143,9 +168,15 @@ void GameObject::ClearDeathCallbacks()
     m_deathCallbacks.clear();
 }
 
-void GameObject::SetType( std::string type )
+void GameObject::SetType( const String& type )
 {
-    m_type = type;
+    GameObjectTypeId typeId = GameObjectManager::RegisterType( type );
+    if( typeId == m_typeId )
+        return;
+
+    if( m_manager && m_handle.IsValid() )
+        m_manager->ChangeType( this, typeId );
+    m_typeId = typeId;
 }
 
 OBB3 GameObject::GetOBB3() const
@@ -6,6 +6,8 @@
 #include "Engine/Renderer/Renderable.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Math/Vec3.hpp"
+#include "Engine/Core/GameObjectManager.hpp"
+#include "Engine/Core/EntityRegistry.hpp"
 
 class Camera;
 class RenderSceneGraph;
@@ -16,8 +18,15 @@ class OBB3;
 
 typedef std::function<void( GameObject* )> GameObjectCB;
 
+enum class UpdatePhase
+{
+    PARALLEL,   // Update only touches the object itself, runs on job workers
+    SERIAL      // everything else, runs on the updating thread
+};
+
 class GameObject
 {
+    friend class GameObjectManager;
 public:
     // pivot is in local space (-1,-1,-1) to (1,1,1) for cube min and max corners
     static GameObject* MakeCube( const Vec3& sideLengths = Vec3::ONES,
@@ -29,8 +38,19 @@ public:
 
     virtual void Update();
     virtual void OnFirstUpdate() {};
+    // Can change from frame to frame, the first update is always serial
+    virtual UpdatePhase GetUpdatePhase() const { return UpdatePhase::SERIAL; };
+    bool IsFirstUpdateDone() const { return m_firstUpdateCalled; };
 
     void SetGameObjectManager( GameObjectManager* manager );
+    // Only valid within the current manager
+    GameObjectHandle GetHandle() const { return m_handle; };
+
+    // Entity in EntityRegistry::GetDefault() that points back at this object,
+    // created on first call and destroyed with the object
+    // Only a back-link, the Transform and Renderable stay on the GameObject and
+    // aren't mirrored into TransformComponent or RenderableComponent
+    Entity GetEntity();
 
     Transform& GetTransform();
     const Transform& GetTransform() const;
@@ -60,8 +80,9 @@ public:
     void AddDeathCallback( GameObjectCB cb );
     void ClearDeathCallbacks();
 
-    void SetType( std::string type );
-    String GetType() { return m_type; };
+    void SetType( const String& type );
+    const String& GetType() const { return GameObjectManager::GetTypeName( m_typeId ); };
+    GameObjectTypeId GetTypeId() const { return m_typeId; };
 
     OBB3 GetOBB3() const;
     AABB3 GetLocalBounds() const;
@@ -72,7 +93,7 @@ public:
 
 
 protected:
-    std::string m_type = "Unknown";
+    GameObjectTypeId m_typeId = 0;
 
     Transform m_transform;
     mutable bool m_modelMatDirty = false;
@@ -81,9 +102,12 @@ protected:
     bool m_shouldDie = false;
     RenderSceneGraph* m_scene = nullptr;
     GameObjectManager* m_manager = nullptr;
+    GameObjectHandle m_handle;
+    Entity m_entity;
 
     std::vector < GameObjectCB > m_deathCallbacks;
 
     bool m_firstUpdateCalled = false;
     bool m_visible = true;
+    bool m_isInParallelPhase = false;   // this frame, set by the manager
 };
@@ -0,0 +1,453 @@
+#include "Engine/Core/GameObjectBVH.hpp"
+#include "Engine/Core/GameObject.hpp"
+#include "Engine/Core/Profiler.hpp"
+#include "Engine/Math/Raycast.hpp"
+#include "Engine/Math/Ray3.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+#include <algorithm>
+
+namespace
+{
+// Cost of visiting a node relative to testing an object, the OBB test is a few times the box test
+constexpr float NODE_COST = 0.5f;
+
+float GetHalfSurfaceArea( const AABB3& bounds )
+{
+    Vec3 size = bounds.maxs - bounds.mins;
+    return size.x * size.y + size.y * size.z + size.z * size.x;
+}
+
+void StretchToIncludeBounds( AABB3& bounds, const AABB3& other )
+{
+    bounds.mins = Min( bounds.mins, other.mins );
+    bounds.maxs = Max( bounds.maxs, other.maxs );
+}
+
+// Slab test, out_entry is negative when the ray starts inside
+bool GetRayEntry( const AABB3& bounds, const Vec3& start, const Vec3& invDir,
+                  float maxDistance, float& out_entry )
+{
+    float t1 = ( bounds.mins.x - start.x ) * invDir.x;
+    float t2 = ( bounds.maxs.x - start.x ) * invDir.x;
+    float t3 = ( bounds.mins.y - start.y ) * invDir.y;
+    float t4 = ( bounds.maxs.y - start.y ) * invDir.y;
+    float t5 = ( bounds.mins.z - start.z ) * invDir.z;
+    float t6 = ( bounds.maxs.z - start.z ) * invDir.z;
+
+    float tmin = Maxf( Maxf( Minf( t1, t2 ), Minf( t3, t4 ) ), Minf( t5, t6 ) );
+    float tmax = Minf( Minf( Maxf( t1, t2 ), Maxf( t3, t4 ) ), Maxf( t5, t6 ) );
+
+    out_entry = tmin;
+    return tmax >= 0.f && tmin <= tmax && tmin <= maxDistance;
+}
+}
+
+void GameObjectBVH::Build( GameObjectManager* manager, const GameObjects& objects )
+{
+    PROFILER_SCOPED();
+    Clear();
+    m_manager = manager;
+
+    m_objects.reserve( objects.size() );
+    for( GameObject* gameObject : objects )
+    {
+        if( !gameObject->GetRenderable() )
+            continue;
+
+        Object object;
+        object.m_handle = gameObject->GetHandle();
+        UpdateObjectBounds( object, *gameObject );
+        m_objects.push_back( object );
+    }
+
+    uint objectCount = (uint) m_objects.size();
+    if( objectCount == 0 )
+        return;
+
+    m_objectIdxs.resize( objectCount );
+    for( uint objectIdx = 0; objectIdx < objectCount; ++objectIdx )
+        m_objectIdxs[objectIdx] = objectIdx;
+
+    // at most 2n - 1 nodes, reserving keeps node references valid while splitting
+    m_nodes.reserve( 2 * objectCount - 1 );
+    m_nodes.emplace_back();
+    m_nodes[0].m_firstIdx = 0;
+    m_nodes[0].m_objectCount = objectCount;
+
+    // node and depth, children are split after their parent so the node order holds
+    std::vector<std::pair<uint, uint>> toSplit;
+    toSplit.emplace_back( 0, 0 );
+    while( !toSplit.empty() )
+    {
+        uint nodeIdx = toSplit.back().first;
+        uint depth = toSplit.back().second;
+        toSplit.pop_back();
+
+        RefitNode( m_nodes[nodeIdx] );
+        if( depth + 1 >= MAX_DEPTH || !SplitNode( nodeIdx ) )
+            continue;
+
+        uint childIdx = m_nodes[nodeIdx].m_firstIdx;
+        toSplit.emplace_back( childIdx + 1, depth + 1 );
+        toSplit.emplace_back( childIdx, depth + 1 );
+    }
+}
+
+void GameObjectBVH::Refit()
+{
+    PROFILER_SCOPED();
+    bool anyChanged = false;
+    for( uint objectIdx = 0; objectIdx < (uint) m_objects.size(); ++objectIdx )
+    {
+        Object& object = m_objects[objectIdx];
+        const GameObject* gameObject = GetLiveObject( objectIdx );
+        if( !gameObject || !gameObject->GetRenderable() )
+        {
+            // gone for good or until it has a mesh again, nothing can reach it
+            if( object.m_bounds.IsValid() )
+            {
+                object.m_bounds = AABB3();
+                anyChanged = true;
+            }
+            continue;
+        }
+
+        if( !object.m_bounds.IsValid() ||
+            gameObject->GetTransform().GetLocalToWorld() != object.m_localToWorld )
+        {
+            UpdateObjectBounds( object, *gameObject );
+            anyChanged = true;
+        }
+    }
+
+    if( !anyChanged )
+        return;
+
+    // children come after their parent, so going backwards refits bottom up
+    for( uint nodeIdx = (uint) m_nodes.size(); nodeIdx-- > 0; )
+        RefitNode( m_nodes[nodeIdx] );
+}
+
+void GameObjectBVH::Clear()
+{
+    m_manager = nullptr;
+    m_nodes.clear();
+    m_objects.clear();
+    m_objectIdxs.clear();
+}
+
+AABB3 GameObjectBVH::GetBounds() const
+{
+    if( m_nodes.empty() )
+        return AABB3();
+    return m_nodes[0].m_bounds;
+}
+
+RaycastHit3 GameObjectBVH::RaycastClosest( const Ray3& ray, float maxDistance /*= INFINITY */ ) const
+{
+    RaycastHit3 closestHit = RaycastHit3::NO_HIT;
+    TraverseRay( ray, maxDistance, [&]( uint objectIdx, float& out_maxDistance )
+    {
+        // left out since the last Refit, or deleted since
+        if( !m_objects[objectIdx].m_bounds.IsValid() )
+            return false;
+        RaycastHit3 hit = Raycast::ToOBB3( ray, m_objects[objectIdx].m_obb );
+        if( !hit.m_hit || hit.m_distance > out_maxDistance || hit.m_distance >= closestHit.m_distance )
+            return false;
+
+        GameObject* gameObject = GetLiveObject( objectIdx );
+        if( gameObject )
+        {
+            closestHit = hit;
+            closestHit.m_gameObject = gameObject;
+            out_maxDistance = hit.m_distance;
+        }
+        return false;
+    } );
+    return closestHit;
+}
+
+bool GameObjectBVH::RaycastAny( const Ray3& ray, float maxDistance /*= INFINITY */ ) const
+{
+    bool anyHit = false;
+    TraverseRay( ray, maxDistance, [&]( uint objectIdx, float& out_maxDistance )
+    {
+        if( !m_objects[objectIdx].m_bounds.IsValid() )
+            return false;
+        RaycastHit3 hit = Raycast::ToOBB3( ray, m_objects[objectIdx].m_obb );
+        anyHit = hit.m_hit && hit.m_distance <= out_maxDistance && GetLiveObject( objectIdx );
+        return anyHit;
+    } );
+    return anyHit;
+}
+
+void GameObjectBVH::QueryAABB3( const AABB3& bounds, GameObjects& out_objects ) const
+{
+    TraverseOverlap(
+        [&]( const AABB3& nodeBounds ) { return AABB3::IsOverlap( bounds, nodeBounds ); },
+        [&]( const Object& object ) { return AABB3::IsOverlap( bounds, object.m_bounds ); },
+        out_objects );
+}
+
+void GameObjectBVH::QuerySphere( const Vec3& center, float radius, GameObjects& out_objects ) const
+{
+    TraverseOverlap(
+        [&]( const AABB3& nodeBounds )
+        {
+            return AABB3::IsOverlapSphere( nodeBounds, center, radius );
+        },
+        [&]( const Object& object )
+        {
+            // the OBB has no scale, so distances are the same in its local space
+            Vec3 localCenter = object.m_obb.GetWorldToLocal().TransformPosition( center );
+            return AABB3::IsOverlapSphere( object.m_obb.GetAABB3(), localCenter, radius );
+        },
+        out_objects );
+}
+
+void GameObjectBVH::UpdateObjectBounds( Object& object, const GameObject& gameObject )
+{
+    object.m_localToWorld = gameObject.GetTransform().GetLocalToWorld();
+    object.m_obb = gameObject.GetOBB3();
+    const OBB3& obb = object.m_obb;
+
+    object.m_bounds = AABB3::FromTransformedBounds( obb.GetAABB3(), obb.GetLocalToWorld() );
+    object.m_center = object.m_bounds.GetCenter();
+
+    // the inverse is cached lazily, fill it here so queries never write to it
+    obb.GetWorldToLocal();
+}
+
+bool GameObjectBVH::SplitNode( uint nodeIdx )
+{
+    Node& node = m_nodes[nodeIdx];
+    uint firstIdx = node.m_firstIdx;
+    uint objectCount = node.m_objectCount;
+    if( objectCount <= 1 )
+        return false;
+
+    AABB3 centerBounds;
+    for( uint idx = firstIdx; idx < firstIdx + objectCount; ++idx )
+        centerBounds.StretchToIncludePoint( m_objects[m_objectIdxs[idx]].m_center );
+
+    struct Bin
+    {
+        AABB3 m_bounds;
+        uint m_objectCount = 0;
+    };
+
+    // costs are relative to the node's area, which the leaf cost is scaled by
+    float bestCost = INFINITY;
+    int bestAxis = -1;
+    int bestSplit = 0;
+    for( int axis = 0; axis < 3; ++axis )
+    {
+        float axisMin = centerBounds.mins.el[axis];
+        float axisExtent = centerBounds.maxs.el[axis] - axisMin;
+        if( axisExtent <= 0.f )
+            continue;
+
+        Bin bins[SAH_BIN_COUNT];
+        float binScale = (float) SAH_BIN_COUNT / axisExtent;
+        for( uint idx = firstIdx; idx < firstIdx + objectCount; ++idx )
+        {
+            const Object& object = m_objects[m_objectIdxs[idx]];
+            int binIdx = (int) ( ( object.m_center.el[axis] - axisMin ) * binScale );
+            binIdx = binIdx < SAH_BIN_COUNT - 1 ? binIdx : SAH_BIN_COUNT - 1;
+            StretchToIncludeBounds( bins[binIdx].m_bounds, object.m_bounds );
+            ++bins[binIdx].m_objectCount;
+        }
+
+        // sweep from the right for the area and count of everything after each plane
+        float rightCosts[SAH_BIN_COUNT];
+        AABB3 rightBounds;
+        uint rightCount = 0;
+        for( int binIdx = SAH_BIN_COUNT - 1; binIdx > 0; --binIdx )
+        {
+            StretchToIncludeBounds( rightBounds, bins[binIdx].m_bounds );
+            rightCount += bins[binIdx].m_objectCount;
+            rightCosts[binIdx] = rightCount > 0 ? GetHalfSurfaceArea( rightBounds ) * rightCount : 0.f;
+        }
+
+        AABB3 leftBounds;
+        uint leftCount = 0;
+        for( int split = 1; split < SAH_BIN_COUNT; ++split )
+        {
+            StretchToIncludeBounds( leftBounds, bins[split - 1].m_bounds );
+            leftCount += bins[split - 1].m_objectCount;
+            if( leftCount == 0 || leftCount == objectCount )
+                continue;
+
+            float cost = GetHalfSurfaceArea( leftBounds ) * leftCount + rightCosts[split];
+            if( cost < bestCost )
+            {
+                bestCost = cost;
+                bestAxis = axis;
+                bestSplit = split;
+            }
+        }
+    }
+
+    uint leftCount = 0;
+    if( bestAxis >= 0 )
+    {
+        float nodeArea = GetHalfSurfaceArea( node.m_bounds );
+        float splitCost = NODE_COST * nodeArea + bestCost;
+        float leafCost = nodeArea * objectCount;
+        if( splitCost >= leafCost && objectCount <= MAX_LEAF_OBJECTS )
+            return false;
+
+        // same bin math as above so the objects land on the side they were costed on
+        float axisMin = centerBounds.mins.el[bestAxis];
+        float binScale = (float) SAH_BIN_COUNT / ( centerBounds.maxs.el[bestAxis] - axisMin );
+        uint* first = &m_objectIdxs[firstIdx];
+        uint* middle = std::partition( first, first + objectCount, [&]( uint objectIdx )
+        {
+            int binIdx = (int) ( ( m_objects[objectIdx].m_center.el[bestAxis] - axisMin ) * binScale );
+            return binIdx < bestSplit;
+        } );
+        leftCount = (uint) ( middle - first );
+    }
+    else
+    {
+        // every center is in the same spot, no plane separates them
+        if( objectCount <= MAX_LEAF_OBJECTS )
+            return false;
+        leftCount = objectCount / 2;
+    }
+
+    uint childIdx = (uint) m_nodes.size();
+    m_nodes.emplace_back();
+    m_nodes.emplace_back();
+    m_nodes[childIdx].m_firstIdx = firstIdx;
+    m_nodes[childIdx].m_objectCount = leftCount;
+    m_nodes[childIdx + 1].m_firstIdx = firstIdx + leftCount;
+    m_nodes[childIdx + 1].m_objectCount = objectCount - leftCount;
+
+    m_nodes[nodeIdx].m_firstIdx = childIdx;
+    m_nodes[nodeIdx].m_objectCount = 0;
+    return true;
+}
+
+void GameObjectBVH::RefitNode( Node& node )
+{
+    node.m_bounds = AABB3();
+    if( node.IsLeaf() )
+    {
+        for( uint idx = node.m_firstIdx; idx < node.m_firstIdx + node.m_objectCount; ++idx )
+            StretchToIncludeBounds( node.m_bounds, m_objects[m_objectIdxs[idx]].m_bounds );
+        return;
+    }
+
+    StretchToIncludeBounds( node.m_bounds, m_nodes[node.m_firstIdx].m_bounds );
+    StretchToIncludeBounds( node.m_bounds, m_nodes[node.m_firstIdx + 1].m_bounds );
+}
+
+GameObject* GameObjectBVH::GetLiveObject( uint objectIdx ) const
+{
+    if( !m_manager )
+        return nullptr;
+    return m_manager->GetGameObject( m_objects[objectIdx].m_handle );
+}
+
+template <typename HitObject>
+void GameObjectBVH::TraverseRay( const Ray3& ray, float maxDistance, HitObject hitObject ) const
+{
+    if( m_nodes.empty() )
+        return;
+
+    Vec3 invDir = Vec3( 1.f, 1.f, 1.f ) / ray.direction;
+    float entry;
+    if( !GetRayEntry( m_nodes[0].m_bounds, ray.start, invDir, maxDistance, entry ) )
+        return;
+
+    // at most one node is left behind per level
+    struct StackEntry
+    {
+        uint m_nodeIdx;
+        float m_entry;
+    };
+    StackEntry stack[MAX_DEPTH + 1];
+    int stackSize = 0;
+    stack[stackSize++] = { 0, entry };
+
+    while( stackSize > 0 )
+    {
+        StackEntry top = stack[--stackSize];
+        if( top.m_entry > maxDistance )
+            continue;
+
+        const Node& node = m_nodes[top.m_nodeIdx];
+        if( node.IsLeaf() )
+        {
+            for( uint idx = node.m_firstIdx; idx < node.m_firstIdx + node.m_objectCount; ++idx )
+            {
+                if( hitObject( m_objectIdxs[idx], maxDistance ) )
+                    return;
+            }
+            continue;
+        }
+
+        uint nearIdx = node.m_firstIdx;
+        uint farIdx = node.m_firstIdx + 1;
+        float nearEntry;
+        float farEntry;
+        bool hitNear = GetRayEntry( m_nodes[nearIdx].m_bounds, ray.start, invDir, maxDistance, nearEntry );
+        bool hitFar = GetRayEntry( m_nodes[farIdx].m_bounds, ray.start, invDir, maxDistance, farEntry );
+        if( hitNear && hitFar && farEntry < nearEntry )
+        {
+            std::swap( nearIdx, farIdx );
+            std::swap( nearEntry, farEntry );
+        }
+        else if( !hitNear )
+        {
+            nearIdx = farIdx;
+            nearEntry = farEntry;
+            hitNear = hitFar;
+            hitFar = false;
+        }
+
+        if( hitFar )
+            stack[stackSize++] = { farIdx, farEntry };
+        if( hitNear )
+            stack[stackSize++] = { nearIdx, nearEntry };
+    }
+}
+
+template <typename OverlapsNode, typename OverlapsObject>
+void GameObjectBVH::TraverseOverlap( OverlapsNode overlapsNode, OverlapsObject overlapsObject,
+                                     GameObjects& out_objects ) const
+{
+    if( m_nodes.empty() || !overlapsNode( m_nodes[0].m_bounds ) )
+        return;
+
+    uint stack[MAX_DEPTH + 1];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+
+    while( stackSize > 0 )
+    {
+        const Node& node = m_nodes[stack[--stackSize]];
+        if( !node.IsLeaf() )
+        {
+            for( uint childIdx = node.m_firstIdx; childIdx < node.m_firstIdx + 2; ++childIdx )
+            {
+                if( overlapsNode( m_nodes[childIdx].m_bounds ) )
+                    stack[stackSize++] = childIdx;
+            }
+            continue;
+        }
+
+        for( uint idx = node.m_firstIdx; idx < node.m_firstIdx + node.m_objectCount; ++idx )
+        {
+            uint objectIdx = m_objectIdxs[idx];
+            if( !overlapsObject( m_objects[objectIdx] ) )
+                continue;
+
+            GameObject* gameObject = GetLiveObject( objectIdx );
+            if( gameObject )
+                out_objects.push_back( gameObject );
+        }
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <vector>
+#include "Engine/Core/Types.hpp"
+#include "Engine/Core/GameObjectManager.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/OBB3.hpp"
+#include "Engine/Math/Mat4.hpp"
+#include "Engine/Math/RaycastHit3.hpp"
+
+class Ray3;
+
+// Bounding volume hierarchy over the GetOBB3 of a set of GameObjects, for ray and
+// overlap queries that only visit the objects near the query instead of all of them
+//
+// Build splits by the surface area heuristic, Refit keeps the tree shape and only
+// recomputes bounds, so it is cheap to call every frame but the tree gets looser as
+// objects move away from where they were at Build, rebuild once that starts to show
+//
+// Objects are held by handle, ones that were deleted or left the manager are skipped
+// Queries are const and safe to run from several threads at once, Build and Refit are not
+class GameObjectBVH
+{
+public:
+    static constexpr uint INVALID_NODE = 0xffffffff;
+
+    // Most objects in a leaf, smaller leaves split even if the split doesn't pay off
+    static constexpr uint MAX_LEAF_OBJECTS = 4;
+    // Candidate split planes per axis when building
+    static constexpr int SAH_BIN_COUNT = 12;
+    // Deeper nodes become leaves whatever their size, bounds the traversal stack
+    static constexpr uint MAX_DEPTH = 64;
+
+    GameObjectBVH() {};
+    ~GameObjectBVH() {};
+
+    // objects must all belong to manager, objects without a renderable have no bounds
+    // and are left out
+    void Build( GameObjectManager* manager, const GameObjects& objects );
+    // Recomputes the bounds of objects whose world transform changed since the last
+    // Build or Refit, then the nodes above them
+    void Refit();
+    void Clear();
+
+    uint GetObjectCount() const { return (uint) m_objects.size(); };
+    uint GetNodeCount() const { return (uint) m_nodes.size(); };
+    AABB3 GetBounds() const;
+
+    // Same hit Raycast::ToOBB3 gives for the closest object, with m_gameObject set
+    // Hits farther than maxDistance along the ray are ignored
+    RaycastHit3 RaycastClosest( const Ray3& ray, float maxDistance = INFINITY ) const;
+    // Stops at the first hit found, which is not necessarily the closest
+    bool RaycastAny( const Ray3& ray, float maxDistance = INFINITY ) const;
+
+    // Append to out_objects, bounds are tested against each object's world AABB
+    // and the sphere against its OBB3
+    void QueryAABB3( const AABB3& bounds, GameObjects& out_objects ) const;
+    void QuerySphere( const Vec3& center, float radius, GameObjects& out_objects ) const;
+
+private:
+    // Interior nodes have m_objectCount 0 and their children at m_firstIdx and m_firstIdx + 1
+    // Leaves own m_objectCount entries of m_objectIdxs starting at m_firstIdx
+    // Children always come after their parent
+    struct Node
+    {
+        AABB3 m_bounds;
+        uint m_firstIdx = 0;
+        uint m_objectCount = 0;
+
+        bool IsLeaf() const { return m_objectCount > 0; };
+    };
+
+    // Everything about one object, cached so queries don't go through the GameObject
+    struct Object
+    {
+        GameObjectHandle m_handle;
+        Mat4 m_localToWorld;    // of the transform, to spot moved objects
+        OBB3 m_obb;
+        AABB3 m_bounds;         // world AABB of m_obb
+        Vec3 m_center;
+    };
+
+    void UpdateObjectBounds( Object& object, const GameObject& gameObject );
+    // Splits the node's objects into two new children, false if it should stay a leaf
+    bool SplitNode( uint nodeIdx );
+    void RefitNode( Node& node );
+    GameObject* GetLiveObject( uint objectIdx ) const;
+
+    // Visits the objects in every leaf the ray reaches within maxDistance, near child first
+    // hitObject( objectIdx, maxDistance ) can shorten maxDistance, returns true to stop
+    template <typename HitObject>
+    void TraverseRay( const Ray3& ray, float maxDistance, HitObject hitObject ) const;
+    // overlapsNode takes node bounds, overlapsObject an Object, both return true to keep it
+    template <typename OverlapsNode, typename OverlapsObject>
+    void TraverseOverlap( OverlapsNode overlapsNode, OverlapsObject overlapsObject,
+                          GameObjects& out_objects ) const;
+
+    GameObjectManager* m_manager = nullptr;
+    std::vector<Node> m_nodes;
+    std::vector<Object> m_objects;
+    std::vector<uint> m_objectIdxs;     // leaf order
+};
@@ -1,9 +1,99 @@
 #include "Engine/Core/GameObjectManager.hpp"
 #include "Engine/Core/GameObject.hpp"
 #include "Engine/Core/ContainerUtils.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/Profiler.hpp"
+#include "Engine/Core/ErrorUtils.hpp"
+
+#include <algorithm>
+#include <unordered_map>
 
 GameObjectManager* GameObjectManager::s_default = nullptr;
 
+//--------------------------------------------------------------------------------------
+// Type registry
+// Names are never freed, so GetTypeName can read them without the lock
+
+namespace
+{
+std::mutex g_typeLock;
+std::unordered_multimap<uint, GameObjectTypeId> g_typeIdsByHash;
+const String* g_typeNames[GameObjectManager::MAX_GAMEOBJECT_TYPES] = {};
+std::atomic<uint> g_typeCount = 0;
+
+uint HashTypeName( const String& typeName )
+{
+    uint hash = 2166136261u;
+    for( char c : typeName )
+    {
+        hash ^= (uchar) c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+GameObjectTypeId FindOrAddType( const String& typeName )
+{
+    uint hash = HashTypeName( typeName );
+    std::lock_guard<std::mutex> lock( g_typeLock );
+
+    if( g_typeCount == 0 )
+    {
+        // id 0 is what a GameObject starts as
+        g_typeNames[0] = new String( "Unknown" );
+        g_typeIdsByHash.emplace( HashTypeName( *g_typeNames[0] ), 0 );
+        g_typeCount = 1;
+    }
+
+    auto range = g_typeIdsByHash.equal_range( hash );
+    for( auto it = range.first; it != range.second; ++it )
+    {
+        if( *g_typeNames[it->second] == typeName )
+            return it->second;
+    }
+
+    uint typeCount = g_typeCount.load();
+    if( typeCount >= GameObjectManager::MAX_GAMEOBJECT_TYPES - 1 )
+    {
+        if( typeCount == GameObjectManager::MAX_GAMEOBJECT_TYPES - 1 )
+        {
+            ERROR_RECOVERABLE( "Too many GameObject types, " + typeName + " and later types share one id" );
+            g_typeNames[typeCount] = new String( "TypeOverflow" );
+            g_typeCount = typeCount + 1;
+        }
+        return GameObjectManager::MAX_GAMEOBJECT_TYPES - 1;
+    }
+
+    g_typeNames[typeCount] = new String( typeName );
+    g_typeIdsByHash.emplace( hash, typeCount );
+    g_typeCount = typeCount + 1;
+    return typeCount;
+}
+}
+
+GameObjectTypeId GameObjectManager::RegisterType( const String& typeName )
+{
+    return FindOrAddType( typeName );
+}
+
+const String& GameObjectManager::GetTypeName( GameObjectTypeId typeId )
+{
+    static const String s_invalidName = "Invalid";
+    // the default id is valid before anything registered
+    if( g_typeCount.load() == 0 )
+        FindOrAddType( "Unknown" );
+
+    if( typeId >= g_typeCount.load() )
+        return s_invalidName;
+    return *g_typeNames[typeId];
+}
+
+//--------------------------------------------------------------------------------------
+GameObjectManager::GameObjectManager()
+    : m_typeLists( MAX_GAMEOBJECT_TYPES )
+{
+}
+
 GameObjectManager* GameObjectManager::GetDefault()
 {
     if( !s_default )
@@ -14,29 +104,114 @@ GameObjectManager* GameObjectManager::GetDefault()
 
 void GameObjectManager::Update()
 {
+    PROFILER_SCOPED();
+
+    m_parallelPhase.clear();
+    for( GameObject* go : m_allGameObjectsFlat )
+    {
+        go->m_isInParallelPhase = go->IsFirstUpdateDone()
+            && go->GetUpdatePhase() == UpdatePhase::PARALLEL;
+        if( go->m_isInParallelPhase )
+            m_parallelPhase.push_back( go );
+    }
+
+    m_isInParallelPhase = true;
+    JobSystem::ParallelFor( (int) m_parallelPhase.size(), [this]( int startIdx, int endIdx ) {
+        PROFILER_PUSH( ParallelUpdate );
+        for( int goIdx = startIdx; goIdx < endIdx; ++goIdx )
+        {
+            m_parallelPhase[goIdx]->Update();
+        }
+        PROFILER_POP();
+    }, PARALLEL_UPDATE_GRAIN );
+    m_isInParallelPhase = false;
+    RunDeferredCommands();
+
+    // by index since updates can add and remove objects, an object moved
+    // into an earlier index by a removal waits for the next frame
     for (int i = 0; i < m_allGameObjectsFlat.size() ; ++i)
     {
-        m_allGameObjectsFlat[i]->Update();
+        GameObject* go = m_allGameObjectsFlat[i];
+        if( !go->m_isInParallelPhase )
+            go->Update();
     }
 }
 
 void GameObjectManager::DeleteDeadGameObjects()
 {
-    int count = (int)m_allGameObjectsFlat.size();
-    // loop removes elements from vectors!
-    for (int i = count - 1; i >= 0 ; --i)
+    PROFILER_SCOPED();
+
+    m_deadGameObjects.clear();
+    for( GameObject* go : m_allGameObjectsFlat )
     {
-        GameObject* go = m_allGameObjectsFlat[i];
-        if( go->ShouldDie() )
-        {
-            delete go;
-        }
+        if( !go->ShouldDie() )
+            continue;
+
+        int depth = 0;
+        const Transform* parent = static_cast<const GameObject*>( go )->GetTransform().GetParent();
+        for( ; parent; parent = parent->GetParent() )
+            ++depth;
+        m_deadGameObjects.emplace_back( depth, go->GetHandle() );
+    }
+
+    // deepest first, so a dying parent has no children left to reparent
+    // when whole trees die at once
+    std::stable_sort( m_deadGameObjects.begin(), m_deadGameObjects.end(),
+                      []( const DeadGameObject& a, const DeadGameObject& b ) {
+        return a.first > b.first;
+    } );
+
+    // each delete removes itself from the lists in constant time,
+    // resolved again in case a destructor already deleted another dead object
+    for( auto& entry : m_deadGameObjects )
+    {
+        delete GetGameObject( entry.second );
     }
 }
 
-std::vector<GameObject*>& GameObjectManager::GetObjectsOfType( std::string type )
+GameObject* GameObjectManager::GetGameObject( GameObjectHandle handle ) const
 {
-    return m_allGameObjects[type];
+    if( handle.m_slotIdx >= m_slots.size() )
+        return nullptr;
+    const Slot& slot = m_slots[handle.m_slotIdx];
+    if( slot.m_generation != handle.m_generation )
+        return nullptr;
+    return slot.m_object;
+}
+
+void GameObjectManager::DeferUntilSerial( const std::function<void()>& command )
+{
+    if( !m_isInParallelPhase )
+    {
+        command();
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock( m_deferredLock );
+    m_deferredCommands.push_back( command );
+}
+
+void GameObjectManager::RunDeferredCommands()
+{
+    std::vector<std::function<void()>> commands;
+    {
+        std::lock_guard<std::mutex> lock( m_deferredLock );
+        commands.swap( m_deferredCommands );
+    }
+    for( auto& command : commands )
+    {
+        command();
+    }
+}
+
+std::vector<GameObject*>& GameObjectManager::GetObjectsOfType( GameObjectTypeId typeId )
+{
+    return m_typeLists[typeId].m_objects;
+}
+
+std::vector<GameObject*>& GameObjectManager::GetObjectsOfType( const String& typeName )
+{
+    return GetObjectsOfType( RegisterType( typeName ) );
 }
 
 std::vector<GameObject*>& GameObjectManager::GetObejctsFlat()
@@ -46,18 +221,110 @@ std::vector<GameObject*>& GameObjectManager::GetObejctsFlat()
 
 void GameObjectManager::AddGameObject( GameObject* go )
 {
-    std::string goType = go->GetType();
-    std::vector<GameObject*>& gos = GetObjectsOfType( goType );
+    if( m_isInParallelPhase )
+    {
+        DeferUntilSerial( [this, go]() { AddGameObject( go ); } );
+        return;
+    }
+
+    uint slotIdx;
+    if( !m_freeSlotIdxs.empty() )
+    {
+        slotIdx = m_freeSlotIdxs.back();
+        m_freeSlotIdxs.pop_back();
+    }
+    else
+    {
+        slotIdx = (uint) m_slots.size();
+        m_slots.emplace_back();
+    }
+
+    Slot& slot = m_slots[slotIdx];
+    slot.m_object = go;
+    slot.m_flatIdx = (uint) m_allGameObjectsFlat.size();
+    AddToTypeList( slotIdx, go->GetTypeId() );
 
-    gos.push_back( go );
     m_allGameObjectsFlat.push_back( go );
+    m_flatSlotIdxs.push_back( slotIdx );
+
+    go->m_handle.m_slotIdx = slotIdx;
+    go->m_handle.m_generation = slot.m_generation;
 }
 
 void GameObjectManager::RemoveGameObject( GameObject* go )
 {
-    std::string goType = go->GetType();
-    std::vector<GameObject*>& gos = GetObjectsOfType( goType );
-    ContainerUtils::EraseOneValue( gos, go );
-    ContainerUtils::EraseOneValue( m_allGameObjectsFlat, go );
+    GameObjectHandle handle = go->m_handle;
+    go->m_handle = GameObjectHandle();
+    if( m_isInParallelPhase )
+    {
+        DeferUntilSerial( [this, handle]() { RemoveSlot( handle ); } );
+        return;
+    }
+    RemoveSlot( handle );
 }
 
+void GameObjectManager::RemoveSlot( GameObjectHandle handle )
+{
+    if( nullptr == GetGameObject( handle ) )
+        return;
+
+    Slot& slot = m_slots[handle.m_slotIdx];
+
+    // swap and pop, the moved object's slot learns its new index
+    uint lastFlatSlotIdx = m_flatSlotIdxs.back();
+    m_allGameObjectsFlat[slot.m_flatIdx] = m_allGameObjectsFlat.back();
+    m_flatSlotIdxs[slot.m_flatIdx] = lastFlatSlotIdx;
+    m_slots[lastFlatSlotIdx].m_flatIdx = slot.m_flatIdx;
+    m_allGameObjectsFlat.pop_back();
+    m_flatSlotIdxs.pop_back();
+
+    RemoveFromTypeList( handle.m_slotIdx );
+
+    slot.m_object = nullptr;
+    ++slot.m_generation;
+    m_freeSlotIdxs.push_back( handle.m_slotIdx );
+}
+
+void GameObjectManager::ChangeType( GameObject* go, GameObjectTypeId typeId )
+{
+    GameObjectHandle handle = go->m_handle;
+    if( m_isInParallelPhase )
+    {
+        DeferUntilSerial( [this, handle, typeId]() {
+            if( GetGameObject( handle ) )
+            {
+                RemoveFromTypeList( handle.m_slotIdx );
+                AddToTypeList( handle.m_slotIdx, typeId );
+            }
+        } );
+        return;
+    }
+
+    if( nullptr == GetGameObject( handle ) )
+        return;
+    RemoveFromTypeList( handle.m_slotIdx );
+    AddToTypeList( handle.m_slotIdx, typeId );
+}
+
+void GameObjectManager::AddToTypeList( uint slotIdx, GameObjectTypeId typeId )
+{
+    Slot& slot = m_slots[slotIdx];
+    TypeList& typeList = m_typeLists[typeId];
+    slot.m_typeId = typeId;
+    slot.m_typeIdx = (uint) typeList.m_objects.size();
+    typeList.m_objects.push_back( slot.m_object );
+    typeList.m_slotIdxs.push_back( slotIdx );
+}
+
+void GameObjectManager::RemoveFromTypeList( uint slotIdx )
+{
+    // swap and pop, like the flat list
+    Slot& slot = m_slots[slotIdx];
+    TypeList& typeList = m_typeLists[slot.m_typeId];
+    uint lastTypeSlotIdx = typeList.m_slotIdxs.back();
+    typeList.m_objects[slot.m_typeIdx] = typeList.m_objects.back();
+    typeList.m_slotIdxs[slot.m_typeIdx] = lastTypeSlotIdx;
+    m_slots[lastTypeSlotIdx].m_typeIdx = slot.m_typeIdx;
+    typeList.m_objects.pop_back();
+    typeList.m_slotIdxs.pop_back();
+}
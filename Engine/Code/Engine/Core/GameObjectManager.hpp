@@ -1,13 +1,35 @@
 #pragma once
 
 #include <vector>
-#include <map>
 #include <string>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include "Engine/Core/Types.hpp"
 
 class GameObject;
 
 typedef std::vector<GameObject*> GameObjects;
 
+// Interned type name, the same id in every manager
+typedef uint GameObjectTypeId;
+
+// Refers to a GameObject without owning it, resolves to nullptr once the object is gone
+struct GameObjectHandle
+{
+    static constexpr uint INVALID_SLOT = 0xffffffff;
+
+    bool IsValid() const { return m_slotIdx != INVALID_SLOT; };
+    bool operator==( const GameObjectHandle& other ) const
+    {
+        return m_slotIdx == other.m_slotIdx && m_generation == other.m_generation;
+    };
+    bool operator!=( const GameObjectHandle& other ) const { return !( *this == other ); };
+
+    uint m_slotIdx = INVALID_SLOT;
+    uint m_generation = 0;
+};
+
 class GameObjectManager
 {
     friend class GameObject;
@@ -15,23 +37,85 @@ public:
     static GameObjectManager* GetDefault();
     static void SetDefault( GameObjectManager* manager ) { s_default = manager; };
 
-    GameObjectManager() {};
+    // Thread safe, returns the existing id if the name was registered before
+    // Names past MAX_GAMEOBJECT_TYPES all share the last id
+    static GameObjectTypeId RegisterType( const String& typeName );
+    static const String& GetTypeName( GameObjectTypeId typeId );
+    static constexpr uint MAX_GAMEOBJECT_TYPES = 1024;
+
+    GameObjectManager();
     virtual ~GameObjectManager() {};
 
+    // Objects in UpdatePhase::PARALLEL are updated first, in chunks on the JobSystem,
+    // then the rest are updated one by one on the calling thread
     virtual void Update();
     virtual void DeleteDeadGameObjects();
 
-    GameObjects& GetObjectsOfType( std::string type );
+    // Fewest parallel objects handed to one job
+    static constexpr int PARALLEL_UPDATE_GRAIN = 64;
+
+    bool IsInParallelPhase() const { return m_isInParallelPhase; };
+    // Thread safe, runs the command once the parallel phase is over or right away outside of it
+    void DeferUntilSerial( const std::function<void()>& command );
+
+    // nullptr if the object was deleted or moved to another manager
+    GameObject* GetGameObject( GameObjectHandle handle ) const;
+
+    // Order is not stable, removing an object moves the last one into its place
+    GameObjects& GetObjectsOfType( GameObjectTypeId typeId );
+    // Slow path, interns the name on every call, cache the id for per frame queries
+    GameObjects& GetObjectsOfType( const String& typeName );
     GameObjects& GetObejctsFlat();
 
 protected:
+    // Objects of one type, each with the slot it belongs to
+    struct TypeList
+    {
+        GameObjects m_objects;
+        std::vector<uint> m_slotIdxs;
+    };
+
+    // Where an object is stored, handles point here so the lists can be reordered
+    struct Slot
+    {
+        GameObject* m_object = nullptr;
+        uint m_generation = 0;
+        uint m_flatIdx = 0;
+        uint m_typeIdx = 0;
+        GameObjectTypeId m_typeId = 0;
+    };
+
     // Only called through GameObject::
     void AddGameObject( GameObject* go );
     void RemoveGameObject( GameObject* go );
+    // Does not touch the object, so deferred removals are safe after it is deleted
+    void RemoveSlot( GameObjectHandle handle );
+    // Keeps the handle, the object moves to the end of the new type's list
+    void ChangeType( GameObject* go, GameObjectTypeId typeId );
+    void AddToTypeList( uint slotIdx, GameObjectTypeId typeId );
+    void RemoveFromTypeList( uint slotIdx );
+    void RunDeferredCommands();
 
     static GameObjectManager* s_default;
 
-    // string is the type of object
-    std::map< std::string, GameObjects> m_allGameObjects;
+    // indexed by GameObjectTypeId, sized for every type up front so references
+    // returned by GetObjectsOfType stay valid when new types are registered
+    std::vector<TypeList> m_typeLists;
     GameObjects m_allGameObjectsFlat;
+    std::vector<uint> m_flatSlotIdxs;
+
+    std::vector<Slot> m_slots;
+    std::vector<uint> m_freeSlotIdxs;
+
+    // reused by DeleteDeadGameObjects, with their depth in the transform hierarchy
+    typedef std::pair<int, GameObjectHandle> DeadGameObject;
+    std::vector<DeadGameObject> m_deadGameObjects;
+
+    // rebuilt every update
+    GameObjects m_parallelPhase;
+    std::atomic<bool> m_isInParallelPhase = false;
+
+    // structural changes and callbacks from the parallel phase
+    std::mutex m_deferredLock;
+    std::vector<std::function<void()>> m_deferredCommands;
 };
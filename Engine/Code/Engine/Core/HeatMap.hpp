@@ -40,6 +40,9 @@ public:
 
     IVec2 GetDimensions() const { return m_dimensions; }
     uint GetSize() const { return m_heatPerGridCell.size(); }
+    // Row major, GetSize() cells
+    T* GetData() { return m_heatPerGridCell.data(); }
+    const T* GetData() const { return m_heatPerGridCell.data(); }
 
 private:
     IVec2 m_dimensions;
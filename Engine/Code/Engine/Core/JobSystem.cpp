@@ -0,0 +1,363 @@
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/Thread.hpp"
+#include "Engine/Core/Profiler.hpp"
+#include "Engine/Core/ErrorUtils.hpp"
+
+#include <deque>
+#include <condition_variable>
+#include <stdio.h>
+
+namespace JobSystem
+{
+
+//--------------------------------------------------------------------------------------
+// internal
+
+struct Job
+{
+    JobFunction m_function;
+    JobCounter* m_counter = nullptr;
+};
+
+// The owner pushes and pops at the back, thieves take from the front so
+// they get the oldest and usually largest pieces of work
+struct WorkerQueue
+{
+    std::mutex m_lock;
+    std::deque<Job*> m_jobs;
+};
+
+constexpr int MAX_SLEEP_MS = 10;
+
+void WorkerThreadMain( int threadIdx, uint64 coreAffinity );
+uint64 PickWorkerCore( uint64 workerCores, int workerIdx );
+void Schedule( Job* job );
+Job* FindJob( int threadIdx );
+bool TryRunJob();
+void Execute( Job* job );
+
+std::vector<WorkerQueue*> g_queues;
+std::vector<Thread::Handle> g_workers;
+std::atomic<bool> g_isRunning = false;
+
+// jobs scheduled from threads outside the pool
+WorkerQueue g_sharedQueue;
+
+// queued jobs in all queues, lets idle workers sleep without missing work
+std::atomic<int> g_queuedCount = 0;
+std::atomic<int> g_sleepingCount = 0;
+std::mutex g_sleepLock;
+std::condition_variable g_sleepCondition;
+
+thread_local int t_threadIdx = -1;
+thread_local uint t_stealSeed = 0;
+
+
+
+void AddToCounter( JobCounter* counter, int amount )
+{
+    if( nullptr == counter )
+        return;
+
+    // IsDone stays false until this thread is done with the counter, a waiter may
+    // destroy it right after
+    counter->m_releasingCount.fetch_add( 1 );
+    int newCount = counter->m_count.fetch_add( amount ) + amount;
+
+    // released jobs were waiting on this counter
+    std::vector<Job*> released;
+    if( newCount == 0 )
+    {
+        std::lock_guard<std::mutex> lock( counter->m_waitingJobsLock );
+        if( counter->m_count.load() == 0 )
+            released.swap( counter->m_waitingJobs );
+    }
+    counter->m_releasingCount.fetch_sub( 1 );
+
+    for( Job* job : released )
+    {
+        Schedule( job );
+    }
+}
+
+void RunAfter( JobCounter* dependency, Job* job )
+{
+    {
+        // not IsDone, a release in flight has already taken the waiting jobs or
+        // will take this one with them
+        std::lock_guard<std::mutex> lock( dependency->m_waitingJobsLock );
+        if( dependency->m_count.load() != 0 )
+        {
+            dependency->m_waitingJobs.push_back( job );
+            return;
+        }
+    }
+    Schedule( job );
+}
+
+void Schedule( Job* job )
+{
+    WorkerQueue* queue = ( t_threadIdx >= 0 ) ? g_queues[t_threadIdx] : &g_sharedQueue;
+    {
+        std::lock_guard<std::mutex> lock( queue->m_lock );
+        queue->m_jobs.push_back( job );
+    }
+    g_queuedCount.fetch_add( 1 );
+
+    if( g_sleepingCount.load() > 0 )
+    {
+        std::lock_guard<std::mutex> lock( g_sleepLock );
+        g_sleepCondition.notify_one();
+    }
+}
+
+Job* FindJob( int threadIdx )
+{
+    if( g_queuedCount.load( std::memory_order_acquire ) == 0 )
+        return nullptr;
+
+    Job* job = nullptr;
+    if( threadIdx >= 0 )
+    {
+        WorkerQueue* ownQueue = g_queues[threadIdx];
+        std::lock_guard<std::mutex> lock( ownQueue->m_lock );
+        if( !ownQueue->m_jobs.empty() )
+        {
+            job = ownQueue->m_jobs.back();
+            ownQueue->m_jobs.pop_back();
+        }
+    }
+
+    if( nullptr == job )
+    {
+        std::lock_guard<std::mutex> lock( g_sharedQueue.m_lock );
+        if( !g_sharedQueue.m_jobs.empty() )
+        {
+            job = g_sharedQueue.m_jobs.front();
+            g_sharedQueue.m_jobs.pop_front();
+        }
+    }
+
+    if( nullptr == job )
+    {
+        // start at a different victim every time so thieves spread out
+        int queueCount = (int) g_queues.size();
+        t_stealSeed = t_stealSeed * 1664525u + 1013904223u;
+        int startIdx = (int) ( ( t_stealSeed >> 16 ) % queueCount );
+        for( int offset = 0; offset < queueCount && nullptr == job; ++offset )
+        {
+            int victimIdx = ( startIdx + offset ) % queueCount;
+            if( victimIdx == threadIdx )
+                continue;
+            WorkerQueue* victim = g_queues[victimIdx];
+            std::lock_guard<std::mutex> lock( victim->m_lock );
+            if( !victim->m_jobs.empty() )
+            {
+                job = victim->m_jobs.front();
+                victim->m_jobs.pop_front();
+            }
+        }
+    }
+
+    if( job )
+        g_queuedCount.fetch_sub( 1 );
+    return job;
+}
+
+void Execute( Job* job )
+{
+    job->m_function();
+    AddToCounter( job->m_counter, -1 );
+    delete job;
+}
+
+bool TryRunJob()
+{
+    Job* job = FindJob( t_threadIdx );
+    if( nullptr == job )
+        return false;
+    Execute( job );
+    return true;
+}
+
+uint64 PickWorkerCore( uint64 workerCores, int workerIdx )
+{
+    if( workerCores == 0 )
+        return 0;
+
+    int coreCount = 0;
+    for( uint64 bits = workerCores; bits != 0; bits &= bits - 1 )
+        ++coreCount;
+
+    int pickIdx = workerIdx % coreCount;
+    for( uint64 bits = workerCores; bits != 0; bits &= bits - 1 )
+    {
+        if( pickIdx-- == 0 )
+            return bits & ( ~bits + 1 );
+    }
+    return 0;
+}
+
+void WorkerThreadMain( int threadIdx, uint64 coreAffinity )
+{
+    t_threadIdx = threadIdx;
+    t_stealSeed = (uint) threadIdx * 2654435761u;
+
+    char name[32];
+    snprintf( name, sizeof( name ), "Job Worker %i", threadIdx );
+    Thread::ThreadSetName( name );
+    Profiler::SetThreadName( name );
+    if( coreAffinity != 0 )
+        Thread::ThreadSetCoreAffinity( coreAffinity );
+
+    while( g_isRunning.load() )
+    {
+        if( TryRunJob() )
+            continue;
+
+        std::unique_lock<std::mutex> lock( g_sleepLock );
+        g_sleepingCount.fetch_add( 1 );
+        if( g_queuedCount.load() == 0 && g_isRunning.load() )
+            g_sleepCondition.wait_for( lock, std::chrono::milliseconds( MAX_SLEEP_MS ) );
+        g_sleepingCount.fetch_sub( 1 );
+    }
+}
+
+//--------------------------------------------------------------------------------------
+void StartUp( int workerCount, uint64 workerCores )
+{
+    GUARANTEE_OR_DIE( !g_isRunning, "JobSystem already started" );
+
+    if( workerCount < 0 )
+    {
+        int coreCount = (int) Thread::GetCoreCount();
+        workerCount = coreCount > 1 ? coreCount - 1 : 1;
+    }
+
+    // index 0 is the thread that started the system
+    for( int queueIdx = 0; queueIdx <= workerCount; ++queueIdx )
+    {
+        g_queues.push_back( new WorkerQueue() );
+    }
+    t_threadIdx = 0;
+    g_isRunning = true;
+
+    for( int workerIdx = 1; workerIdx <= workerCount; ++workerIdx )
+    {
+        uint64 coreAffinity = PickWorkerCore( workerCores, workerIdx - 1 );
+        g_workers.push_back( Thread::Create( WorkerThreadMain, workerIdx, coreAffinity ) );
+    }
+}
+
+void ShutDown()
+{
+    if( !g_isRunning )
+        return;
+
+    g_isRunning = false;
+    {
+        std::lock_guard<std::mutex> lock( g_sleepLock );
+        g_sleepCondition.notify_all();
+    }
+    for( Thread::Handle worker : g_workers )
+    {
+        Thread::Join( worker );
+        delete worker;
+    }
+    g_workers.clear();
+
+    // workers can schedule or release jobs until they exit, this thread is the only one
+    // left now, run everything so no counter is left waiting and no job leaks
+    while( g_queuedCount.load() > 0 )
+    {
+        TryRunJob();
+    }
+
+    for( WorkerQueue* queue : g_queues )
+    {
+        delete queue;
+    }
+    g_queues.clear();
+    t_threadIdx = -1;
+}
+
+bool IsRunning()
+{
+    return g_isRunning;
+}
+
+int GetThreadCount()
+{
+    return (int) g_queues.size();
+}
+
+int GetThreadIndex()
+{
+    return t_threadIdx;
+}
+
+void Run( const JobFunction& function, JobCounter* counter, JobCounter* dependency )
+{
+    if( !g_isRunning )
+    {
+        if( dependency )
+            Wait( dependency );
+        function();
+        return;
+    }
+
+    Job* job = new Job();
+    job->m_function = function;
+    job->m_counter = counter;
+    AddToCounter( counter, 1 );
+
+    if( dependency )
+        RunAfter( dependency, job );
+    else
+        Schedule( job );
+}
+
+void Wait( JobCounter* counter )
+{
+    PROFILER_SCOPED();
+    while( !counter->IsDone() )
+    {
+        // still helps while ShutDown drains the queues
+        if( !TryRunJob() )
+            Thread::ThreadYield();
+    }
+}
+
+void ParallelFor( int count, const RangeFunction& function, int grainSize )
+{
+    if( count <= 0 )
+        return;
+
+    if( grainSize <= 0 )
+    {
+        // a few chunks per thread so stealing can even out uneven work
+        int chunkCount = GetThreadCount() * 4;
+        grainSize = chunkCount > 0 ? ( count + chunkCount - 1 ) / chunkCount : count;
+        if( grainSize < 1 )
+            grainSize = 1;
+    }
+
+    if( !g_isRunning || count <= grainSize )
+    {
+        function( 0, count );
+        return;
+    }
+
+    // the last chunk runs on this thread while the others are picked up
+    JobCounter counter;
+    int lastStartIdx = ( ( count - 1 ) / grainSize ) * grainSize;
+    for( int startIdx = 0; startIdx < lastStartIdx; startIdx += grainSize )
+    {
+        int endIdx = startIdx + grainSize;
+        Run( [&function, startIdx, endIdx]() { function( startIdx, endIdx ); }, &counter );
+    }
+    function( lastStartIdx, count );
+    Wait( &counter );
+}
+
+}
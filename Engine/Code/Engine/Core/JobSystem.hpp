@@ -0,0 +1,70 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include <atomic>
+#include <mutex>
+#include <functional>
+
+// Fixed pool of worker threads, each with its own job deque
+// Workers take their newest job first and steal the oldest job of another worker
+// when they run out, threads that wait on a counter run jobs instead of blocking
+namespace JobSystem
+{
+typedef std::function<void()> JobFunction;
+// Runs on [startIdx, endIdx)
+typedef std::function<void( int startIdx, int endIdx )> RangeFunction;
+
+struct Job;
+
+// Counts unfinished jobs, other jobs can be held back until it reaches zero
+// Must outlive every job that uses it
+class JobCounter
+{
+public:
+    JobCounter() {};
+    ~JobCounter() {};
+
+    // Also waits out a thread still releasing the waiting jobs, so the counter
+    // can be destroyed as soon as this is true
+    bool IsDone() const
+    {
+        return m_count.load() == 0 && m_releasingCount.load() == 0;
+    };
+    int GetCount() const { return m_count.load( std::memory_order_acquire ); };
+
+private:
+    friend void AddToCounter( JobCounter* counter, int amount );
+    friend void RunAfter( JobCounter* dependency, Job* job );
+
+    std::atomic<int> m_count = 0;
+    // threads inside AddToCounter, which may still touch the waiting jobs
+    std::atomic<int> m_releasingCount = 0;
+    std::mutex m_waitingJobsLock;
+    std::vector<Job*> m_waitingJobs;
+};
+
+// workerCount < 0 uses one worker per core, not counting the calling thread
+// The calling thread becomes worker 0 and runs jobs whenever it waits
+// If workerCores is set each worker is pinned to one of its cores, round robin
+void StartUp( int workerCount = -1, uint64 workerCores = 0 );
+void ShutDown();
+bool IsRunning();
+
+// Threads in the pool, including the thread that called StartUp
+int GetThreadCount();
+// -1 for threads outside the pool
+int GetThreadIndex();
+
+// counter is incremented now and decremented when the job has run
+// the job does not start before dependency is done
+// Runs the job right away if the system is not running
+void Run( const JobFunction& function, JobCounter* counter = nullptr,
+          JobCounter* dependency = nullptr );
+
+// Runs other jobs until the counter is done
+void Wait( JobCounter* counter );
+
+// Splits [0, count) into jobs of at most grainSize and waits for all of them
+// grainSize <= 0 picks a size that gives every thread a few chunks
+void ParallelFor( int count, const RangeFunction& function, int grainSize = 0 );
+
+}
@@ -1,9 +1,23 @@
 #pragma once
 #include "Engine/Core/Types.hpp"
+#include <atomic>
 
+// Fixed size record, entries live in per thread rings owned by the Logger
+// and are recycled once the worker has passed them to the hooks
 struct LogEntry
 {
 public:
-    String m_tag;
-    String m_text;
+    static constexpr int MAX_PAYLOAD_SIZE = 484;
+
+    uint64 m_ticks = 0;         // TimeUtils::GetCurrentTimeTicks when it was logged
+    uint m_threadId = 0;        // index of the logging thread's ring
+    uint m_tagId = 0;           // see Logger::GetTagName
+    // The format is only recorded when formatting is deferred, the payload then holds
+    // the packed arguments (see LogFormat), otherwise it holds the formatted text
+    uint m_formatId = 0xffffffff;
+    uint m_payloadSize = 0;
+    Byte m_payload[MAX_PAYLOAD_SIZE];   // text is null terminated, longer lines are truncated
+
+    // set by the logging thread, cleared by the worker when the entry can be reused
+    std::atomic<bool> m_inUse = false;
 };
@@ -0,0 +1,184 @@
+#include "Engine/Core/LogFileWriter.hpp"
+#include "Engine/Time/Time.hpp"
+
+#include <string.h>
+
+
+LogFileWriter::LogFileWriter( const String& filePath, const LogRotationSettings& rotation )
+    : m_filePath( filePath )
+    , m_rotation( rotation )
+{
+    m_buffers[0].reserve( BUFFER_SIZE );
+    m_buffers[1].reserve( BUFFER_SIZE );
+}
+
+LogFileWriter::~LogFileWriter()
+{
+    Close();
+}
+
+bool LogFileWriter::Open()
+{
+    m_file = fopen( m_filePath.c_str(), "w" );
+    if( nullptr == m_file )
+        return false;
+
+    m_fileBytes = 0;
+    m_fileOpenTime = TimeUtils::GetCurrentTimeSeconds();
+    m_isIOThreadRunning = true;
+    m_ioThread = Thread::Create( LogFileWriter::IOThreadWorker, this );
+    m_isOpen = true;
+    return true;
+}
+
+void LogFileWriter::WriteLine( const char* tag, const char* text, size_t textLength )
+{
+    if( !IsOpen() )
+        return;
+
+    size_t tagLength = strlen( tag );
+    size_t lineLength = tagLength + 2 + textLength + 1;
+    if( m_buffers[m_frontIdx].size() + lineLength > BUFFER_SIZE )
+        SubmitFrontBuffer( false );
+
+    std::vector<char>& front = m_buffers[m_frontIdx];
+    front.insert( front.end(), tag, tag + tagLength );
+    front.push_back( ':' );
+    front.push_back( ' ' );
+    front.insert( front.end(), text, text + textLength );
+    front.push_back( '\n' );
+}
+
+void LogFileWriter::Flush()
+{
+    if( !IsOpen() )
+        return;
+
+    SubmitFrontBuffer( true );
+    std::unique_lock<std::mutex> lock( m_lock );
+    WaitForIdle( lock );
+}
+
+void LogFileWriter::Close()
+{
+    if( nullptr == m_ioThread )
+        return;
+
+    Flush();
+    m_isOpen = false;
+    {
+        std::lock_guard<std::mutex> lock( m_lock );
+        m_isIOThreadRunning = false;
+        m_condition.notify_all();
+    }
+    Thread::Join( m_ioThread );
+    m_ioThread = nullptr;
+
+    if( nullptr != m_file )
+    {
+        fclose( m_file );
+        m_file = nullptr;
+    }
+}
+
+void LogFileWriter::IOThreadWorker( LogFileWriter* writer )
+{
+    Thread::ThreadSetName( "Log File IO" );
+
+    std::unique_lock<std::mutex> lock( writer->m_lock );
+    for( ;; )
+    {
+        writer->m_condition.wait( lock, [writer]() {
+            return writer->m_hasPendingBuffer || !writer->m_isIOThreadRunning;
+        } );
+        if( !writer->m_hasPendingBuffer )
+            break;
+
+        // the front buffer is never touched while one is pending, so write without the lock
+        std::vector<char>& pending = writer->m_buffers[1 - writer->m_frontIdx];
+        bool shouldFlush = writer->m_shouldFlushPending;
+        lock.unlock();
+        writer->WriteToDisk( pending, shouldFlush );
+        pending.clear();
+        lock.lock();
+
+        writer->m_hasPendingBuffer = false;
+        writer->m_condition.notify_all();
+    }
+}
+
+void LogFileWriter::SubmitFrontBuffer( bool shouldFlush )
+{
+    std::unique_lock<std::mutex> lock( m_lock );
+    WaitForIdle( lock );
+    if( m_buffers[m_frontIdx].empty() && !shouldFlush )
+        return;
+
+    m_frontIdx = 1 - m_frontIdx;
+    m_hasPendingBuffer = true;
+    m_shouldFlushPending = shouldFlush;
+    m_condition.notify_all();
+}
+
+void LogFileWriter::WaitForIdle( std::unique_lock<std::mutex>& lock )
+{
+    m_condition.wait( lock, [this]() { return !m_hasPendingBuffer; } );
+}
+
+void LogFileWriter::WriteToDisk( const std::vector<char>& buffer, bool shouldFlush )
+{
+    if( ShouldRotate( buffer.size() ) )
+        Rotate();
+    if( nullptr == m_file )
+        return;
+
+    if( !buffer.empty() )
+    {
+        fwrite( buffer.data(), 1, buffer.size(), m_file );
+        m_fileBytes += buffer.size();
+    }
+    if( shouldFlush )
+        fflush( m_file );
+}
+
+bool LogFileWriter::ShouldRotate( size_t incomingBytes )
+{
+    if( m_fileBytes == 0 || m_rotation.m_maxFiles < 2 )
+        return false;
+
+    bool isTooBig = m_rotation.m_maxFileBytes > 0
+        && m_fileBytes + incomingBytes > m_rotation.m_maxFileBytes;
+    bool isTooOld = m_rotation.m_maxFileSeconds > 0.0
+        && TimeUtils::GetCurrentTimeSeconds() - m_fileOpenTime >= m_rotation.m_maxFileSeconds;
+    return isTooBig || isTooOld;
+}
+
+void LogFileWriter::Rotate()
+{
+    if( nullptr != m_file )
+        fclose( m_file );
+
+    remove( GetRotatedPath( m_rotation.m_maxFiles - 1 ).c_str() );
+    for( int index = m_rotation.m_maxFiles - 2; index >= 0; --index )
+    {
+        rename( GetRotatedPath( index ).c_str(), GetRotatedPath( index + 1 ).c_str() );
+    }
+
+    m_file = fopen( m_filePath.c_str(), "w" );
+    m_fileBytes = 0;
+    m_fileOpenTime = TimeUtils::GetCurrentTimeSeconds();
+}
+
+String LogFileWriter::GetRotatedPath( int index )
+{
+    if( index == 0 )
+        return m_filePath;
+
+    // log.txt -> log.1.txt, the extension stays last so the files still open as text
+    size_t extensionStart = m_filePath.find_last_of( '.' );
+    size_t nameStart = m_filePath.find_last_of( "/\\" );
+    if( extensionStart == String::npos || ( nameStart != String::npos && extensionStart < nameStart ) )
+        return m_filePath + "." + std::to_string( index );
+    return m_filePath.substr( 0, extensionStart ) + "." + std::to_string( index )
+        + m_filePath.substr( extensionStart );
+}
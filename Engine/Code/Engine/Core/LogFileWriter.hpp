@@ -0,0 +1,70 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Thread.hpp"
+#include <stdio.h>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+// When a log file is closed and moved aside, 0 disables a limit
+// log.txt rotates to log.1.txt, log.1.txt to log.2.txt and so on
+struct LogRotationSettings
+{
+    size_t m_maxFileBytes = 64 * 1024 * 1024;
+    double m_maxFileSeconds = 0.0;
+    int m_maxFiles = 8;     // including the active one, the oldest is deleted
+};
+
+// Text log file with two buffers, the logger thread fills one while an io
+// thread writes the other, so the disk only sees large sequential writes
+class LogFileWriter
+{
+public:
+    static constexpr int BUFFER_SIZE = 256 * 1024;
+
+    LogFileWriter( const String& filePath, const LogRotationSettings& rotation );
+    ~LogFileWriter();
+
+    bool Open();
+    // Lines are never split between two files
+    void WriteLine( const char* tag, const char* text, size_t textLength );
+    // Returns once everything written so far is on disk
+    void Flush();
+    void Close();
+
+    bool IsOpen() { return m_isOpen; };
+
+private:
+    static void IOThreadWorker( LogFileWriter* writer );
+
+    // Hands the front buffer to the io thread, waits if it is still writing the other one
+    void SubmitFrontBuffer( bool shouldFlush );
+    void WaitForIdle( std::unique_lock<std::mutex>& lock );
+
+    // io thread
+    void WriteToDisk( const std::vector<char>& buffer, bool shouldFlush );
+    bool ShouldRotate( size_t incomingBytes );
+    void Rotate();
+    String GetRotatedPath( int index );
+
+private:
+    String m_filePath;
+    LogRotationSettings m_rotation;
+
+    // set and cleared by Open and Close, m_file belongs to the io thread and can be
+    // null while open if a rotation failed to reopen it
+    std::atomic<bool> m_isOpen = false;
+    FILE* m_file = nullptr;
+    size_t m_fileBytes = 0;
+    double m_fileOpenTime = 0.0;
+
+    std::vector<char> m_buffers[2];
+    int m_frontIdx = 0;
+
+    std::mutex m_lock;
+    std::condition_variable m_condition;
+    bool m_hasPendingBuffer = false;
+    bool m_shouldFlushPending = false;
+    bool m_isIOThreadRunning = false;
+    Thread::Handle m_ioThread = nullptr;
+};
@@ -0,0 +1,416 @@
+#include "Engine/Core/LogFormat.hpp"
+
+#include <string.h>
+#include <stdint.h>
+
+namespace LogFormat
+{
+
+//--------------------------------------------------------------------------------------
+// internal
+
+// One conversion like %-8.*lld, star widths and precisions are INT32 args before the value
+struct ConversionSpec
+{
+    int m_starCount = 0;
+    ArgType m_type = ArgType::INT32;
+    bool m_isPercentLiteral = false;
+    bool m_isSupported = true;
+};
+
+constexpr int MAX_SPEC_LEN = 32;
+constexpr int MAX_STRING_ARG_LEN = 1024;
+
+ArgType IntTypeOfSize( size_t size )
+{
+    return size > 4 ? ArgType::INT64 : ArgType::INT32;
+}
+
+// spec points at the '%', returns the first character after the conversion
+const char* ParseConversion( const char* spec, ConversionSpec& out_conversion )
+{
+    const char* cursor = spec + 1;
+    out_conversion = ConversionSpec();
+
+    while( *cursor && strchr( "-+ #0", *cursor ) )
+        ++cursor;
+
+    // width and precision
+    for( int part = 0; part < 2; ++part )
+    {
+        if( part == 1 )
+        {
+            if( *cursor != '.' )
+                break;
+            ++cursor;
+        }
+        if( *cursor == '*' )
+        {
+            ++out_conversion.m_starCount;
+            ++cursor;
+        }
+        while( *cursor >= '0' && *cursor <= '9' )
+            ++cursor;
+    }
+
+    // length modifiers, including the msvc ones
+    size_t intSize = sizeof( int );
+    bool isLongDouble = false;
+    bool isWide = false;
+    if( strncmp( cursor, "hh", 2 ) == 0 )
+        cursor += 2;
+    else if( *cursor == 'h' )
+        cursor += 1;
+    else if( strncmp( cursor, "ll", 2 ) == 0 || strncmp( cursor, "I64", 3 ) == 0 )
+    {
+        intSize = sizeof( long long );
+        cursor += ( *cursor == 'I' ) ? 3 : 2;
+    }
+    else if( strncmp( cursor, "I32", 3 ) == 0 )
+        cursor += 3;
+    else if( *cursor == 'l' )
+    {
+        intSize = sizeof( long );
+        isWide = true;
+        cursor += 1;
+    }
+    else if( *cursor == 'j' )
+    {
+        intSize = sizeof( intmax_t );
+        cursor += 1;
+    }
+    else if( *cursor == 'z' || *cursor == 't' || *cursor == 'I' )
+    {
+        intSize = sizeof( size_t );
+        cursor += 1;
+    }
+    else if( *cursor == 'L' )
+    {
+        isLongDouble = true;
+        cursor += 1;
+    }
+
+    char conversion = *cursor;
+    if( conversion == 0 )
+    {
+        out_conversion.m_isSupported = false;
+        return cursor;
+    }
+    ++cursor;
+
+    switch( conversion )
+    {
+    case '%':
+        out_conversion.m_isPercentLiteral = true;
+        break;
+    case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+        out_conversion.m_type = IntTypeOfSize( intSize );
+        break;
+    case 'c':
+        out_conversion.m_type = ArgType::INT32;
+        out_conversion.m_isSupported = !isWide;
+        break;
+    case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+        out_conversion.m_type = ArgType::DOUBLE;
+        out_conversion.m_isSupported = !isLongDouble;
+        break;
+    case 's':
+        out_conversion.m_type = ArgType::STRING;
+        out_conversion.m_isSupported = !isWide;
+        break;
+    case 'p':
+        out_conversion.m_type = ArgType::POINTER;
+        break;
+    default:
+        // %n, %S, %C and anything unknown
+        out_conversion.m_isSupported = false;
+        break;
+    }
+    return cursor;
+}
+
+template <typename T>
+bool WriteValue( const T& value, Byte* out_bytes, int maxBytes, int& inout_size )
+{
+    if( inout_size + (int) sizeof( T ) > maxBytes )
+        return false;
+    memcpy( out_bytes + inout_size, &value, sizeof( T ) );
+    inout_size += sizeof( T );
+    return true;
+}
+
+template <typename T>
+bool ReadValue( T& out_value, const Byte* bytes, int size, int& inout_offset )
+{
+    if( inout_offset + (int) sizeof( T ) > size )
+        return false;
+    memcpy( &out_value, bytes + inout_offset, sizeof( T ) );
+    inout_offset += sizeof( T );
+    return true;
+}
+
+// snprintf that clamps the cursor, so a truncated line just stops growing
+template <typename... Args>
+void AppendFormatted( char* out_text, int maxLength, int& inout_length,
+                      const char* spec, Args... args )
+{
+    int remaining = maxLength - inout_length;
+    if( remaining <= 1 )
+        return;
+    int written = snprintf( out_text + inout_length, remaining, spec, args... );
+    if( written > 0 )
+        inout_length += ( written < remaining ) ? written : remaining - 1;
+}
+
+template <typename T>
+void AppendConversion( char* out_text, int maxLength, int& inout_length,
+                       const char* spec, const int* stars, int starCount, T value )
+{
+    if( starCount == 0 )
+        AppendFormatted( out_text, maxLength, inout_length, spec, value );
+    else if( starCount == 1 )
+        AppendFormatted( out_text, maxLength, inout_length, spec, stars[0], value );
+    else
+        AppendFormatted( out_text, maxLength, inout_length, spec, stars[0], stars[1], value );
+}
+
+bool ReadRecordString( FILE* file, String& out_string )
+{
+    uint length = 0;
+    if( fread( &length, sizeof( length ), 1, file ) != 1 )
+        return false;
+    out_string.resize( length );
+    return length == 0 || fread( &out_string[0], 1, length, file ) == length;
+}
+
+//--------------------------------------------------------------------------------------
+bool ParseFormat( const char* format, ArgTypes& out_argTypes )
+{
+    out_argTypes.clear();
+    const char* cursor = format;
+    while( ( cursor = strchr( cursor, '%' ) ) != nullptr )
+    {
+        ConversionSpec conversion;
+        cursor = ParseConversion( cursor, conversion );
+        if( !conversion.m_isSupported )
+            return false;
+        if( conversion.m_isPercentLiteral )
+            continue;
+        for( int starIdx = 0; starIdx < conversion.m_starCount; ++starIdx )
+            out_argTypes.push_back( ArgType::INT32 );
+        out_argTypes.push_back( conversion.m_type );
+    }
+    return true;
+}
+
+int PackArgs( const ArgTypes& argTypes, va_list args, Byte* out_bytes, int maxBytes )
+{
+    int size = 0;
+    for( ArgType type : argTypes )
+    {
+        bool fits = true;
+        switch( type )
+        {
+        case ArgType::INT32:
+            fits = WriteValue( va_arg( args, int ), out_bytes, maxBytes, size );
+            break;
+        case ArgType::INT64:
+            fits = WriteValue( va_arg( args, long long ), out_bytes, maxBytes, size );
+            break;
+        case ArgType::DOUBLE:
+            fits = WriteValue( va_arg( args, double ), out_bytes, maxBytes, size );
+            break;
+        case ArgType::POINTER:
+            fits = WriteValue( (uint64) (uintptr_t) va_arg( args, void* ), out_bytes, maxBytes, size );
+            break;
+        case ArgType::STRING:
+        {
+            const char* str = va_arg( args, const char* );
+            if( nullptr == str )
+                str = "(null)";
+            uint length = (uint) strlen( str );
+            fits = WriteValue( length, out_bytes, maxBytes, size )
+                && size + (int) length <= maxBytes;
+            if( fits )
+            {
+                memcpy( out_bytes + size, str, length );
+                size += length;
+            }
+            break;
+        }
+        }
+        if( !fits )
+            return -1;
+    }
+    return size;
+}
+
+int FormatPackedArgs( const char* format, const Byte* args, int argBytes,
+                      char* out_text, int maxLength )
+{
+    int length = 0;
+    int argOffset = 0;
+    const char* cursor = format;
+    bool argsValid = true;
+
+    while( *cursor && argsValid && length < maxLength - 1 )
+    {
+        const char* percent = strchr( cursor, '%' );
+        int literalLength = percent ? (int) ( percent - cursor ) : (int) strlen( cursor );
+        int copyLength = literalLength < maxLength - 1 - length ? literalLength : maxLength - 1 - length;
+        memcpy( out_text + length, cursor, copyLength );
+        length += copyLength;
+        if( nullptr == percent )
+            break;
+
+        ConversionSpec conversion;
+        cursor = ParseConversion( percent, conversion );
+        if( conversion.m_isPercentLiteral )
+        {
+            if( length < maxLength - 1 )
+                out_text[length++] = '%';
+            continue;
+        }
+
+        char spec[MAX_SPEC_LEN];
+        int specLength = (int) ( cursor - percent );
+        if( !conversion.m_isSupported || specLength >= MAX_SPEC_LEN )
+            break;
+        memcpy( spec, percent, specLength );
+        spec[specLength] = 0;
+
+        int stars[2] = { 0, 0 };
+        for( int starIdx = 0; starIdx < conversion.m_starCount; ++starIdx )
+            argsValid = argsValid && ReadValue( stars[starIdx], args, argBytes, argOffset );
+
+        switch( conversion.m_type )
+        {
+        case ArgType::INT32:
+        {
+            int value = 0;
+            argsValid = argsValid && ReadValue( value, args, argBytes, argOffset );
+            AppendConversion( out_text, maxLength, length, spec, stars, conversion.m_starCount, value );
+            break;
+        }
+        case ArgType::INT64:
+        {
+            long long value = 0;
+            argsValid = argsValid && ReadValue( value, args, argBytes, argOffset );
+            AppendConversion( out_text, maxLength, length, spec, stars, conversion.m_starCount, value );
+            break;
+        }
+        case ArgType::DOUBLE:
+        {
+            double value = 0;
+            argsValid = argsValid && ReadValue( value, args, argBytes, argOffset );
+            AppendConversion( out_text, maxLength, length, spec, stars, conversion.m_starCount, value );
+            break;
+        }
+        case ArgType::POINTER:
+        {
+            uint64 value = 0;
+            argsValid = argsValid && ReadValue( value, args, argBytes, argOffset );
+            AppendConversion( out_text, maxLength, length, spec, stars, conversion.m_starCount,
+                              (void*) (uintptr_t) value );
+            break;
+        }
+        case ArgType::STRING:
+        {
+            uint stringLength = 0;
+            argsValid = argsValid && ReadValue( stringLength, args, argBytes, argOffset )
+                && argOffset + (int) stringLength <= argBytes;
+            if( !argsValid )
+                break;
+            char str[MAX_STRING_ARG_LEN];
+            uint copyLen = stringLength < MAX_STRING_ARG_LEN ? stringLength : MAX_STRING_ARG_LEN - 1;
+            memcpy( str, args + argOffset, copyLen );
+            str[copyLen] = 0;
+            argOffset += stringLength;
+            AppendConversion( out_text, maxLength, length, spec, stars, conversion.m_starCount,
+                              (const char*) str );
+            break;
+        }
+        }
+    }
+
+    out_text[length] = 0;
+    return length;
+}
+
+bool DecodeBinaryLog( FILE* binaryLog, FILE* textOut )
+{
+    BinaryLogHeader header;
+    if( fread( &header, sizeof( header ), 1, binaryLog ) != 1
+        || memcmp( header.m_magic, BINARY_LOG_MAGIC, sizeof( BINARY_LOG_MAGIC ) ) != 0
+        || header.m_version != BINARY_LOG_VERSION )
+    {
+        return false;
+    }
+
+    std::vector<String> tags;
+    std::vector<String> formats;
+    std::vector<Byte> payload;
+    char text[4096];
+
+    RecordType recordType;
+    while( fread( &recordType, sizeof( recordType ), 1, binaryLog ) == 1 )
+    {
+        if( recordType == RecordType::TAG || recordType == RecordType::FORMAT )
+        {
+            uint id = 0;
+            std::vector<String>& table = ( recordType == RecordType::TAG ) ? tags : formats;
+            if( fread( &id, sizeof( id ), 1, binaryLog ) != 1 )
+                return false;
+            if( id >= table.size() )
+                table.resize( id + 1 );
+            if( !ReadRecordString( binaryLog, table[id] ) )
+                return false;
+        }
+        else if( recordType == RecordType::ENTRY )
+        {
+            uint64 ticks = 0;
+            uint ids[4]; // threadId, tagId, formatId, size
+            if( fread( &ticks, sizeof( ticks ), 1, binaryLog ) != 1
+                || fread( ids, sizeof( uint ), 4, binaryLog ) != 4 )
+            {
+                return false;
+            }
+            uint threadId = ids[0];
+            uint tagId = ids[1];
+            uint formatId = ids[2];
+            uint size = ids[3];
+
+            payload.resize( size + 1 );
+            if( size > 0 && fread( payload.data(), 1, size, binaryLog ) != size )
+                return false;
+
+            if( formatId == INVALID_FORMAT_ID )
+            {
+                payload[size] = 0;
+                snprintf( text, sizeof( text ), "%s", payload.data() );
+            }
+            else if( formatId < formats.size() )
+            {
+                FormatPackedArgs( formats[formatId].c_str(), payload.data(), size,
+                                  text, sizeof( text ) );
+            }
+            else
+            {
+                snprintf( text, sizeof( text ), "<unknown format %u>", formatId );
+            }
+
+            // signed, entries queued before the writer stamped the start come out negative
+            int64 elapsedTicks = (int64) ticks - (int64) header.m_startTicks;
+            double seconds = (double) elapsedTicks * header.m_secondsPerTick;
+            const char* tag = tagId < tags.size() ? tags[tagId].c_str() : "Untagged";
+            fprintf( textOut, "[%12.6f] [%u] %s: %s\n", seconds, threadId, tag, text );
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
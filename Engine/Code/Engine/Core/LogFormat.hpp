@@ -0,0 +1,62 @@
+#pragma once
+#include "Engine/Core/Types.hpp"
+#include <stdarg.h>
+#include <stdio.h>
+
+// Deferred printf formatting and the binary log file layout
+// Only depends on the standard library so the offline decoder can build it alone
+namespace LogFormat
+{
+enum class ArgType : uchar
+{
+    INT32,
+    INT64,
+    DOUBLE,
+    POINTER,
+    STRING  // uint length followed by the characters, no terminator
+};
+
+typedef std::vector<ArgType> ArgTypes;
+
+constexpr uint INVALID_FORMAT_ID = 0xffffffff;
+
+//--------------------------------------------------------------------------------------
+// Binary log file
+// Header, then a stream of records that each start with a RecordType byte
+// Tags and formats are written once, before the first entry that uses them
+
+constexpr char BINARY_LOG_MAGIC[4] = { 'B', 'L', 'O', 'G' };
+constexpr uint BINARY_LOG_VERSION = 1;
+
+struct BinaryLogHeader
+{
+    char m_magic[4];
+    uint m_version;
+    double m_secondsPerTick;
+    uint64 m_startTicks;
+};
+
+enum class RecordType : uchar
+{
+    TAG = 1,        // uint id, uint length, characters
+    FORMAT = 2,     // uint id, uint length, characters
+    ENTRY = 3       // uint64 ticks, uint threadId, uint tagId, uint formatId, uint size, payload
+};
+// Entries with INVALID_FORMAT_ID carry already formatted text as their payload
+
+//--------------------------------------------------------------------------------------
+// Returns false if the format uses something that can't be stored, like %n or wide strings
+bool ParseFormat( const char* format, ArgTypes& out_argTypes );
+
+// Copies the arguments into out_bytes, returns the size or -1 if they don't fit
+int PackArgs( const ArgTypes& argTypes, va_list args, Byte* out_bytes, int maxBytes );
+
+// printf the format with previously packed arguments, output is always null terminated
+// returns the length written, truncated to maxLength - 1
+int FormatPackedArgs( const char* format, const Byte* args, int argBytes,
+                      char* out_text, int maxLength );
+
+// Turns a binary log back into one text line per entry, returns false on a bad file
+bool DecodeBinaryLog( FILE* binaryLog, FILE* textOut );
+
+}
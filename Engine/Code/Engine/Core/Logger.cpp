@@ -1,7 +1,190 @@
 #include "Engine/Core/Logger.hpp"
 #include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Profiler.hpp"
+#include "Engine/Core/LogFormat.hpp"
+#include "Engine/Core/BinaryLogWriter.hpp"
+#include "Engine/Time/Time.hpp"
 
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include <unordered_map>
+#include <exception>
+#include <signal.h>
 #include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+//--------------------------------------------------------------------------------------
+// internal
+
+// The entries of one logging thread, used in order so a thread
+// stops allocating once its ring exists
+struct LogEntryRing
+{
+    LogEntry m_entries[Logger::LOG_RING_SIZE];
+    uint m_nextIdx = 0;
+    uint m_threadId = 0;
+    std::atomic<bool> m_isRetired = false;
+};
+
+// marks the ring as reusable when its thread exits
+struct LogEntryRingOwner
+{
+    ~LogEntryRingOwner();
+    LogEntryRing* m_ring = nullptr;
+};
+
+// A format string seen by the logger and the arguments it takes
+struct LogFormatInfo
+{
+    String m_format;
+    LogFormat::ArgTypes m_argTypes;
+    uint m_id = LogFormat::INVALID_FORMAT_ID;   // invalid if it can't be deferred
+};
+
+LogEntryRing* GetThreadRing();
+const LogFormatInfo* FindOrAddFormat( char const *format );
+uint HashFormat( char const *format );
+
+// rings are never freed since the worker may still be reading entries,
+// a retired ring can be handed out right away because every entry
+// is only reused once the worker releases it
+std::mutex g_ringsLock;
+std::vector<LogEntryRing*> g_rings;
+thread_local LogEntryRingOwner t_ringOwner;
+
+// tag 0 is used when the table is full
+std::mutex g_tagLock;
+const char* g_tagNames[Logger::MAX_LOG_TAGS] = { "Untagged" };
+std::atomic<int> g_tagCount = 1;
+
+// infos are never freed, the hash map has an entry for every format looked up
+// so formats that can't be deferred are only parsed once
+std::shared_mutex g_formatLock;
+std::vector<LogFormatInfo*> g_formats;
+std::unordered_multimap<uint, LogFormatInfo*> g_formatsByHash;
+
+// handlers that were installed before ours, called after flushing
+LPTOP_LEVEL_EXCEPTION_FILTER g_prevExceptionFilter = nullptr;
+std::terminate_handler g_prevTerminateHandler = nullptr;
+
+// worker side cache for GetEntryText
+thread_local const LogEntry* t_formattedEntry = nullptr;
+thread_local char t_formattedText[Logger::MAX_FORMATTED_LEN];
+thread_local uint t_formattedLength = 0;
+
+LogEntryRingOwner::~LogEntryRingOwner()
+{
+    if( m_ring )
+        m_ring->m_isRetired.store( true, std::memory_order_release );
+}
+
+LogEntryRing* GetThreadRing()
+{
+    LogEntryRing* ring = t_ringOwner.m_ring;
+    if( ring )
+        return ring;
+
+    std::lock_guard<std::mutex> lock( g_ringsLock );
+    for( LogEntryRing* candidate : g_rings )
+    {
+        if( candidate->m_isRetired.load( std::memory_order_acquire ) )
+        {
+            ring = candidate;
+            break;
+        }
+    }
+
+    if( nullptr == ring )
+    {
+        ring = new LogEntryRing();
+        ring->m_threadId = (uint) g_rings.size();
+        g_rings.push_back( ring );
+    }
+
+    ring->m_isRetired.store( false );
+    t_ringOwner.m_ring = ring;
+    return ring;
+}
+
+LONG WINAPI OnUnhandledException( EXCEPTION_POINTERS* exceptionInfo )
+{
+    Logger::GetDefault()->FlushForCrash();
+    if( g_prevExceptionFilter )
+        return g_prevExceptionFilter( exceptionInfo );
+    return EXCEPTION_CONTINUE_SEARCH;
+}
+
+void OnTerminate()
+{
+    Logger::GetDefault()->FlushForCrash();
+    if( g_prevTerminateHandler )
+        g_prevTerminateHandler();
+    abort();
+}
+
+// not async signal safe, but the process is going down either way
+void OnAbortSignal( int signal )
+{
+    Logger::GetDefault()->FlushForCrash();
+    ::signal( signal, SIG_DFL );
+    raise( signal );
+}
+
+uint HashFormat( char const *format )
+{
+    uint hash = 2166136261u;
+    for( ; *format; ++format )
+    {
+        hash ^= (unsigned char) *format;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+const LogFormatInfo* FindOrAddFormat( char const *format )
+{
+    uint hash = HashFormat( format );
+    {
+        std::shared_lock<std::shared_mutex> lock( g_formatLock );
+        auto range = g_formatsByHash.equal_range( hash );
+        for( auto it = range.first; it != range.second; ++it )
+        {
+            if( it->second->m_format == format )
+                return it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock( g_formatLock );
+    auto range = g_formatsByHash.equal_range( hash );
+    for( auto it = range.first; it != range.second; ++it )
+    {
+        if( it->second->m_format == format )
+            return it->second;
+    }
+
+    if( g_formatsByHash.size() >= Logger::MAX_LOG_FORMATS * 2 )
+    {
+        // too many distinct formats, likely dynamic strings, stop remembering them
+        static LogFormatInfo s_eagerFormat;
+        return &s_eagerFormat;
+    }
+
+    LogFormatInfo* info = new LogFormatInfo();
+    info->m_format = format;
+    bool canDefer = LogFormat::ParseFormat( format, info->m_argTypes );
+    if( canDefer && (int) g_formats.size() < Logger::MAX_LOG_FORMATS )
+    {
+        info->m_id = (uint) g_formats.size();
+        g_formats.push_back( info );
+    }
+    g_formatsByHash.emplace( hash, info );
+    return info;
+}
+
+//--------------------------------------------------------------------------------------
+// Logger
 
 
 Logger* Logger::GetDefault()
@@ -14,56 +197,171 @@ Logger* Logger::GetDefault()
 
 void Logger::LoggerThreadWorker( Logger* logger )
 {
+    Thread::ThreadSetName( "Logger" );
+    Profiler::SetThreadName( "Logger" );
+    if( logger->m_coreAffinity != 0 )
+        Thread::ThreadSetCoreAffinity( logger->m_coreAffinity );
+
+    logger->m_lastFlushTime = TimeUtils::GetCurrentTimeSeconds();
     while( logger->IsRunning() )
     {
-        logger->LogToHooks();
-        Thread::SleepMS( 10 );
+        int loggedCount = logger->LogToHooks();
+
+        double currentTime = TimeUtils::GetCurrentTimeSeconds();
+        if( logger->m_isCrashFlushRequested )
+        {
+            // the crashing thread may have logged right before asking
+            logger->LogToHooks();
+            logger->FlushHooks();
+            logger->m_isCrashFlushRequested = false;
+            logger->m_isCrashFlushDone = true;
+        }
+        else if( currentTime - logger->m_lastFlushTime >= FLUSH_INTERVAL_SECONDS )
+        {
+            logger->FlushHooks();
+            logger->m_lastFlushTime = currentTime;
+        }
+
+        if( loggedCount == 0 )
+            logger->WaitForEntries();
     }
 
     // do the inner side of the loop again right before exiting
     logger->LogToHooks();
     logger->FlushHooks();
+    logger->m_isWorkerAlive = false;
 }
 
-void Logger::WriteToFile( LogEntry* entry, void* logFile )
+void Logger::WriteToFile( LogEntry* entry, void* logFileWriter )
 {
-    std::ofstream* file = ( std::ofstream* ) logFile;
-    (*file) << entry->m_tag << ": " << entry->m_text << '\n';
+    uint length = 0;
+    const char* text = GetEntryText( entry, &length );
+    ( (LogFileWriter*) logFileWriter )->WriteLine( GetTagName( entry->m_tagId ), text, length );
+}
 
+void Logger::FlushFile( void* logFileWriter )
+{
+    ( (LogFileWriter*) logFileWriter )->Flush();
 }
 
-void Logger::FlushFile( void* logFile )
+void Logger::WriteToBinaryFile( LogEntry* entry, void* binaryLogWriter )
 {
-    std::ofstream* file = ( std::ofstream* ) logFile;
-    file->flush();
+    ( (BinaryLogWriter*) binaryLogWriter )->WriteEntry( entry );
 }
 
-void Logger::StartUp()
+void Logger::FlushBinaryFile( void* binaryLogWriter )
 {
+    ( (BinaryLogWriter*) binaryLogWriter )->Flush();
+}
+
+void Logger::StartUp( uint64 coreAffinity )
+{
+    m_coreAffinity = coreAffinity;
     m_isRunning = true;
+    m_isWorkerAlive = true;
     m_thread = Thread::Create( Logger::LoggerThreadWorker, this );
+    if( this == GetDefault() )
+        InstallCrashHandlers();
 }
 
 void Logger::ShutDown()
 {
     m_isRunning = false;
+    {
+        std::lock_guard<std::mutex> lock( m_wakeLock );
+        m_wakeCondition.notify_all();
+    }
     Thread::Join( m_thread );
     m_thread = nullptr;
 }
 
-void Logger::LogToHooks()
+int Logger::LogToHooks()
 {
-    LogEntry *log;
-    while( m_logQueue.Pop( &log ) )
+    PROFILER_SCOPED();
+    LogEntry* batch[LOG_BATCH_SIZE];
+    int totalCount = 0;
+    int batchCount = 0;
+    while( ( batchCount = m_logQueue.PopBatch( batch, LOG_BATCH_SIZE ) ) > 0 )
     {
         m_logHookLock.lock_shared();
-        for( auto& hook : m_logHooks )
+        for( int entryIdx = 0; entryIdx < batchCount; ++entryIdx )
         {
-            hook.m_callback( log, hook.m_userArg );
+            t_formattedEntry = nullptr;
+            for( auto& hook : m_logHooks )
+            {
+                hook.m_callback( batch[entryIdx], hook.m_userArg );
+            }
         }
         m_logHookLock.unlock_shared();
-        delete log;
+
+        for( int entryIdx = 0; entryIdx < batchCount; ++entryIdx )
+        {
+            batch[entryIdx]->m_inUse.store( false, std::memory_order_release );
+        }
+        totalCount += batchCount;
     }
+    return totalCount;
+}
+
+void Logger::WaitForEntries()
+{
+    std::unique_lock<std::mutex> lock( m_wakeLock );
+    m_isWorkerWaiting = true;
+    // pairs with the fence in LogTaggedPrintfv, either the producer sees
+    // the waiting flag or we see its entry
+    std::atomic_thread_fence( std::memory_order_seq_cst );
+    if( m_logQueue.IsEmpty() && IsRunning() && !m_isCrashFlushRequested )
+        m_wakeCondition.wait_for( lock, std::chrono::milliseconds( MAX_WAIT_MS ) );
+    m_isWorkerWaiting = false;
+}
+
+void Logger::FlushForCrash()
+{
+    // the first crashing thread does the flush, the rest return right away
+    if( m_isCrashFlushing.exchange( true ) )
+        return;
+
+    bool isWorkerThread = m_thread && m_thread->get_id() == std::this_thread::get_id();
+    if( m_isWorkerAlive && !isWorkerThread )
+    {
+        // the worker is the queue's only consumer, so ask it
+        m_isCrashFlushRequested = true;
+        {
+            std::lock_guard<std::mutex> lock( m_wakeLock );
+            m_wakeCondition.notify_all();
+        }
+        for( int waitedMS = 0; waitedMS < CRASH_FLUSH_TIMEOUT_MS; ++waitedMS )
+        {
+            if( m_isCrashFlushDone )
+                return;
+            if( !m_isWorkerAlive )
+                break;
+            Thread::SleepMS( 1 );
+        }
+
+        // still alive, maybe in a slow write, a second consumer would corrupt the queue
+        if( m_isWorkerAlive )
+            return;
+    }
+
+    // the worker has exited or is the one crashing, take over its side of the queue
+    LogToHooks();
+    FlushHooks();
+}
+
+void Logger::InstallCrashHandlers()
+{
+    g_prevExceptionFilter = SetUnhandledExceptionFilter( OnUnhandledException );
+    g_prevTerminateHandler = std::set_terminate( OnTerminate );
+    signal( SIGABRT, OnAbortSignal );
+}
+
+void Logger::WakeWorker()
+{
+    if( !m_isWorkerWaiting )
+        return;
+    std::lock_guard<std::mutex> lock( m_wakeLock );
+    m_wakeCondition.notify_one();
 }
 
 void Logger::FlushHooks()
@@ -76,13 +374,143 @@ void Logger::FlushHooks()
     m_flushHookLock.unlock_shared();
 }
 
+uint Logger::RegisterTag( char const *tag )
+{
+    // tags are few, so a lock free scan covers every call after the first
+    int count = g_tagCount.load( std::memory_order_acquire );
+    for( int tagIdx = 0; tagIdx < count; ++tagIdx )
+    {
+        if( strcmp( g_tagNames[tagIdx], tag ) == 0 )
+            return tagIdx;
+    }
+
+    std::lock_guard<std::mutex> lock( g_tagLock );
+    count = g_tagCount.load();
+    for( int tagIdx = 0; tagIdx < count; ++tagIdx )
+    {
+        if( strcmp( g_tagNames[tagIdx], tag ) == 0 )
+            return tagIdx;
+    }
+    if( count == MAX_LOG_TAGS )
+        return 0;
+
+    size_t length = strlen( tag );
+    char* name = new char[length + 1];
+    memcpy( name, tag, length + 1 );
+    g_tagNames[count] = name;
+    g_tagCount.store( count + 1, std::memory_order_release );
+    return count;
+}
+
+const char* Logger::GetTagName( uint tagId )
+{
+    if( tagId >= (uint) g_tagCount.load( std::memory_order_acquire ) )
+        return g_tagNames[0];
+    return g_tagNames[tagId];
+}
+
+uint Logger::RegisterFormat( char const *format )
+{
+    return FindOrAddFormat( format )->m_id;
+}
+
+const char* Logger::GetFormat( uint formatId )
+{
+    std::shared_lock<std::shared_mutex> lock( g_formatLock );
+    if( formatId >= g_formats.size() )
+        return "";
+    return g_formats[formatId]->m_format.c_str();
+}
+
+const char* Logger::GetEntryText( const LogEntry* entry, uint* out_length )
+{
+    if( entry->m_formatId == LogFormat::INVALID_FORMAT_ID )
+    {
+        if( out_length )
+            *out_length = entry->m_payloadSize;
+        return entry->m_payload;
+    }
+
+    if( t_formattedEntry != entry )
+    {
+        t_formattedLength = LogFormat::FormatPackedArgs(
+            GetFormat( entry->m_formatId ), entry->m_payload, entry->m_payloadSize,
+            t_formattedText, MAX_FORMATTED_LEN );
+        t_formattedEntry = entry;
+    }
+    if( out_length )
+        *out_length = t_formattedLength;
+    return t_formattedText;
+}
+
+LogEntry* Logger::AcquireEntry()
+{
+    LogEntryRing* ring = GetThreadRing();
+    LogEntry* entry = &ring->m_entries[ring->m_nextIdx];
+    while( entry->m_inUse.load( std::memory_order_acquire ) )
+    {
+        // the worker is a whole ring behind this thread, nothing will
+        // free the entry if the worker is not running
+        if( !IsRunning() )
+            return nullptr;
+        WakeWorker();
+        Thread::ThreadYield();
+    }
+
+    ring->m_nextIdx = ( ring->m_nextIdx + 1 ) % LOG_RING_SIZE;
+    entry->m_inUse.store( true, std::memory_order_relaxed );
+    entry->m_threadId = ring->m_threadId;
+    return entry;
+}
+
 void Logger::LogTaggedPrintfv( char const *tag, char const *format, va_list args )
 {
-    LogEntry* log = new LogEntry();
-    log->m_tag = tag;
-    log->m_text = Stringf( format, args );
+    LogEntry* log = AcquireEntry();
+    if( nullptr == log )
+        return;
+
+    log->m_ticks = TimeUtils::GetCurrentTimeTicks();
+    log->m_tagId = RegisterTag( tag );
 
-    m_logQueue.Push( log );
+    // keep only the arguments, the worker or the decoder formats them later
+    int payloadSize = -1;
+    const LogFormatInfo* formatInfo = FindOrAddFormat( format );
+    if( formatInfo->m_id != LogFormat::INVALID_FORMAT_ID )
+    {
+        va_list argsCopy;
+        va_copy( argsCopy, args );
+        payloadSize = LogFormat::PackArgs( formatInfo->m_argTypes, argsCopy,
+                                           log->m_payload, LogEntry::MAX_PAYLOAD_SIZE );
+        va_end( argsCopy );
+    }
+
+    if( payloadSize >= 0 )
+    {
+        log->m_formatId = formatInfo->m_id;
+        log->m_payloadSize = payloadSize;
+    }
+    else
+    {
+        int length = vsnprintf( log->m_payload, LogEntry::MAX_PAYLOAD_SIZE, format, args );
+        if( length < 0 )
+            length = 0;
+        log->m_formatId = LogFormat::INVALID_FORMAT_ID;
+        log->m_payloadSize = length < LogEntry::MAX_PAYLOAD_SIZE ? length : LogEntry::MAX_PAYLOAD_SIZE - 1;
+    }
+
+    while( !m_logQueue.Push( log ) )
+    {
+        if( !IsRunning() )
+        {
+            log->m_inUse.store( false, std::memory_order_release );
+            return;
+        }
+        // queue is full, make sure the worker is draining and back off
+        WakeWorker();
+        Thread::ThreadYield();
+    }
+    std::atomic_thread_fence( std::memory_order_seq_cst );
+    WakeWorker();
 }
 
 void Logger::LogTaggedPrintf( char const *tag, char const *format, ... )
@@ -107,22 +535,28 @@ void Logger::AddFlushHook( FlushCB cb, void *userArg )
     m_flushHookLock.unlock();
 }
 
-void Logger::AddFileHook( const String& filePath )
+void Logger::AddFileHook( const String& filePath, const LogRotationSettings& rotation )
 {
-
-    // file
-    std::ofstream* file = new std::ofstream();
-    file->open( filePath );
-    if( file->fail() )
+    LogFileWriter* writer = new LogFileWriter( filePath, rotation );
+    if( !writer->Open() )
     {
-        delete file;
-        file = nullptr;
+        delete writer;
+        return;
     }
-    else
+    AddLogHook( WriteToFile, (void*) writer );
+    AddFlushHook( FlushFile, (void*) writer );
+}
+
+void Logger::AddBinaryFileHook( const String& filePath )
+{
+    BinaryLogWriter* writer = new BinaryLogWriter();
+    if( !writer->Open( filePath ) )
     {
-        AddLogHook( WriteToFile, (void*) file );
-        AddFlushHook( FlushFile, (void*) file );
+        delete writer;
+        return;
     }
+    AddLogHook( WriteToBinaryFile, (void*) writer );
+    AddFlushHook( FlushBinaryFile, (void*) writer );
 }
 
 void Logger::LogPrintf( char const *format, ... )
@@ -1,8 +1,12 @@
 #pragma once
 #include "Engine/Core/Thread.hpp"
-#include "Engine/Core/ThreadSafeQueue.hpp"
+#include "Engine/Core/MPSCQueue.hpp"
 #include "Engine/Core/LogEntry.hpp"
+#include "Engine/Core/LogFileWriter.hpp"
 #include <shared_mutex>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 #include <functional>
 #include <iostream>
 #include <fstream>
@@ -35,30 +39,93 @@ public:
 class Logger
 {
 public:
+    // Must be a power of 2, producers block (yield) while the queue is full
+    static constexpr int LOG_QUEUE_SIZE = 4096;
+    // How many entries are handed to the hooks per hook lock
+    static constexpr int LOG_BATCH_SIZE = 256;
+    // Upper bound on how long the worker sleeps when it is not woken
+    static constexpr int MAX_WAIT_MS = 100;
+    // Entries each logging thread can have in flight before it waits on the worker
+    static constexpr int LOG_RING_SIZE = 128;
+    static constexpr int MAX_LOG_TAGS = 256;
+    // Formats past this are formatted right away instead of deferred
+    static constexpr int MAX_LOG_FORMATS = 4096;
+    // Longest line a hook can get from GetEntryText
+    static constexpr int MAX_FORMATTED_LEN = 2048;
+    // Hooks are flushed at least this often while entries keep coming in
+    static constexpr double FLUSH_INTERVAL_SECONDS = 1.0;
+    // How long a crashing thread waits for the worker to flush, it only drains the queue
+    // itself once the worker has exited
+    static constexpr int CRASH_FLUSH_TIMEOUT_MS = 500;
+
 	Logger(){};
 	~Logger(){};
     static Logger* GetDefault();
     static void LoggerThreadWorker( Logger* logger );
-    static void WriteToFile( LogEntry* entry, void* logFile );
-    static void FlushFile( void* logFile );
+    static void WriteToFile( LogEntry* entry, void* logFileWriter );
+    static void FlushFile( void* logFileWriter );
+    static void WriteToBinaryFile( LogEntry* entry, void* binaryLogWriter );
+    static void FlushBinaryFile( void* binaryLogWriter );
+
+    // Tags are stored as ids in the entries, names are kept for the lifetime of the app
+    static uint RegisterTag( char const *tag );
+    static const char* GetTagName( uint tagId );
+
+    // Formats are stored once and entries only keep their arguments, returns
+    // LogFormat::INVALID_FORMAT_ID if the format can't be deferred
+    static uint RegisterFormat( char const *format );
+    static const char* GetFormat( uint formatId );
+
+    // For hooks, formats deferred entries on first use, the text stays valid
+    // until the next entry is handed to the hooks
+    static const char* GetEntryText( const LogEntry* entry, uint* out_length = nullptr );
 
-    void StartUp();
+    // coreAffinity pins the worker thread, see Thread::ThreadSetCoreAffinity
+    void StartUp( uint64 coreAffinity = 0 );
     void ShutDown();
     bool IsRunning() { return m_isRunning; };
-    void LogToHooks();
+    // Drains the queue in batches, returns the number of entries logged
+    int LogToHooks();
     void FlushHooks();
+    // Gets everything logged so far to the hooks and flushes them, for crash handlers
+    // and fatal errors, the process is expected to end afterwards
+    void FlushForCrash();
     void LogTaggedPrintfv( char const *tag, char const *format, va_list args );
     void LogTaggedPrintf( char const *tag, char const *format, ... );
     void AddLogHook( LogCB cb, void *userArg );
     void AddFlushHook( FlushCB cb, void *userArg );
-    void AddFileHook( const String& filePath );
+    void AddFileHook( const String& filePath,
+                      const LogRotationSettings& rotation = LogRotationSettings() );
+    // Writes entries without formatting them, see BinaryLogWriter
+    void AddBinaryFileHook( const String& filePath );
 
     void LogPrintf( char const *format, ... );
     void DebuggerPrintf( char const *format, ... );
 private:
-    bool m_isRunning = false;
+    // Worker side, sleeps until a producer wakes it or MAX_WAIT_MS passes
+    void WaitForEntries();
+    // Producer side, only touches the lock when the worker is actually asleep
+    void WakeWorker();
+    // Next entry of the calling thread's ring, nullptr if the entry has to be dropped
+    LogEntry* AcquireEntry();
+    // Flushes the default logger on unhandled exceptions, terminate and abort
+    static void InstallCrashHandlers();
+
+    std::atomic<bool> m_isRunning { false };
+    // set from StartUp until the worker's last drain is done, while set it is the queue's consumer
+    std::atomic<bool> m_isWorkerAlive { false };
     Thread::Handle m_thread = nullptr;
-    ThreadSafeQueue<LogEntry*> m_logQueue;
+    uint64 m_coreAffinity = 0;
+    MPSCQueue<LogEntry*> m_logQueue { LOG_QUEUE_SIZE };
+
+    std::mutex m_wakeLock;
+    std::condition_variable m_wakeCondition;
+    std::atomic<bool> m_isWorkerWaiting { false };
+
+    double m_lastFlushTime = 0.0;
+    std::atomic<bool> m_isCrashFlushing { false };
+    std::atomic<bool> m_isCrashFlushRequested { false };
+    std::atomic<bool> m_isCrashFlushDone { false };
 
     std::shared_mutex m_logHookLock;
     std::vector<LogHook> m_logHooks;
@@ -0,0 +1,106 @@
+#pragma once
+#include <atomic>
+#include <vector>
+#include "Engine/Core/ErrorUtils.hpp"
+
+// Bounded lock free queue for many producer threads and one consumer thread
+// Each cell carries a sequence number that tells producers and the consumer
+// whose turn it is, so no locks are needed and pushes never allocate
+// Capacity must be a power of 2
+template <typename T>
+class MPSCQueue
+{
+public:
+    explicit MPSCQueue( size_t capacity )
+        : m_cells( capacity )
+        , m_mask( capacity - 1 )
+    {
+        GUARANTEE_OR_DIE( capacity >= 2 && ( capacity & ( capacity - 1 ) ) == 0,
+                          "MPSCQueue capacity must be a power of 2" );
+        for( size_t cellIdx = 0; cellIdx < capacity; ++cellIdx )
+        {
+            m_cells[cellIdx].m_sequence.store( cellIdx, std::memory_order_relaxed );
+        }
+    }
+
+    // Any thread, returns false if the queue is full
+    bool Push( T const &v )
+    {
+        size_t pos = m_enqueuePos.load( std::memory_order_relaxed );
+        Cell* cell = nullptr;
+        for( ;; )
+        {
+            cell = &m_cells[pos & m_mask];
+            size_t sequence = cell->m_sequence.load( std::memory_order_acquire );
+            intptr_t diff = (intptr_t) sequence - (intptr_t) pos;
+            if( diff == 0 )
+            {
+                // the cell is free, claim it
+                if( m_enqueuePos.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+                    break;
+            }
+            else if( diff < 0 )
+            {
+                // the consumer has not freed this cell from the last lap yet
+                return false;
+            }
+            else
+            {
+                // another producer claimed it first
+                pos = m_enqueuePos.load( std::memory_order_relaxed );
+            }
+        }
+
+        cell->m_data = v;
+        cell->m_sequence.store( pos + 1, std::memory_order_release );
+        return true;
+    }
+
+    // Consumer thread only, return if it succeeds
+    bool Pop( T *out_v )
+    {
+        Cell& cell = m_cells[m_dequeuePos & m_mask];
+        size_t sequence = cell.m_sequence.load( std::memory_order_acquire );
+        if( sequence != m_dequeuePos + 1 )
+            return false;
+
+        *out_v = cell.m_data;
+        cell.m_sequence.store( m_dequeuePos + m_mask + 1, std::memory_order_release );
+        ++m_dequeuePos;
+        return true;
+    }
+
+    // Consumer thread only, pops up to maxCount items in order and returns how many
+    int PopBatch( T *out_values, int maxCount )
+    {
+        int count = 0;
+        while( count < maxCount && Pop( &out_values[count] ) )
+        {
+            ++count;
+        }
+        return count;
+    }
+
+    // Consumer thread only
+    bool IsEmpty() const
+    {
+        const Cell& cell = m_cells[m_dequeuePos & m_mask];
+        return cell.m_sequence.load( std::memory_order_acquire ) != m_dequeuePos + 1;
+    }
+
+    size_t GetCapacity() const { return m_mask + 1; }
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> m_sequence;
+        T m_data;
+    };
+
+    std::vector<Cell> m_cells;
+    size_t m_mask;
+
+    // kept on separate cache lines so producers and the consumer don't contend
+    alignas( 64 ) std::atomic<size_t> m_enqueuePos { 0 };
+    alignas( 64 ) size_t m_dequeuePos = 0;
+};
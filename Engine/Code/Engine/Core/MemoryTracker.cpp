@@ -0,0 +1,71 @@
+#include "Engine/Core/MemoryTracker.hpp"
+
+#if defined( PROFILE_ALLOCATIONS )
+
+#include <new>
+#include <stdlib.h>
+
+namespace MemoryTracker
+{
+thread_local AllocationCounters t_threadAllocations;
+}
+
+// Replaces the global allocation functions for the whole app
+// Over-aligned allocations keep the default implementation and are not counted
+
+void* operator new( size_t size )
+{
+    MemoryTracker::RecordAllocation( size );
+    void* ptr = malloc( size == 0 ? 1 : size );
+    if( nullptr == ptr )
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[]( size_t size )
+{
+    return operator new( size );
+}
+
+void* operator new( size_t size, const std::nothrow_t& ) noexcept
+{
+    MemoryTracker::RecordAllocation( size );
+    return malloc( size == 0 ? 1 : size );
+}
+
+void* operator new[]( size_t size, const std::nothrow_t& tag ) noexcept
+{
+    return operator new( size, tag );
+}
+
+void operator delete( void* ptr ) noexcept
+{
+    free( ptr );
+}
+
+void operator delete[]( void* ptr ) noexcept
+{
+    free( ptr );
+}
+
+void operator delete( void* ptr, size_t ) noexcept
+{
+    free( ptr );
+}
+
+void operator delete[]( void* ptr, size_t ) noexcept
+{
+    free( ptr );
+}
+
+void operator delete( void* ptr, const std::nothrow_t& ) noexcept
+{
+    free( ptr );
+}
+
+void operator delete[]( void* ptr, const std::nothrow_t& ) noexcept
+{
+    free( ptr );
+}
+
+#endif // PROFILE_ALLOCATIONS
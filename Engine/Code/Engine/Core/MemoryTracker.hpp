@@ -0,0 +1,51 @@
+#pragma once
+#include "Engine/Core/Types.hpp"
+#include "Game/EngineBuildPreferences.hpp"
+
+// Counts heap allocations made through global operator new per thread
+// Opt in with PROFILE_ALLOCATIONS in EngineBuildPreferences.hpp, the profiler then
+// attributes allocations to the scope they happened in
+namespace MemoryTracker
+{
+
+struct AllocationCounters
+{
+    uint64 m_count = 0;
+    uint64 m_bytes = 0;
+};
+
+inline AllocationCounters operator-( const AllocationCounters& lhs, const AllocationCounters& rhs )
+{
+    AllocationCounters result;
+    result.m_count = lhs.m_count - rhs.m_count;
+    result.m_bytes = lhs.m_bytes - rhs.m_bytes;
+    return result;
+}
+
+#if defined( PROFILE_ALLOCATIONS )
+
+// plain thread locals so counting an allocation never takes a lock
+extern thread_local AllocationCounters t_threadAllocations;
+
+constexpr bool IS_ENABLED = true;
+
+// Running totals of the calling thread since it started
+inline AllocationCounters GetThreadCounters() { return t_threadAllocations; }
+
+inline void RecordAllocation( size_t bytes )
+{
+    ++t_threadAllocations.m_count;
+    t_threadAllocations.m_bytes += bytes;
+}
+
+#else
+
+constexpr bool IS_ENABLED = false;
+
+inline AllocationCounters GetThreadCounters() { return AllocationCounters(); }
+
+inline void RecordAllocation( size_t bytes ) { (void) ( bytes ); }
+
+#endif // PROFILE_ALLOCATIONS
+
+}
@@ -7,16 +7,24 @@
 #include "Engine/Core/Profiler.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/ErrorUtils.hpp"
+#include "Engine/Core/StringUtils.hpp"
 #include "Engine/Time/Time.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 #include "Engine/Core/Window.hpp"
 #include "Engine/Core/SmartEnum.hpp"
 #include "Engine/Core/ProfilerReport.hpp"
 #include "Engine/Core/ProfilerReportEntry.hpp"
+#include "Engine/Core/ProfilerTraceWriter.hpp"
+#include "Engine/Core/ProfilerStats.hpp"
 #include "Engine/Math/MathUtils.hpp"
 
 
 #include <deque>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <stdio.h>
+#include <string.h>
 
 namespace Profiler
 {
@@ -30,7 +38,8 @@ SMART_ENUM(
     DisplayHierarchy,
 
     FLAT,
-    TREE
+    TREE,
+    STATS
 )
 
 SMART_ENUM(
@@ -40,9 +49,77 @@ SMART_ENUM(
     TOTAL
 )
 
-Measurement* CreateMeasurement( const char* id );
+// One push or pop, pops have an invalid id
+struct Event
+{
+    ScopeId m_scopeId;
+    uint64 m_ticks;
+#if defined( PROFILE_ALLOCATIONS )
+    // the thread's running totals, scopes store the difference between push and pop
+    MemoryTracker::AllocationCounters m_allocations;
+#endif
+};
+
+// Written only by its owning thread and read only by MarkFrame, so the
+// read and write indices are the only synchronization needed
+struct ThreadEventBuffer
+{
+    Event m_events[EVENT_BUFFER_SIZE];
+    std::atomic<uint> m_writeIdx = 0;
+    std::atomic<uint> m_readIdx = 0;
+    std::atomic<bool> m_isRetired = false;
+    std::atomic<ScopeId> m_nameId = INVALID_SCOPE_ID;
+
+    // producer side
+    int m_depth = 0;        // recorded pushes that are not popped yet
+    int m_droppedDepth = 0; // while > 0 events are dropped to keep nesting valid
+
+    // consumer side, scopes still open at the end of the last frame
+    std::vector<ScopeId> m_openScopes;
+    MemoryTracker::AllocationCounters m_lastAllocations;
+};
+
+// marks the buffer as reusable when its thread exits
+struct ThreadBufferOwner
+{
+    ~ThreadBufferOwner();
+    ThreadEventBuffer* m_buffer = nullptr;
+};
+
+ThreadEventBuffer* RegisterThread();
+ThreadEventBuffer* GetThreadBuffer();
+void RecordEvent( ScopeId scopeId, uint64 ticks );
+MemoryTracker::AllocationCounters GetEventAllocations( const Event& event );
+
+Measurement* AcquireMeasurement( ScopeId scopeId, double startTime );
+void ReleaseMeasurementTree( Measurement* root );
+void GatherEvents( ThreadEventBuffer* buffer, Measurement* container,
+                   uint64 frameStartTicks, uint64 frameEndTicks );
+void GatherFrame( uint64 frameEndTicks );
+
+constexpr int MEASUREMENT_BLOCK_SIZE = 1024;
+
+// names are never freed so ids stay valid for the lifetime of the app
+std::mutex g_scopeLock;
+const char* g_scopeNames[MAX_SCOPES] = {};
+std::atomic<int> g_scopeCount = 0;
+
+thread_local ThreadBufferOwner t_bufferOwner;
+
+// buffers are never freed since a thread may still be recording at shutdown,
+// buffers of exited threads are reused by new threads instead
+std::mutex g_threadBuffersLock;
+std::vector<ThreadEventBuffer*> g_threadBuffers;
+int g_threadCount = 0;
+
+std::vector<Measurement*> g_measurementBlocks;
+std::vector<Measurement*> g_freeMeasurements;
+std::vector<Measurement*> g_releaseStack;
+
+ThreadEventBuffer* g_frameThreadBuffer = nullptr;
+bool g_hasFrameStarted = false;
+uint64 g_frameStartTicks = 0;
 
-Measurement* g_activeNode = nullptr;
 // newer frames are in the front
 std::deque<Measurement*> g_prevFrames;
 
@@ -61,64 +138,369 @@ float g_graphBarWidth = 1.f;
 DisplayHierarchy g_hierarchy = DisplayHierarchy::TREE;
 DisplaySortMode g_sortMode = DisplaySortMode::TOTAL;
 
+ProfilerTraceWriter g_traceWriter;
+int g_traceFramesLeft = 0;
+
+ProfilerStats* g_stats = nullptr;
 
+// indexed by ScopeId, g_counterIds lists the ids that were ever added to
+std::atomic<uint64> g_frameCounts[MAX_SCOPES];
+uint64 g_prevFrameCounts[MAX_SCOPES] = {};
+std::atomic<bool> g_isCounter[MAX_SCOPES];
+std::mutex g_counterLock;
+std::vector<ScopeId> g_counterIds;
 
-Measurement* CreateMeasurement( const char* id )
+
+
+ThreadBufferOwner::~ThreadBufferOwner()
 {
-    Measurement* measure = new Measurement();
+    if( m_buffer )
+        m_buffer->m_isRetired.store( true, std::memory_order_release );
+}
 
-    // copy id, truncate if necessary
-    for( int i = 0; i < MAX_STR_LEN - 1; ++i )
+ThreadEventBuffer* RegisterThread()
+{
+    std::lock_guard<std::mutex> lock( g_threadBuffersLock );
+
+    ThreadEventBuffer* buffer = nullptr;
+    for( ThreadEventBuffer* candidate : g_threadBuffers )
     {
-        char c = id[i];
-        measure->m_name[i] = c;
-        if( c == '\0' )
+        bool isDrained = candidate->m_readIdx.load() == candidate->m_writeIdx.load();
+        if( candidate->m_isRetired.load( std::memory_order_acquire ) && isDrained )
+        {
+            buffer = candidate;
             break;
+        }
     }
-    measure->m_name[MAX_STR_LEN - 1] = '\0';
 
-    // set time
-    measure->m_startTime = TimeUtils::GetCurrentTimeSeconds();
+    if( nullptr == buffer )
+    {
+        buffer = new ThreadEventBuffer();
+        g_threadBuffers.push_back( buffer );
+    }
 
-    return measure;
+    buffer->m_isRetired.store( false );
+    buffer->m_depth = 0;
+    buffer->m_droppedDepth = 0;
+    buffer->m_openScopes.clear();
+    buffer->m_lastAllocations = MemoryTracker::GetThreadCounters();
+
+    char name[MAX_STR_LEN];
+    snprintf( name, MAX_STR_LEN, "Thread %i", g_threadCount++ );
+    buffer->m_nameId = RegisterScope( name );
+
+    t_bufferOwner.m_buffer = buffer;
+    return buffer;
 }
 
-//--------------------------------------------------------------------------------------
-// end internal
+ThreadEventBuffer* GetThreadBuffer()
+{
+    ThreadEventBuffer* buffer = t_bufferOwner.m_buffer;
+    if( nullptr == buffer )
+        buffer = RegisterThread();
+    return buffer;
+}
 
-Scoped::Scoped( const char* tag )
+void RecordEvent( ScopeId scopeId, uint64 ticks )
 {
-    Push( tag );
+    ThreadEventBuffer* buffer = GetThreadBuffer();
+    bool isPush = ( INVALID_SCOPE_ID != scopeId );
+
+    if( buffer->m_droppedDepth > 0 )
+    {
+        buffer->m_droppedDepth += isPush ? 1 : -1;
+        return;
+    }
+
+    uint writeIdx = buffer->m_writeIdx.load( std::memory_order_relaxed );
+    uint readIdx = buffer->m_readIdx.load( std::memory_order_acquire );
+
+    if( isPush )
+    {
+        // keep room for the pops of every open scope so a pop is never dropped
+        uint used = writeIdx - readIdx;
+        if( used + buffer->m_depth + 2 > EVENT_BUFFER_SIZE )
+        {
+            buffer->m_droppedDepth = 1;
+            return;
+        }
+        ++buffer->m_depth;
+    }
+    else
+    {
+        GUARANTEE_OR_DIE( buffer->m_depth > 0, "Someone called pop wihtout a push!" );
+        --buffer->m_depth;
+    }
+
+    Event& event = buffer->m_events[writeIdx & ( EVENT_BUFFER_SIZE - 1 )];
+    event.m_scopeId = scopeId;
+    event.m_ticks = ticks;
+#if defined( PROFILE_ALLOCATIONS )
+    event.m_allocations = MemoryTracker::GetThreadCounters();
+#endif
+    buffer->m_writeIdx.store( writeIdx + 1, std::memory_order_release );
 }
 
-Scoped::~Scoped()
+MemoryTracker::AllocationCounters GetEventAllocations( const Event& event )
 {
-    Pop();
+#if defined( PROFILE_ALLOCATIONS )
+    return event.m_allocations;
+#else
+    UNUSED( event );
+    return MemoryTracker::AllocationCounters();
+#endif
 }
 
-Measurement::~Measurement()
+Measurement* AcquireMeasurement( ScopeId scopeId, double startTime )
 {
-    // call recursively on all children
-    // if no children end recursion
-    Measurement* firstChild = m_firstChild;
-    if( nullptr == firstChild )
+    if( g_freeMeasurements.empty() )
     {
-        return;
+        Measurement* block = new Measurement[MEASUREMENT_BLOCK_SIZE];
+        g_measurementBlocks.push_back( block );
+        g_freeMeasurements.reserve( MEASUREMENT_BLOCK_SIZE );
+        for( int idx = MEASUREMENT_BLOCK_SIZE - 1; idx >= 0; --idx )
+        {
+            g_freeMeasurements.push_back( &block[idx] );
+        }
+    }
+
+    Measurement* measure = g_freeMeasurements.back();
+    g_freeMeasurements.pop_back();
+
+    measure->Reset();
+    measure->m_scopeId = scopeId;
+    measure->m_startTime = startTime;
+    measure->m_endTime = startTime;
+    return measure;
+}
+
+void ReleaseMeasurementTree( Measurement* root )
+{
+    g_releaseStack.push_back( root );
+    while( !g_releaseStack.empty() )
+    {
+        Measurement* measure = g_releaseStack.back();
+        g_releaseStack.pop_back();
+
+        Measurement* firstChild = measure->m_firstChild;
+        if( nullptr != firstChild )
+        {
+            Measurement* currentChild = firstChild;
+            do
+            {
+                g_releaseStack.push_back( currentChild );
+                currentChild = currentChild->m_next;
+            } while( currentChild != firstChild );
+        }
+
+        g_freeMeasurements.push_back( measure );
+    }
+}
+
+void GatherEvents( ThreadEventBuffer* buffer, Measurement* container,
+                   uint64 frameStartTicks, uint64 frameEndTicks )
+{
+    Measurement* activeNode = container;
+    double frameStartTime = TimeUtils::TicksToSeconds( frameStartTicks );
+    double frameEndTime = TimeUtils::TicksToSeconds( frameEndTicks );
+
+    // scopes that were still running at the end of last frame continue in this one
+    for( ScopeId scopeId : buffer->m_openScopes )
+    {
+        Measurement* measure = AcquireMeasurement( scopeId, frameStartTime );
+        measure->m_allocations = buffer->m_lastAllocations;
+        measure->SetParent( activeNode );
+        activeNode->AddChild( measure );
+        activeNode = measure;
+    }
+
+    uint readIdx = buffer->m_readIdx.load( std::memory_order_relaxed );
+    uint writeIdx = buffer->m_writeIdx.load( std::memory_order_acquire );
+    for( ; readIdx != writeIdx; ++readIdx )
+    {
+        const Event& event = buffer->m_events[readIdx & ( EVENT_BUFFER_SIZE - 1 )];
+
+        // events recorded after the frame ended belong to the next frame
+        if( event.m_ticks > frameEndTicks )
+            break;
+
+        // open scopes hold the thread's totals at push until they are popped
+        double eventTime = TimeUtils::TicksToSeconds( event.m_ticks );
+        MemoryTracker::AllocationCounters eventAllocations = GetEventAllocations( event );
+        if( INVALID_SCOPE_ID != event.m_scopeId )
+        {
+            Measurement* measure = AcquireMeasurement( event.m_scopeId, eventTime );
+            measure->m_allocations = eventAllocations;
+            measure->SetParent( activeNode );
+            activeNode->AddChild( measure );
+            activeNode = measure;
+            buffer->m_openScopes.push_back( event.m_scopeId );
+        }
+        else if( activeNode != container )
+        {
+            activeNode->m_endTime = eventTime;
+            activeNode->m_allocations = eventAllocations - activeNode->m_allocations;
+            activeNode = activeNode->m_parent;
+            buffer->m_openScopes.pop_back();
+        }
+        buffer->m_lastAllocations = eventAllocations;
+    }
+    buffer->m_readIdx.store( readIdx, std::memory_order_release );
+
+    // clip scopes that are still running to the end of the frame
+    for( ; activeNode != container; activeNode = activeNode->m_parent )
+    {
+        activeNode->m_endTime = frameEndTime;
+        activeNode->m_allocations = buffer->m_lastAllocations - activeNode->m_allocations;
+    }
+
+    // an exited thread will never pop its remaining scopes
+    if( buffer->m_isRetired.load( std::memory_order_acquire ) && readIdx == writeIdx )
+        buffer->m_openScopes.clear();
+}
+
+void GatherFrame( uint64 frameEndTicks )
+{
+    std::lock_guard<std::mutex> lock( g_threadBuffersLock );
+    double frameEndTime = TimeUtils::TicksToSeconds( frameEndTicks );
+
+    // the frame thread's only top level scope is the frame itself
+    Measurement frameContainer;
+    frameContainer.Reset();
+    GatherEvents( g_frameThreadBuffer, &frameContainer, frameEndTicks, frameEndTicks );
+    Measurement* frame = frameContainer.m_firstChild;
+
+    bool isValidFrame = g_hasFrameStarted && nullptr != frame;
+    if( isValidFrame )
+    {
+        GUARANTEE_OR_DIE( frame->m_next == frame && g_frameThreadBuffer->m_openScopes.empty(),
+                          "Someone forgot to pop!" );
+        frame->SetParent( nullptr );
     }
     else
     {
-        Measurement* currentChild = firstChild;
-        Measurement* nextChild = nullptr;
+        // events recorded before the first frame have nothing to attach to
+        g_frameThreadBuffer->m_openScopes.clear();
+        Measurement* topLevel = frameContainer.m_firstChild;
+        if( nullptr != topLevel )
+        {
+            do
+            {
+                Measurement* next = topLevel->m_next;
+                ReleaseMeasurementTree( topLevel );
+                topLevel = next;
+            } while( topLevel != frameContainer.m_firstChild );
+        }
+        frame = AcquireMeasurement( RegisterScope( "Frame" ), frameEndTime );
+        g_frameStartTicks = frameEndTicks;
+    }
+
+    for( ThreadEventBuffer* buffer : g_threadBuffers )
+    {
+        if( buffer == g_frameThreadBuffer )
+            continue;
+
+        Measurement* threadRoot = AcquireMeasurement( buffer->m_nameId, frame->m_startTime );
+        threadRoot->m_endTime = frameEndTime;
+        threadRoot->m_isThreadRoot = true;
+        GatherEvents( buffer, threadRoot, g_frameStartTicks, frameEndTicks );
+
+        // idle threads are left out of the frame
+        if( nullptr == threadRoot->m_firstChild )
+        {
+            g_freeMeasurements.push_back( threadRoot );
+            continue;
+        }
+
+        // a thread root's allocations are those of its top level scopes
+        Measurement* child = threadRoot->m_firstChild;
         do
         {
-            nextChild = currentChild->m_next;
-            delete currentChild;
-            // cannot call currentChild->m_next here because currentChild will be deleted
-            currentChild = nextChild;
-        } while( currentChild != firstChild );
+            threadRoot->m_allocations.m_count += child->m_allocations.m_count;
+            threadRoot->m_allocations.m_bytes += child->m_allocations.m_bytes;
+            child = child->m_next;
+        } while( child != threadRoot->m_firstChild );
+
+        threadRoot->SetParent( frame );
+        frame->AddChild( threadRoot );
+    }
+
+    // counters restart every frame, but only recorded frames replace the last totals
+    {
+        std::lock_guard<std::mutex> counterLock( g_counterLock );
+        for( ScopeId counterId : g_counterIds )
+        {
+            uint64 count = g_frameCounts[counterId].exchange( 0, std::memory_order_relaxed );
+            if( isValidFrame && !g_isPaused )
+                g_prevFrameCounts[counterId] = count;
+        }
+    }
+
+    if( !isValidFrame || g_isPaused )
+    {
+        ReleaseMeasurementTree( frame );
+        return;
+    }
+
+    if( g_prevFrames.size() >= MAX_HISTORY_LEN )
+    {
+        ReleaseMeasurementTree( g_prevFrames.back() );
+        g_prevFrames.pop_back();
+    }
+
+    g_prevFrames.push_front( frame );
+
+    if( nullptr != g_stats )
+        g_stats->AddFrame( frame );
+
+    if( g_traceFramesLeft > 0 )
+    {
+        g_traceWriter.WriteFrame( frame );
+        --g_traceFramesLeft;
+        if( 0 == g_traceFramesLeft )
+        {
+            g_traceWriter.Close();
+            Console::DefaultConsole()->Printf( "Profiler trace capture finished, %i frames",
+                                               g_traceWriter.GetFramesWritten() );
+        }
     }
 }
 
+//--------------------------------------------------------------------------------------
+// end internal
+
+Scoped::Scoped( ScopeId scopeId )
+{
+    Push( scopeId );
+}
+
+Scoped::Scoped( const char* tag )
+{
+    Push( tag );
+}
+
+Scoped::~Scoped()
+{
+    Pop();
+}
+
+void Measurement::Reset()
+{
+    m_scopeId = INVALID_SCOPE_ID;
+    m_startTime = 0;
+    m_endTime = 0;
+    m_parent = nullptr;
+    m_firstChild = nullptr;
+    m_next = nullptr;
+    m_isThreadRoot = false;
+    m_allocations = MemoryTracker::AllocationCounters();
+}
+
+const char* Measurement::GetName()
+{
+    return GetScopeName( m_scopeId );
+}
+
 void Measurement::AddChild( Measurement* newChild )
 {
     if( m_firstChild )
@@ -151,65 +533,165 @@ void Measurement::Finish()
 
 void StartUp()
 {
-
+    g_frameThreadBuffer = GetThreadBuffer();
+    SetThreadName( "Main" );
 }
 
 void ShutDown()
 {
-
+    for( Measurement* frame : g_prevFrames )
+    {
+        ReleaseMeasurementTree( frame );
+    }
+    g_prevFrames.clear();
+    g_traceWriter.Close();
+    g_traceFramesLeft = 0;
+    DisableStats();
+    g_freeMeasurements.clear();
+    g_releaseStack.clear();
+    for( Measurement* block : g_measurementBlocks )
+    {
+        delete[] block;
+    }
+    g_measurementBlocks.clear();
 }
 
-void Push( const char* tag )
+ScopeId RegisterScope( const char* name, uint hash )
 {
-    if( g_isPaused )
-        return;
-    Measurement* measure = CreateMeasurement( tag );
-    if( g_activeNode == nullptr )
+    // the lookup is only used while registering, built on first use so
+    // call sites in static initializers are safe
+    static std::unordered_multimap<uint, ScopeId> s_scopeIdsByHash;
+
+    std::lock_guard<std::mutex> lock( g_scopeLock );
+
+    auto range = s_scopeIdsByHash.equal_range( hash );
+    for( auto iter = range.first; iter != range.second; ++iter )
     {
-        g_activeNode = measure;
+        if( 0 == strcmp( g_scopeNames[iter->second], name ) )
+            return iter->second;
     }
-    else
+
+    int scopeCount = g_scopeCount.load( std::memory_order_relaxed );
+    if( scopeCount >= MAX_SCOPES - 1 )
     {
-        measure->SetParent( g_activeNode );
-        g_activeNode->AddChild( measure );
-        g_activeNode = measure;
+        // the last id is shared by everything past the limit
+        ScopeId overflowId = MAX_SCOPES - 1;
+        if( nullptr == g_scopeNames[overflowId] )
+        {
+            ERROR_RECOVERABLE( "Too many profiler scopes, increase MAX_SCOPES" );
+            g_scopeNames[overflowId] = "ScopeOverflow";
+            g_scopeCount.store( MAX_SCOPES, std::memory_order_release );
+        }
+        return overflowId;
     }
+
+    size_t nameLength = strlen( name ) + 1;
+    char* nameCopy = new char[nameLength];
+    memcpy( nameCopy, name, nameLength );
+
+    ScopeId scopeId = (ScopeId) scopeCount;
+    g_scopeNames[scopeId] = nameCopy;
+    s_scopeIdsByHash.emplace( hash, scopeId );
+    g_scopeCount.store( scopeCount + 1, std::memory_order_release );
+    return scopeId;
+}
+
+ScopeId RegisterScope( const char* name )
+{
+    return RegisterScope( name, HashScopeName( name ) );
+}
+
+const char* GetScopeName( ScopeId scopeId )
+{
+    if( scopeId >= (ScopeId) g_scopeCount.load( std::memory_order_acquire ) )
+        return "Unknown";
+    return g_scopeNames[scopeId];
+}
+
+void Push( ScopeId scopeId )
+{
+    RecordEvent( scopeId, TimeUtils::GetCurrentTimeTicks() );
+}
+
+void Push( const char* tag )
+{
+    Push( RegisterScope( tag ) );
 }
 
 void Pop()
 {
-    if( g_isPaused )
+    RecordEvent( INVALID_SCOPE_ID, TimeUtils::GetCurrentTimeTicks() );
+}
+
+void AddCount( ScopeId counterId, uint64 value )
+{
+    if( counterId >= MAX_SCOPES )
         return;
-    GUARANTEE_OR_DIE( g_activeNode != nullptr, "Someone called pop wihtout a push!" );
-    g_activeNode->Finish();
-    g_activeNode = g_activeNode->m_parent;
+
+    if( !g_isCounter[counterId].load( std::memory_order_acquire ) )
+    {
+        std::lock_guard<std::mutex> lock( g_counterLock );
+        if( !g_isCounter[counterId].load( std::memory_order_relaxed ) )
+        {
+            g_counterIds.push_back( counterId );
+            g_isCounter[counterId].store( true, std::memory_order_release );
+        }
+    }
+    g_frameCounts[counterId].fetch_add( value, std::memory_order_relaxed );
+}
+
+uint64 GetPreviousFrameCount( ScopeId counterId )
+{
+    if( counterId >= MAX_SCOPES )
+        return 0;
+    return g_prevFrameCounts[counterId];
 }
 
 void MarkFrame()
 {
+    static const ScopeId s_frameScopeId = RegisterScope( "Frame" );
+
+    if( nullptr == g_frameThreadBuffer )
+        g_frameThreadBuffer = GetThreadBuffer();
+
+    // the previous frame ends exactly where the next one starts
+    uint64 frameTicks = TimeUtils::GetCurrentTimeTicks();
+    if( g_hasFrameStarted )
+        RecordEvent( INVALID_SCOPE_ID, frameTicks );
+
+    GatherFrame( frameTicks );
+
     // check if there are pause or resume requests
     g_isPaused = g_shouldPauseNextFrame;
 
-    if( g_isPaused )
-        return;
+    RecordEvent( s_frameScopeId, frameTicks );
+    g_frameStartTicks = frameTicks;
+    g_hasFrameStarted = true;
+}
 
-    if( g_activeNode != nullptr )
+MemoryTracker::AllocationCounters GetFrameAllocations( Measurement* frame )
+{
+    MemoryTracker::AllocationCounters allocations = frame->m_allocations;
+
+    // other threads are not nested in the frame thread's scopes
+    Measurement* child = frame->m_firstChild;
+    if( nullptr == child )
+        return allocations;
+    do
     {
-        if( g_prevFrames.size() >= MAX_HISTORY_LEN )
+        if( child->m_isThreadRoot )
         {
-            Measurement* last = g_prevFrames.back();
-            g_prevFrames.pop_back();
-            delete last; // will recursively delete children
+            allocations.m_count += child->m_allocations.m_count;
+            allocations.m_bytes += child->m_allocations.m_bytes;
         }
+        child = child->m_next;
+    } while( child != frame->m_firstChild );
+    return allocations;
+}
 
-        g_prevFrames.push_front( g_activeNode );
-
-        Pop();
-
-        GUARANTEE_OR_DIE( g_activeNode == nullptr, "Someone forgot to pop!" );
-    }
-
-    Push( "Frame" );
+void SetThreadName( const char* name )
+{
+    GetThreadBuffer()->m_nameId = RegisterScope( name );
 }
 
 void SetVisible( bool visible )
@@ -235,6 +717,7 @@ void RenderReport( int frameSkip = 0 )
     static float timeOfLastUpdate = 0.f;
     static double frameTime = 0;
     static double fps = 0;
+    static MemoryTracker::AllocationCounters frameAllocations;
     bool shouldUpdateThisFrame = false;
 
     float currentTime = (float) TimeUtils::GetCurrentTimeSeconds();
@@ -250,23 +733,35 @@ void RenderReport( int frameSkip = 0 )
         // Build Report
         Profiler::Measurement* frame = Profiler::GetPreviousFrame( frameSkip );
         ProfilerReport report;
+        frameAllocations = GetFrameAllocations( frame );
 
-        if( g_hierarchy == DisplayHierarchy::TREE )
-            report.GenerateReportTreeFromFrame( frame );
-        else if( g_hierarchy == DisplayHierarchy::FLAT )
-            report.GenerateReportFlatFromFrame( frame );
-
-        if( g_sortMode == DisplaySortMode::TOTAL )
-            report.SortByTotalTime();
-        else if( g_sortMode == DisplaySortMode::SELF )
-            report.SortBySelfTime();
-
-        reportStr = report.ToString();
-
-        // update FPS and frame time
-        timeOfLastUpdate = currentTime;
-        frameTime = report.GetTotalFrameTime() * 1000;
-        fps = 1 / report.GetTotalFrameTime();
+        if( g_hierarchy == DisplayHierarchy::STATS )
+        {
+            // stats cover the whole window, there is no single frame to report
+            reportStr = g_stats->ToString();
+            timeOfLastUpdate = currentTime;
+            frameTime = frame->GetElapsedTime() * 1000;
+            fps = 1 / frame->GetElapsedTime();
+        }
+        else
+        {
+            if( g_hierarchy == DisplayHierarchy::TREE )
+                report.GenerateReportTreeFromFrame( frame );
+            else if( g_hierarchy == DisplayHierarchy::FLAT )
+                report.GenerateReportFlatFromFrame( frame );
+
+            if( g_sortMode == DisplaySortMode::TOTAL )
+                report.SortByTotalTime();
+            else if( g_sortMode == DisplaySortMode::SELF )
+                report.SortBySelfTime();
+
+            reportStr = report.ToString();
+
+            // update FPS and frame time
+            timeOfLastUpdate = currentTime;
+            frameTime = report.GetTotalFrameTime() * 1000;
+            fps = 1 / report.GetTotalFrameTime();
+        }
     }
 
     DebugRender::SetOptions( 0 );
@@ -281,6 +776,33 @@ void RenderReport( int frameSkip = 0 )
         bounds, fontHeight, Vec2( 0, 1 ),
         "FPS: %.2f \nFrame Time: %.2f ms", fps, frameTime );
 
+    if( MemoryTracker::IS_ENABLED )
+    {
+        AABB2 allocationBounds = bounds;
+        allocationBounds.Translate( 0, -fontHeight * 2 );
+        DebugRender::DrawText2D(
+            allocationBounds, fontHeight, Vec2( 0, 1 ),
+            "Allocations: %llu [%.1f KB]",
+            frameAllocations.m_count, (double) frameAllocations.m_bytes / 1024.0 );
+    }
+
+    // Draw counters, one per line
+    String countersStr;
+    {
+        std::lock_guard<std::mutex> lock( g_counterLock );
+        for( ScopeId counterId : g_counterIds )
+        {
+            countersStr += Stringf( "%s: %llu\n", GetScopeName( counterId ),
+                                    g_prevFrameCounts[counterId] );
+        }
+    }
+    if( !countersStr.empty() )
+    {
+        AABB2 countersBounds = bounds;
+        countersBounds.Translate( 0, -fontHeight * 3 );
+        DebugRender::DrawText2D( countersBounds, fontHeight, Vec2( 0, 1 ), countersStr );
+    }
+
     // Draw report
     bounds.Translate( 0, -fontHeight * 12 );
     DebugRender::DrawText2D(
@@ -365,6 +887,8 @@ void ProcessInput()
         g_hierarchy = g_hierarchy + 1;
         if( g_hierarchy >= DisplayHierarchy::COUNT )
             g_hierarchy = 0;
+        if( g_hierarchy == DisplayHierarchy::STATS && nullptr == g_stats )
+            EnableStats();
     }
 
     if( input->WasKeyJustPressed( 'L' ) )
@@ -435,11 +959,88 @@ void Resume()
     g_shouldPauseNextFrame = false;
 }
 
+bool CaptureTrace( const String& filePath, int frameCount )
+{
+    if( frameCount <= 0 || !g_traceWriter.Open( filePath ) )
+        return false;
+
+    g_traceFramesLeft = frameCount;
+    return true;
+}
+
+bool IsCapturingTrace()
+{
+    return g_traceFramesLeft > 0;
+}
+
+void EnableStats( int windowFrames )
+{
+    if( windowFrames < 1 )
+        windowFrames = 1;
+    if( nullptr != g_stats && g_stats->GetWindowFrames() == windowFrames )
+        return;
+
+    delete g_stats;
+    g_stats = new ProfilerStats( windowFrames );
+}
+
+void DisableStats()
+{
+    delete g_stats;
+    g_stats = nullptr;
+}
+
+ProfilerStats* GetStats()
+{
+    return g_stats;
+}
+
+bool ExportTrace( const String& filePath, int frameCount )
+{
+    // exporting would truncate the file a capture is streaming to
+    if( IsCapturingTrace() )
+        return false;
+
+    ProfilerTraceWriter writer;
+    if( !writer.Open( filePath ) )
+        return false;
+
+    int frameIdx = ClampInt( frameCount, 0, (int) g_prevFrames.size() ) - 1;
+    for( ; frameIdx >= 0; --frameIdx )
+    {
+        writer.WriteFrame( g_prevFrames[frameIdx] );
+    }
+
+    writer.Close();
+    return true;
+}
+
 #else
 
+ScopeId RegisterScope( const char* name, uint hash )
+{
+    (void) ( name );
+    (void) ( hash );
+    return INVALID_SCOPE_ID;
+}
+
+ScopeId RegisterScope( const char* name ) { (void) ( name ); return INVALID_SCOPE_ID; }
+
+const char* GetScopeName( ScopeId scopeId ) { (void) ( scopeId ); return ""; }
+
+Scoped::Scoped( ScopeId scopeId ) { (void) ( scopeId ); }
+
+Scoped::Scoped( const char* tag ) { (void) ( tag ); }
+
+Scoped::~Scoped() {}
+
+void Measurement::Reset() {}
+
+const char* Measurement::GetName() { return ""; }
+
 void Measurement::AddChild( Measurement* newChild ) { (void) ( newChild ); }
 
-void Measurement::SetParent( Measurement* parent ) { (void) ( newChild ); }
+void Measurement::SetParent( Measurement* parent ) { (void) ( parent ); }
 
 void Measurement::Finish() {}
 
@@ -449,20 +1050,66 @@ void StartUp() {}
 
 void ShutDown() {}
 
+void Push( ScopeId scopeId ) { (void) ( scopeId ); }
+
 void Push( const char* tag ) { (void) ( tag ); }
 
 void Pop() {}
 
+void AddCount( ScopeId counterId, uint64 value )
+{
+    (void) ( counterId );
+    (void) ( value );
+}
+
+uint64 GetPreviousFrameCount( ScopeId counterId ) { (void) ( counterId ); return 0; }
+
 void MarkFrame() {}
 
+MemoryTracker::AllocationCounters GetFrameAllocations( Measurement* frame )
+{
+    (void) ( frame );
+    return MemoryTracker::AllocationCounters();
+}
+
+void SetThreadName( const char* name ) { (void) ( name ); }
+
+void SetVisible( bool visible ) { (void) ( visible ); }
+
+void ToggleVisible() {}
+
 void Render() {}
 
-Profiler::Measurement* GetPreviousFrame( int skipCount ) { (void) ( skipCount ); }
+void ProcessInput() {}
+
+Profiler::Measurement* GetPreviousFrame( int skipCount ) { (void) ( skipCount ); return nullptr; }
 
 void Pause() {}
 
 void Resume() {}
 
+bool CaptureTrace( const String& filePath, int frameCount )
+{
+    (void) ( filePath );
+    (void) ( frameCount );
+    return false;
+}
+
+bool IsCapturingTrace() { return false; }
+
+void EnableStats( int windowFrames ) { (void) ( windowFrames ); }
+
+void DisableStats() {}
+
+ProfilerStats* GetStats() { return nullptr; }
+
+bool ExportTrace( const String& filePath, int frameCount )
+{
+    (void) ( filePath );
+    (void) ( frameCount );
+    return false;
+}
+
 #endif
 
 
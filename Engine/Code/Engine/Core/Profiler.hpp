@@ -1,47 +1,104 @@
 #pragma once
 #include "Engine/Core/ProfileLogScoped.hpp"
+#include "Engine/Core/MemoryTracker.hpp"
+#include "Engine/Core/Types.hpp"
 #include "Game/EngineBuildPreferences.hpp"
 
 
 
+// Each call site registers its name once and afterwards only records a small id,
+// names are looked up when a report is built
+#define PROFILER_CONCAT_INNER( a, b ) a##b
+#define PROFILER_CONCAT( a, b ) PROFILER_CONCAT_INNER( a, b )
+
 #if defined( PROFILING_ENABLED )
 
-#define PROFILER_PUSH(tag) Profiler::Push((#tag))
-#define PROFILER_PUSH_FUNCTION() Profiler::Push(__FUNCTION__)
+// name must be a string literal, __FUNCTION__ would name the lambda
+#define PROFILER_SCOPE_ID(name) []() -> Profiler::ScopeId                               \
+{                                                                                       \
+    constexpr uint hash = Profiler::HashScopeName( name );                              \
+    static const Profiler::ScopeId s_scopeId = Profiler::RegisterScope( name, hash );   \
+    return s_scopeId;                                                                   \
+}()
+
+// Declares the id of the enclosing function in the function itself
+#define PROFILER_FUNCTION_ID_DECLARE()                                                  \
+    static const Profiler::ScopeId PROFILER_CONCAT( __profiler_id_, __LINE__ )          \
+        = Profiler::RegisterScope( __FUNCTION__ )
+#define PROFILER_FUNCTION_ID() PROFILER_CONCAT( __profiler_id_, __LINE__ )
+
+#define PROFILER_PUSH(tag) Profiler::Push( PROFILER_SCOPE_ID( #tag ) )
+#define PROFILER_PUSH_FUNCTION() \
+    PROFILER_FUNCTION_ID_DECLARE(); Profiler::Push( PROFILER_FUNCTION_ID() )
 #define PROFILER_POP() Profiler::Pop()
-#define PROFILER_SCOPED() Profiler::Scoped __profiler_##__LINE__ ## (__FUNCTION__)
+#define PROFILER_SCOPED()                                                               \
+    PROFILER_FUNCTION_ID_DECLARE();                                                     \
+    Profiler::Scoped PROFILER_CONCAT( __profiler_, __LINE__ )( PROFILER_FUNCTION_ID() )
+#define PROFILER_COUNT(tag, value) Profiler::AddCount( PROFILER_SCOPE_ID( #tag ), value )
 
 #else
 
-#define PROFILER_PUSH_TAG(tag) { (void)( #tag ); }
-#define PROFILER_PUSH() ;
-#define PROFILER_POP() ;
-#define PROFILER_SCOPED() ;
+#define PROFILER_SCOPE_ID(name) Profiler::INVALID_SCOPE_ID
+#define PROFILER_PUSH(tag) { (void)( #tag ); }
+#define PROFILER_PUSH_FUNCTION() {}
+#define PROFILER_POP() {}
+#define PROFILER_SCOPED() {}
+#define PROFILER_COUNT(tag, value) { (void)( #tag ); (void)( value ); }
 
 #endif // PROFILING_ENABLED
 
 
+class ProfilerStats;
 
 namespace Profiler
 {
 
+typedef uint ScopeId;
+constexpr ScopeId INVALID_SCOPE_ID = 0xffffffff;
+
+constexpr int MAX_STR_LEN = 64;
+constexpr int MAX_HISTORY_LEN = 60 * 5;
+constexpr int MAX_SCOPES = 4096;
+// Per thread ring buffer of push / pop events, must be a power of 2
+// Events that do not fit are dropped until the thread's stack unwinds
+constexpr int EVENT_BUFFER_SIZE = 1 << 16;
+
+// FNV-1a, evaluated at compile time for the macros above
+constexpr uint HashScopeName( const char* name )
+{
+    uint hash = 2166136261u;
+    for( ; *name != '\0'; ++name )
+    {
+        hash ^= (unsigned char) *name;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Returns the same id for the same name, thread safe but takes a lock,
+// call once per call site and keep the id
+ScopeId RegisterScope( const char* name, uint hash );
+ScopeId RegisterScope( const char* name );
+const char* GetScopeName( ScopeId scopeId );
+
 class Scoped
 {
 public:
+    Scoped( ScopeId scopeId );
     Scoped( const char* tag );
     ~Scoped();
 };
 
-constexpr int MAX_STR_LEN = 64;
-constexpr int MAX_HISTORY_LEN = 60 * 5;
-
+// Measurements are owned by the profiler's pool and recycled when a frame
+// falls out of the history, do not delete them
 struct Measurement
 {
-    ~Measurement();
-    char m_name[MAX_STR_LEN];
+    ScopeId m_scopeId;
     double m_startTime;
     double m_endTime;
 
+    void Reset();
+    const char* GetName();
     void AddChild( Measurement* newChild );
     void SetParent( Measurement* parent );
     double GetElapsedTime();
@@ -50,16 +107,42 @@ struct Measurement
     Measurement* m_firstChild = nullptr;
     Measurement* m_next = nullptr;
 
+    // Root of a non frame thread, it spans the whole frame and runs
+    // concurrently with its siblings instead of inside its parent
+    bool m_isThreadRoot = false;
+
+    // Heap allocations made inside this scope including its children,
+    // always zero unless PROFILE_ALLOCATIONS is defined
+    MemoryTracker::AllocationCounters m_allocations;
 };
 
 
 void StartUp();
 void ShutDown();
 
+// Push and Pop are lock free and do not allocate, they can be called from any thread
+void Push( ScopeId scopeId );
+// Registers tag on every call, prefer the macros or a cached RegisterScope id
 void Push( const char* tag );
 void Pop();
+
+// Per frame totals shown under the frame time, like how many objects a pass culled
+// Counters share the scope names, prefer PROFILER_COUNT
+// Lock free once a counter has been added to, can be called from any thread
+void AddCount( ScopeId counterId, uint64 value );
+// Total of the last recorded frame, 0 if the counter was not added to in it
+uint64 GetPreviousFrameCount( ScopeId counterId );
+
+// Call once per frame from the main thread, gathers the events of all threads
+// into one frame tree
 void MarkFrame();
 
+// Allocations of the frame thread plus every other thread during the frame
+MemoryTracker::AllocationCounters GetFrameAllocations( Measurement* frame );
+
+// Name used for the calling thread's node in the frame tree
+void SetThreadName( const char* name );
+
 void SetVisible( bool visible );
 void ToggleVisible();
 void Render();
@@ -70,6 +153,20 @@ Measurement* GetPreviousFrame( int skipCount = 0 ); // 0 is previous frame
 void Pause();
 void Resume();
 
+// Streams the next frameCount frames to a Chrome trace json file as they finish
+bool CaptureTrace( const String& filePath, int frameCount );
+bool IsCapturingTrace();
+
+// Writes the newest frameCount frames already in the history to a Chrome trace json file
+bool ExportTrace( const String& filePath, int frameCount = MAX_HISTORY_LEN );
+
+// Rolling per scope min / mean / percentiles / max over the last windowFrames frames,
+// restarts collection if the window size changes
+void EnableStats( int windowFrames = MAX_HISTORY_LEN );
+void DisableStats();
+// nullptr when stats are disabled
+ProfilerStats* GetStats();
+
 
 };
 
@@ -10,7 +10,7 @@ ProfilerReport::~ProfilerReport()
 
 void ProfilerReport::GenerateReportTreeFromFrame( Profiler::Measurement *frame )
 {
-    m_rootEntry = new ProfilerReportEntry( frame->m_name );
+    m_rootEntry = new ProfilerReportEntry( frame->GetName() );
     m_rootEntry->PopulateTreeR( frame );
     m_rootEntry->FinalizeTimesR();
     m_frameTime = m_rootEntry->m_totalTime;
@@ -19,7 +19,7 @@ void ProfilerReport::GenerateReportTreeFromFrame( Profiler::Measurement *frame )
 
 void ProfilerReport::GenerateReportFlatFromFrame( Profiler::Measurement *frame )
 {
-    ProfilerReportEntry frameEntry = ProfilerReportEntry( frame->m_name );
+    ProfilerReportEntry frameEntry = ProfilerReportEntry( frame->GetName() );
     frameEntry.PopulateTreeR( frame );
     frameEntry.FinalizeTimesR();
     m_rootEntry = new ProfilerReportEntry( "root" );
@@ -29,7 +29,7 @@ void ProfilerReportEntry::PopulateTreeR( Profiler::Measurement *measurement )
         Profiler::Measurement* currentChild = firstChild;
         do
         {
-            ProfilerReportEntry *entry = GetOrCreateChild( currentChild->m_name );
+            ProfilerReportEntry *entry = GetOrCreateChild( currentChild->GetName() );
             entry->PopulateTreeR( currentChild );
             currentChild = currentChild->m_next;
         } while( currentChild != firstChild );
@@ -40,6 +40,9 @@ void ProfilerReportEntry::AccumulateData( Profiler::Measurement *measurement )
 {
     m_callCount++;
     m_totalTime += measurement->GetElapsedTime();
+    m_isConcurrent = measurement->m_isThreadRoot;
+    m_allocCount += measurement->m_allocations.m_count;
+    m_allocBytes += measurement->m_allocations.m_bytes;
     // m_percent_time = ?; // figure it out later;
 }
 
@@ -49,11 +52,15 @@ void ProfilerReportEntry::FinalizeTimesR()
     for( auto& entryPair : m_children )
     {
         ProfilerReportEntry* child = entryPair.second;
-        childrenTime += child->m_totalTime;
+        if( !child->m_isConcurrent )
+            childrenTime += child->m_totalTime;
         child->FinalizeTimesR();
     }
 
     m_selfTime = m_totalTime - childrenTime;
+    // a thread's time outside of its scopes is idle, not work
+    if( m_isConcurrent )
+        m_selfTime = 0;
     // this only happens for flat view root node
     if( m_selfTime < 0 )
         m_selfTime = 0;
@@ -75,6 +82,8 @@ void ProfilerReportEntry::CollapesTreeToFlatR( ProfilerReportEntry *rootEntry )
     entry->m_totalTime += m_totalTime;
     entry->m_selfTime += m_selfTime;
     entry->m_callCount += m_callCount;
+    entry->m_allocCount += m_allocCount;
+    entry->m_allocBytes += m_allocBytes;
     for ( auto& child : m_sortedChildren )
     {
         child->CollapesTreeToFlatR( rootEntry );
@@ -97,7 +106,7 @@ void ProfilerReportEntry::PopulateFlatR( Profiler::Measurement *measurement,
         do
         {
             ProfilerReportEntry *entry = rootEntry->
-                GetOrCreateChild( currentChildMeasure->m_name );
+                GetOrCreateChild( currentChildMeasure->GetName() );
 
             entry->PopulateFlatR( currentChildMeasure, rootEntry );
             currentChildMeasure = currentChildMeasure->m_next;
@@ -132,6 +141,14 @@ String ProfilerReportEntry::GernerateStringR( int indent /*= 0 */ )
                     m_selfPercentTime,
                     m_selfTime * 1000 );
 
+    if( MemoryTracker::IS_ENABLED )
+    {
+        // replace the newline so allocations end up on the same line
+        m_reportString.pop_back();
+        m_reportString += Stringf( "%-8llu [%-9.1f KB] \n",
+                                   m_allocCount, (double) m_allocBytes / 1024.0 );
+    }
+
     for ( auto& pair : m_children )
     {
         ProfilerReportEntry* childEntry = pair.second;
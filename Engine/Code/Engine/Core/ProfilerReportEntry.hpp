@@ -53,6 +53,11 @@ public:
     double m_selfTime = 0;  // exclusive time
     double m_totalPercentTime = 0;
     double m_selfPercentTime = 0;
+    // runs alongside its parent on another thread instead of inside it
+    bool m_isConcurrent = false;
+    // inclusive, only tracked with PROFILE_ALLOCATIONS
+    uint64 m_allocCount = 0;
+    uint64 m_allocBytes = 0;
 
     String m_reportString;
 
@@ -0,0 +1,251 @@
+#include "Engine/Core/ProfilerStats.hpp"
+#include "Engine/Core/ContainerUtils.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include <algorithm>
+
+
+void ProfilerHistogram::Add( double seconds )
+{
+    ++m_buckets[GetBucketIndex( seconds )];
+    ++m_count;
+}
+
+void ProfilerHistogram::Remove( double seconds )
+{
+    --m_buckets[GetBucketIndex( seconds )];
+    --m_count;
+}
+
+double ProfilerHistogram::GetPercentile( double percentile ) const
+{
+    if( 0 == m_count )
+        return 0;
+
+    double targetRank = percentile * (double) ( m_count - 1 );
+    uint countBelow = 0;
+    for( int bucketIdx = 0; bucketIdx < NUM_BUCKETS; ++bucketIdx )
+    {
+        uint bucketCount = m_buckets[bucketIdx];
+        if( countBelow + bucketCount > targetRank )
+        {
+            double fraction = ( targetRank - countBelow + 0.5 ) / (double) bucketCount;
+            double bucketMin = GetBucketMinSeconds( bucketIdx );
+            double bucketMax = GetBucketMinSeconds( bucketIdx + 1 );
+            return bucketMin + ( bucketMax - bucketMin ) * fraction;
+        }
+        countBelow += bucketCount;
+    }
+    return GetBucketMinSeconds( NUM_BUCKETS );
+}
+
+int ProfilerHistogram::GetBucketIndex( double seconds )
+{
+    // bucket 0 holds everything under MIN_BUCKET_SECONDS
+    if( seconds < MIN_BUCKET_SECONDS )
+        return 0;
+    double octaves = log2( seconds / MIN_BUCKET_SECONDS );
+    int bucketIdx = (int) ( octaves * BUCKETS_PER_OCTAVE ) + 1;
+    return ClampInt( bucketIdx, 0, NUM_BUCKETS - 1 );
+}
+
+double ProfilerHistogram::GetBucketMinSeconds( int bucketIdx )
+{
+    if( 0 == bucketIdx )
+        return 0;
+    return MIN_BUCKET_SECONDS * exp2( (double) ( bucketIdx - 1 ) / BUCKETS_PER_OCTAVE );
+}
+
+
+
+ProfilerScopeStats::ProfilerScopeStats( const String& name, int windowFrames )
+    : m_name( name )
+    , m_frameTimes( windowFrames, 0.f )
+    , m_frameCalls( windowFrames, 0 )
+{
+
+}
+
+void ProfilerScopeStats::Accumulate( double seconds )
+{
+    m_currentTime += seconds;
+    ++m_currentCalls;
+}
+
+void ProfilerScopeStats::EndFrame()
+{
+    // drop the oldest frame
+    float oldTime = m_frameTimes[m_nextFrameIdx];
+    uint oldCalls = m_frameCalls[m_nextFrameIdx];
+    if( oldCalls > 0 )
+    {
+        m_histogram.Remove( oldTime );
+        m_windowTime -= oldTime;
+        m_windowCalls -= oldCalls;
+        --m_activeFrames;
+    }
+
+    // add this frame, stored as float so the histogram removes the bucket it added to
+    float newTime = (float) m_currentTime;
+    m_frameTimes[m_nextFrameIdx] = newTime;
+    m_frameCalls[m_nextFrameIdx] = m_currentCalls;
+    if( m_currentCalls > 0 )
+    {
+        m_histogram.Add( newTime );
+        m_windowTime += newTime;
+        m_windowCalls += m_currentCalls;
+        ++m_activeFrames;
+    }
+
+    m_nextFrameIdx = ( m_nextFrameIdx + 1 ) % (int) m_frameTimes.size();
+    if( 0 == m_nextFrameIdx )
+    {
+        // adding and removing samples of different sizes drifts, resum once per window
+        m_windowTime = 0;
+        for( size_t frameIdx = 0; frameIdx < m_frameTimes.size(); ++frameIdx )
+        {
+            if( m_frameCalls[frameIdx] > 0 )
+                m_windowTime += m_frameTimes[frameIdx];
+        }
+    }
+    m_currentTime = 0;
+    m_currentCalls = 0;
+}
+
+double ProfilerScopeStats::GetMin() const
+{
+    float minTime = INFINITY;
+    for( size_t frameIdx = 0; frameIdx < m_frameTimes.size(); ++frameIdx )
+    {
+        if( m_frameCalls[frameIdx] > 0 )
+            minTime = Minf( minTime, m_frameTimes[frameIdx] );
+    }
+    return m_activeFrames > 0 ? minTime : 0;
+}
+
+double ProfilerScopeStats::GetMax() const
+{
+    float maxTime = 0;
+    for( size_t frameIdx = 0; frameIdx < m_frameTimes.size(); ++frameIdx )
+    {
+        if( m_frameCalls[frameIdx] > 0 )
+            maxTime = Maxf( maxTime, m_frameTimes[frameIdx] );
+    }
+    return maxTime;
+}
+
+double ProfilerScopeStats::GetMean() const
+{
+    if( 0 == m_activeFrames )
+        return 0;
+    return m_windowTime / m_activeFrames;
+}
+
+double ProfilerScopeStats::GetPercentile( double percentile ) const
+{
+    // the histogram is approximate, the exact extremes are tighter bounds
+    double value = m_histogram.GetPercentile( percentile );
+    value = std::max( value, GetMin() );
+    value = std::min( value, GetMax() );
+    return value;
+}
+
+
+
+ProfilerStats::ProfilerStats( int windowFrames )
+    : m_windowFrames( windowFrames )
+{
+
+}
+
+ProfilerStats::~ProfilerStats()
+{
+    // m_scopesById holds the same pointers
+    m_scopesById.clear();
+    ContainerUtils::DeletePointers( m_allScopes );
+}
+
+void ProfilerStats::AddFrame( Profiler::Measurement* frame )
+{
+    if( nullptr == frame )
+        return;
+
+    AccumulateR( frame );
+
+    // every scope gets a sample each frame, even ones that did not run
+    for( ProfilerScopeStats* scope : m_allScopes )
+    {
+        scope->EndFrame();
+    }
+
+    if( m_framesInWindow < m_windowFrames )
+        ++m_framesInWindow;
+}
+
+String ProfilerStats::ToString()
+{
+    // percentiles scan the window, so compute the sort key once per scope
+    std::vector<std::pair<double, ProfilerScopeStats*>> sortedScopes;
+    sortedScopes.reserve( m_allScopes.size() );
+    for( ProfilerScopeStats* scope : m_allScopes )
+    {
+        if( scope->GetActiveFrameCount() > 0 )
+            sortedScopes.emplace_back( scope->GetPercentile( 0.99 ), scope );
+    }
+    std::sort( sortedScopes.begin(), sortedScopes.end(),
+               []( const std::pair<double, ProfilerScopeStats*>& lhs,
+                   const std::pair<double, ProfilerScopeStats*>& rhs )
+    {
+        return lhs.first > rhs.first;
+    } );
+
+    String str = Stringf( "Last %i frames\n%-48s %-7s %-7s %-8s %-8s %-8s %-8s %-8s %-8s\n",
+                          m_framesInWindow, "Scope", "Frames", "Calls",
+                          "Min", "Mean", "P50", "P95", "P99", "Max" );
+    for( auto& sortedScope : sortedScopes )
+    {
+        ProfilerScopeStats* scope = sortedScope.second;
+        str += Stringf( "%-48s %-7i %-7u %-8.3f %-8.3f %-8.3f %-8.3f %-8.3f %-8.3f\n",
+                        scope->m_name.c_str(),
+                        scope->GetActiveFrameCount(),
+                        scope->GetCallCount(),
+                        scope->GetMin() * 1000,
+                        scope->GetMean() * 1000,
+                        scope->GetPercentile( 0.5 ) * 1000,
+                        scope->GetPercentile( 0.95 ) * 1000,
+                        sortedScope.first * 1000,
+                        scope->GetMax() * 1000 );
+    }
+    return str;
+}
+
+void ProfilerStats::AccumulateR( Profiler::Measurement* measure )
+{
+    // thread roots span the whole frame, only their scopes are interesting
+    if( !measure->m_isThreadRoot )
+    {
+        Profiler::ScopeId scopeId = measure->m_scopeId;
+        if( scopeId >= m_scopesById.size() )
+            m_scopesById.resize( scopeId + 1, nullptr );
+
+        ProfilerScopeStats* scope = m_scopesById[scopeId];
+        if( nullptr == scope )
+        {
+            scope = new ProfilerScopeStats( measure->GetName(), m_windowFrames );
+            m_scopesById[scopeId] = scope;
+            m_allScopes.push_back( scope );
+        }
+        scope->Accumulate( measure->GetElapsedTime() );
+    }
+
+    Profiler::Measurement* firstChild = measure->m_firstChild;
+    if( nullptr == firstChild )
+        return;
+
+    Profiler::Measurement* currentChild = firstChild;
+    do
+    {
+        AccumulateR( currentChild );
+        currentChild = currentChild->m_next;
+    } while( currentChild != firstChild );
+}
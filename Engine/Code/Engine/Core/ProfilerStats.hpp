@@ -0,0 +1,89 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Profiler.hpp"
+
+// Fixed memory log scale histogram of scope times
+// Each bucket is 2^(1/4) wider than the last, so percentiles are within ~10%
+class ProfilerHistogram
+{
+public:
+    static constexpr int BUCKETS_PER_OCTAVE = 4;
+    static constexpr int NUM_BUCKETS = 96; // 1 us to ~14 s
+    static constexpr double MIN_BUCKET_SECONDS = 0.000001;
+
+    void Add( double seconds );
+    void Remove( double seconds );
+    uint GetCount() const { return m_count; };
+
+    // percentile in [0,1], interpolated within the bucket it lands in
+    double GetPercentile( double percentile ) const;
+
+private:
+    static int GetBucketIndex( double seconds );
+    static double GetBucketMinSeconds( int bucketIdx );
+
+private:
+    uint m_buckets[NUM_BUCKETS] = {};
+    uint m_count = 0;
+};
+
+// Rolling stats for one scope over the last window of frames
+// A scope's sample for a frame is the sum of all of its calls in that frame
+class ProfilerScopeStats
+{
+public:
+    ProfilerScopeStats( const String& name, int windowFrames );
+
+    void Accumulate( double seconds );
+    // Pushes this frame's sample into the window, dropping the oldest one
+    void EndFrame();
+
+    // Only frames the scope ran in are counted
+    int GetActiveFrameCount() const { return m_activeFrames; };
+    uint GetCallCount() const { return m_windowCalls; };
+    double GetMin() const;
+    double GetMax() const;
+    double GetMean() const;
+    double GetPercentile( double percentile ) const;
+
+public:
+    String m_name;
+
+private:
+    std::vector<float> m_frameTimes;
+    std::vector<uint> m_frameCalls;
+    int m_nextFrameIdx = 0;
+
+    double m_currentTime = 0;
+    uint m_currentCalls = 0;
+
+    ProfilerHistogram m_histogram;
+    double m_windowTime = 0;
+    uint m_windowCalls = 0;
+    int m_activeFrames = 0;
+};
+
+// Flat per scope min / mean / percentiles / max over the last windowFrames frames
+class ProfilerStats
+{
+public:
+    ProfilerStats( int windowFrames );
+    ~ProfilerStats();
+
+    void AddFrame( Profiler::Measurement* frame );
+
+    int GetWindowFrames() const { return m_windowFrames; };
+    int GetFramesInWindow() const { return m_framesInWindow; };
+
+    // sorted by p99 so the scopes that hitch are on top
+    String ToString();
+
+private:
+    void AccumulateR( Profiler::Measurement* measure );
+
+private:
+    int m_windowFrames = 0;
+    int m_framesInWindow = 0;
+    std::vector<ProfilerScopeStats*> m_scopesById; // indexed by Profiler::ScopeId
+    std::vector<ProfilerScopeStats*> m_allScopes;
+};
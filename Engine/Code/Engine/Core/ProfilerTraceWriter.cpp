@@ -0,0 +1,169 @@
+#include "Engine/Core/ProfilerTraceWriter.hpp"
+
+#include <stdarg.h>
+#include <stdio.h>
+
+namespace
+{
+constexpr int MAIN_THREAD_ID = 0;
+constexpr int MAX_EVENT_LEN = 512;
+
+// trace timestamps are in microseconds
+double ToMicroseconds( double seconds )
+{
+    return seconds * 1000000.0;
+}
+
+// names come from function names and tags, only quotes and slashes need escaping
+void EscapeJson( const char* src, char* dest, int destSize )
+{
+    int destIdx = 0;
+    for( int srcIdx = 0; src[srcIdx] != '\0' && destIdx < destSize - 2; ++srcIdx )
+    {
+        char c = src[srcIdx];
+        if( c == '"' || c == '\\' )
+            dest[destIdx++] = '\\';
+        dest[destIdx++] = c;
+    }
+    dest[destIdx] = '\0';
+}
+
+}
+
+ProfilerTraceWriter::~ProfilerTraceWriter()
+{
+    Close();
+}
+
+bool ProfilerTraceWriter::Open( const String& filePath )
+{
+    Close();
+
+    m_file.open( filePath, std::ios::out | std::ios::trunc );
+    if( m_file.fail() )
+    {
+        m_file.close();
+        return false;
+    }
+
+    m_isFirstEvent = true;
+    m_framesWritten = 0;
+    m_threadIds.clear();
+
+    m_file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    WriteThreadName( MAIN_THREAD_ID, "Main" );
+    return true;
+}
+
+void ProfilerTraceWriter::WriteFrame( Profiler::Measurement* frame )
+{
+    if( !IsOpen() || nullptr == frame )
+        return;
+
+    // frame marker shown across all threads
+    WriteEvent( "{\"name\":\"Frame %i\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":%i,\"ts\":%.3f}",
+                m_framesWritten, MAIN_THREAD_ID, ToMicroseconds( frame->m_startTime ) );
+
+    if( MemoryTracker::IS_ENABLED )
+    {
+        // counter track with the whole frame's allocations
+        MemoryTracker::AllocationCounters allocations = Profiler::GetFrameAllocations( frame );
+        WriteEvent( "{\"name\":\"Frame Allocations\",\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,"
+                    "\"args\":{\"count\":%llu,\"bytes\":%llu}}",
+                    ToMicroseconds( frame->m_startTime ),
+                    allocations.m_count, allocations.m_bytes );
+    }
+
+    WriteMeasurementR( frame, MAIN_THREAD_ID );
+    ++m_framesWritten;
+}
+
+void ProfilerTraceWriter::Close()
+{
+    if( !IsOpen() )
+        return;
+
+    m_file << "\n]}\n";
+    m_file.close();
+}
+
+void ProfilerTraceWriter::WriteMeasurementR( Profiler::Measurement* measure, int threadId )
+{
+    // thread roots only group the scopes of another thread, they are not scopes themselves
+    if( measure->m_isThreadRoot )
+    {
+        threadId = GetThreadId( measure->m_scopeId );
+    }
+    else
+    {
+        char name[MAX_EVENT_LEN];
+        EscapeJson( measure->GetName(), name, MAX_EVENT_LEN );
+        if( MemoryTracker::IS_ENABLED )
+        {
+            WriteEvent( "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%i,\"ts\":%.3f,\"dur\":%.3f,"
+                        "\"args\":{\"allocs\":%llu,\"bytes\":%llu}}",
+                        name, threadId,
+                        ToMicroseconds( measure->m_startTime ),
+                        ToMicroseconds( measure->GetElapsedTime() ),
+                        measure->m_allocations.m_count, measure->m_allocations.m_bytes );
+        }
+        else
+        {
+            WriteEvent( "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%i,\"ts\":%.3f,\"dur\":%.3f}",
+                        name, threadId,
+                        ToMicroseconds( measure->m_startTime ),
+                        ToMicroseconds( measure->GetElapsedTime() ) );
+        }
+    }
+
+    Profiler::Measurement* firstChild = measure->m_firstChild;
+    if( nullptr == firstChild )
+        return;
+
+    Profiler::Measurement* currentChild = firstChild;
+    do
+    {
+        WriteMeasurementR( currentChild, threadId );
+        currentChild = currentChild->m_next;
+    } while( currentChild != firstChild );
+}
+
+void ProfilerTraceWriter::WriteThreadName( int threadId, const char* name )
+{
+    char escapedName[MAX_EVENT_LEN];
+    EscapeJson( name, escapedName, MAX_EVENT_LEN );
+    WriteEvent( "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%i,\"args\":{\"name\":\"%s\"}}",
+                threadId, escapedName );
+}
+
+void ProfilerTraceWriter::WriteEvent( const char* format, ... )
+{
+    char eventStr[MAX_EVENT_LEN * 2];
+
+    va_list args;
+    va_start( args, format );
+    int length = vsnprintf( eventStr, sizeof( eventStr ), format, args );
+    va_end( args );
+
+    if( length < 0 )
+        return;
+    if( length >= (int) sizeof( eventStr ) )
+        length = (int) sizeof( eventStr ) - 1;
+
+    if( !m_isFirstEvent )
+        m_file.write( ",\n", 2 );
+    m_isFirstEvent = false;
+    m_file.write( eventStr, length );
+}
+
+int ProfilerTraceWriter::GetThreadId( Profiler::ScopeId threadNameId )
+{
+    auto found = m_threadIds.find( threadNameId );
+    if( found != m_threadIds.end() )
+        return found->second;
+
+    int threadId = (int) m_threadIds.size() + 1;
+    m_threadIds[threadNameId] = threadId;
+    WriteThreadName( threadId, Profiler::GetScopeName( threadNameId ) );
+    return threadId;
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Profiler.hpp"
+#include <fstream>
+#include <map>
+
+// Streams profiler frames to a Chrome trace event json file,
+// open the result in chrome://tracing or https://ui.perfetto.dev
+class ProfilerTraceWriter
+{
+public:
+    ProfilerTraceWriter() {};
+    ~ProfilerTraceWriter();
+
+    bool Open( const String& filePath );
+
+    // Frames must be written oldest first
+    void WriteFrame( Profiler::Measurement* frame );
+
+    // Finishes the json, the file is not valid until this is called
+    void Close();
+
+    bool IsOpen() { return m_file.is_open(); };
+    int GetFramesWritten() { return m_framesWritten; };
+
+private:
+    void WriteMeasurementR( Profiler::Measurement* measure, int threadId );
+    void WriteThreadName( int threadId, const char* name );
+    void WriteEvent( const char* format, ... );
+    int GetThreadId( Profiler::ScopeId threadNameId );
+
+private:
+    std::ofstream m_file;
+    std::map<Profiler::ScopeId, int> m_threadIds;
+    bool m_isFirstEvent = true;
+    int m_framesWritten = 0;
+};
@@ -0,0 +1,333 @@
+#include "Engine/Core/SpatialHashGrid.hpp"
+#include "Engine/Core/GameObject.hpp"
+#include "Engine/Core/Profiler.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/OBB3.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+#include <algorithm>
+
+namespace
+{
+// distance squared and entry index, max heap on distance
+typedef std::pair<float, uint> NearestCandidate;
+
+void AddNearestCandidate( std::vector<NearestCandidate>& heap, uint count,
+                          const NearestCandidate& candidate )
+{
+    if( heap.size() < count )
+    {
+        heap.push_back( candidate );
+        std::push_heap( heap.begin(), heap.end() );
+    }
+    else if( candidate < heap.front() )
+    {
+        std::pop_heap( heap.begin(), heap.end() );
+        heap.back() = candidate;
+        std::push_heap( heap.begin(), heap.end() );
+    }
+}
+}
+
+size_t SpatialHashGrid::CellHasher::operator()( const IVec3& cell ) const
+{
+    // large primes, spreads neighboring cells across buckets
+    return (size_t) ( (uint) cell.x * 73856093u ^ (uint) cell.y * 19349663u ^ (uint) cell.z * 83492791u );
+}
+
+SpatialHashGrid::SpatialHashGrid( float cellSize /*= 4.f */ )
+{
+    SetCellSize( cellSize );
+}
+
+void SpatialHashGrid::SetCellSize( float cellSize )
+{
+    PROFILER_SCOPED();
+    m_cellSize = cellSize;
+    m_invCellSize = 1.f / cellSize;
+
+    m_cells.clear();
+    m_maxRadius = 0.f;
+    for( uint entryIdx = 0; entryIdx < m_entries.size(); ++entryIdx )
+    {
+        Entry& entry = m_entries[entryIdx];
+        entry.m_cell = GetCell( entry.m_center );
+        m_maxRadius = Maxf( m_maxRadius, entry.m_radius );
+        AddToCell( entryIdx );
+    }
+}
+
+void SpatialHashGrid::Insert( GameObjectHandle handle, const Vec3& center, float radius /*= 0.f */ )
+{
+    if( Contains( handle ) )
+    {
+        Move( handle, center, radius );
+        return;
+    }
+
+    if( handle.m_slotIdx >= m_entryIdxOfSlot.size() )
+        m_entryIdxOfSlot.resize( handle.m_slotIdx + 1, GameObjectHandle::INVALID_SLOT );
+
+    // an older object in the same slot was never removed, it is dead by now
+    uint staleIdx = m_entryIdxOfSlot[handle.m_slotIdx];
+    if( staleIdx != GameObjectHandle::INVALID_SLOT )
+        Remove( m_entries[staleIdx].m_handle );
+
+    uint entryIdx = (uint) m_entries.size();
+    m_entries.emplace_back();
+    Entry& entry = m_entries.back();
+    entry.m_handle = handle;
+    entry.m_center = center;
+    entry.m_radius = radius;
+    entry.m_cell = GetCell( center );
+    m_entryIdxOfSlot[handle.m_slotIdx] = entryIdx;
+    m_maxRadius = Maxf( m_maxRadius, radius );
+    AddToCell( entryIdx );
+}
+
+void SpatialHashGrid::Move( GameObjectHandle handle, const Vec3& center, float radius /*= 0.f */ )
+{
+    if( !Contains( handle ) )
+    {
+        Insert( handle, center, radius );
+        return;
+    }
+
+    uint entryIdx = m_entryIdxOfSlot[handle.m_slotIdx];
+    Entry& entry = m_entries[entryIdx];
+    entry.m_center = center;
+    entry.m_radius = radius;
+    m_maxRadius = Maxf( m_maxRadius, radius );
+
+    IVec3 cell = GetCell( center );
+    if( cell != entry.m_cell )
+    {
+        RemoveFromCell( entryIdx );
+        entry.m_cell = cell;
+        AddToCell( entryIdx );
+    }
+}
+
+void SpatialHashGrid::Remove( GameObjectHandle handle )
+{
+    if( !Contains( handle ) )
+        return;
+
+    uint entryIdx = m_entryIdxOfSlot[handle.m_slotIdx];
+    RemoveFromCell( entryIdx );
+    m_entryIdxOfSlot[handle.m_slotIdx] = GameObjectHandle::INVALID_SLOT;
+
+    // swap the last entry into the hole and point its cell and slot at the new index
+    uint lastIdx = (uint) m_entries.size() - 1;
+    if( entryIdx != lastIdx )
+    {
+        Entry& moved = m_entries[entryIdx];
+        moved = m_entries[lastIdx];
+        m_entryIdxOfSlot[moved.m_handle.m_slotIdx] = entryIdx;
+        m_cells[moved.m_cell][moved.m_idxInCell] = entryIdx;
+    }
+    m_entries.pop_back();
+}
+
+bool SpatialHashGrid::Contains( GameObjectHandle handle ) const
+{
+    if( handle.m_slotIdx >= m_entryIdxOfSlot.size() )
+        return false;
+
+    uint entryIdx = m_entryIdxOfSlot[handle.m_slotIdx];
+    return entryIdx != GameObjectHandle::INVALID_SLOT && m_entries[entryIdx].m_handle == handle;
+}
+
+void SpatialHashGrid::Clear()
+{
+    m_cells.clear();
+    m_entries.clear();
+    m_entryIdxOfSlot.clear();
+    m_maxRadius = 0.f;
+}
+
+void SpatialHashGrid::Insert( const GameObject& gameObject )
+{
+    Vec3 center;
+    float radius;
+    GetBoundingSphere( gameObject, center, radius );
+    Insert( gameObject.GetHandle(), center, radius );
+}
+
+void SpatialHashGrid::Move( const GameObject& gameObject )
+{
+    Vec3 center;
+    float radius;
+    GetBoundingSphere( gameObject, center, radius );
+    Move( gameObject.GetHandle(), center, radius );
+}
+
+void SpatialHashGrid::QueryRadius( const Vec3& center, float radius,
+                                   std::vector<GameObjectHandle>& out_handles ) const
+{
+    float reachDistance = radius + m_maxRadius;
+    Vec3 reach( reachDistance, reachDistance, reachDistance );
+    ForEachInCells( GetCell( center - reach ), GetCell( center + reach ),
+        [&]( const Entry& entry )
+        {
+            float maxDistance = radius + entry.m_radius;
+            if( Vec3::GetDistanceSquared( center, entry.m_center ) <= maxDistance * maxDistance )
+                out_handles.push_back( entry.m_handle );
+        } );
+}
+
+void SpatialHashGrid::QueryAABB3( const AABB3& bounds, std::vector<GameObjectHandle>& out_handles ) const
+{
+    Vec3 reach( m_maxRadius, m_maxRadius, m_maxRadius );
+    ForEachInCells( GetCell( bounds.mins - reach ), GetCell( bounds.maxs + reach ),
+        [&]( const Entry& entry )
+        {
+            if( AABB3::IsOverlapSphere( bounds, entry.m_center, entry.m_radius ) )
+                out_handles.push_back( entry.m_handle );
+        } );
+}
+
+void SpatialHashGrid::QueryNearest( const Vec3& point, uint count,
+                                    std::vector<GameObjectHandle>& out_handles,
+                                    float maxDistance /*= INFINITY */ ) const
+{
+    if( count == 0 || m_entries.empty() )
+        return;
+
+    float maxDistanceSquared = maxDistance * maxDistance;
+    std::vector<NearestCandidate> heap;
+    heap.reserve( std::min( count, (uint) m_entries.size() ) );
+    auto addEntry = [&]( uint entryIdx )
+    {
+        float distanceSquared = Vec3::GetDistanceSquared( point, m_entries[entryIdx].m_center );
+        if( distanceSquared <= maxDistanceSquared )
+            AddNearestCandidate( heap, count, NearestCandidate( distanceSquared, entryIdx ) );
+    };
+
+    // Centers are always in their own cell, so before searching ringIdx anything not found
+    // yet is at least ringIdx - 1 cells away from point
+    IVec3 centerCell = GetCell( point );
+    bool searchAll = false;
+    for( int ringIdx = 0; ; ++ringIdx )
+    {
+        float searchedDistance = (float) ( ringIdx - 1 ) * m_cellSize;
+        if( searchedDistance > maxDistance )
+            break;
+        if( heap.size() == count && searchedDistance >= 0.f
+            && heap.front().first <= searchedDistance * searchedDistance )
+            break;
+
+        // the cube out to this ring has more cells than the grid does
+        uint64 sideCells = 2 * (uint64) ringIdx + 1;
+        if( sideCells * sideCells * sideCells > m_cells.size() )
+        {
+            searchAll = true;
+            break;
+        }
+
+        for( int z = -ringIdx; z <= ringIdx; ++z )
+        {
+            for( int y = -ringIdx; y <= ringIdx; ++y )
+            {
+                // inside the ring only the two x ends are on it
+                bool onShell = abs( z ) == ringIdx || abs( y ) == ringIdx;
+                int xStep = onShell || ringIdx == 0 ? 1 : 2 * ringIdx;
+                for( int x = -ringIdx; x <= ringIdx; x += xStep )
+                {
+                    CellMap::const_iterator cellIter = m_cells.find( centerCell + IVec3( x, y, z ) );
+                    if( cellIter == m_cells.end() )
+                        continue;
+                    for( uint entryIdx : cellIter->second )
+                        addEntry( entryIdx );
+                }
+            }
+        }
+    }
+
+    if( searchAll )
+    {
+        heap.clear();
+        for( uint entryIdx = 0; entryIdx < m_entries.size(); ++entryIdx )
+            addEntry( entryIdx );
+    }
+
+    std::sort_heap( heap.begin(), heap.end() );
+    for( const NearestCandidate& candidate : heap )
+        out_handles.push_back( m_entries[candidate.second].m_handle );
+}
+
+IVec3 SpatialHashGrid::GetCell( const Vec3& position ) const
+{
+    return IVec3( FloorToInt( position.x * m_invCellSize ),
+                  FloorToInt( position.y * m_invCellSize ),
+                  FloorToInt( position.z * m_invCellSize ) );
+}
+
+void SpatialHashGrid::AddToCell( uint entryIdx )
+{
+    Entry& entry = m_entries[entryIdx];
+    std::vector<uint>& cellEntries = m_cells[entry.m_cell];
+    entry.m_idxInCell = (uint) cellEntries.size();
+    cellEntries.push_back( entryIdx );
+}
+
+void SpatialHashGrid::RemoveFromCell( uint entryIdx )
+{
+    Entry& entry = m_entries[entryIdx];
+    CellMap::iterator cellIter = m_cells.find( entry.m_cell );
+    std::vector<uint>& cellEntries = cellIter->second;
+
+    uint lastEntryIdx = cellEntries.back();
+    cellEntries[entry.m_idxInCell] = lastEntryIdx;
+    m_entries[lastEntryIdx].m_idxInCell = entry.m_idxInCell;
+    cellEntries.pop_back();
+
+    if( cellEntries.empty() )
+        m_cells.erase( cellIter );
+}
+
+template <typename Visit>
+void SpatialHashGrid::ForEachInCells( const IVec3& minCell, const IVec3& maxCell, Visit visit ) const
+{
+    uint64 cellCount = (uint64) ( maxCell.x - minCell.x + 1 )
+                     * (uint64) ( maxCell.y - minCell.y + 1 )
+                     * (uint64) ( maxCell.z - minCell.z + 1 );
+    if( cellCount > m_cells.size() )
+    {
+        for( const Entry& entry : m_entries )
+            visit( entry );
+        return;
+    }
+
+    IVec3 cell;
+    for( cell.z = minCell.z; cell.z <= maxCell.z; ++cell.z )
+    {
+        for( cell.y = minCell.y; cell.y <= maxCell.y; ++cell.y )
+        {
+            for( cell.x = minCell.x; cell.x <= maxCell.x; ++cell.x )
+            {
+                CellMap::const_iterator cellIter = m_cells.find( cell );
+                if( cellIter == m_cells.end() )
+                    continue;
+                for( uint entryIdx : cellIter->second )
+                    visit( m_entries[entryIdx] );
+            }
+        }
+    }
+}
+
+void SpatialHashGrid::GetBoundingSphere( const GameObject& gameObject, Vec3& out_center,
+                                         float& out_radius )
+{
+    if( !gameObject.GetRenderable() )
+    {
+        out_center = gameObject.GetTransform().GetWorldPosition();
+        out_radius = 0.f;
+        return;
+    }
+
+    // the OBB is rigid, every corner is half the local diagonal from the center
+    const OBB3 obb = gameObject.GetOBB3();
+    out_center = AABB3::FromTransformedBounds( obb.GetAABB3(), obb.GetLocalToWorld() ).GetCenter();
+    out_radius = 0.5f * obb.GetAABB3().GetDiagonal3D();
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <math.h>
+#include "Engine/Core/Types.hpp"
+#include "Engine/Core/GameObjectManager.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Math/IVec3.hpp"
+
+class AABB3;
+
+// Loose uniform grid hashed by cell, for broadphase and neighbor queries
+// Objects are spheres stored in the one cell their center is in, queries look that much
+// further out to find spheres that hang into the queried cells, so keep the cell size
+// above the typical object diameter
+//
+// Keyed on GameObjectHandle, queries return handles to resolve with the object's manager
+// Queries are const and safe to run from several threads at once, changes are not
+class SpatialHashGrid
+{
+public:
+    explicit SpatialHashGrid( float cellSize = 4.f );
+    ~SpatialHashGrid() {};
+
+    // Re-buckets every object
+    void SetCellSize( float cellSize );
+    float GetCellSize() const { return m_cellSize; };
+
+    // radius 0 for points, inserting a handle that is already in moves it
+    void Insert( GameObjectHandle handle, const Vec3& center, float radius = 0.f );
+    // Only touches the cells when the center crosses into another cell
+    void Move( GameObjectHandle handle, const Vec3& center, float radius = 0.f );
+    void Remove( GameObjectHandle handle );
+    bool Contains( GameObjectHandle handle ) const;
+    void Clear();
+    uint GetObjectCount() const { return (uint) m_entries.size(); };
+
+    // Sphere around the object's GetOBB3, or a point at its position without a renderable
+    void Insert( const GameObject& gameObject );
+    void Move( const GameObject& gameObject );
+
+    // Append the objects whose sphere overlaps the query
+    void QueryRadius( const Vec3& center, float radius,
+                      std::vector<GameObjectHandle>& out_handles ) const;
+    void QueryAABB3( const AABB3& bounds, std::vector<GameObjectHandle>& out_handles ) const;
+    // Append up to count objects by distance from point to their center, closest first
+    void QueryNearest( const Vec3& point, uint count, std::vector<GameObjectHandle>& out_handles,
+                       float maxDistance = INFINITY ) const;
+
+private:
+    struct Entry
+    {
+        GameObjectHandle m_handle;
+        Vec3 m_center;
+        float m_radius = 0.f;
+        IVec3 m_cell;
+        uint m_idxInCell = 0;
+    };
+
+    struct CellHasher
+    {
+        size_t operator()( const IVec3& cell ) const;
+    };
+    // entry indices by cell, cells are erased once empty
+    typedef std::unordered_map<IVec3, std::vector<uint>, CellHasher> CellMap;
+
+    IVec3 GetCell( const Vec3& position ) const;
+    void AddToCell( uint entryIdx );
+    void RemoveFromCell( uint entryIdx );
+    // Calls visit with every entry index in the cells from minCell to maxCell,
+    // or in all entries when that is fewer
+    template <typename Visit>
+    void ForEachInCells( const IVec3& minCell, const IVec3& maxCell, Visit visit ) const;
+    static void GetBoundingSphere( const GameObject& gameObject, Vec3& out_center,
+                                   float& out_radius );
+
+    float m_cellSize = 4.f;
+    float m_invCellSize = 0.25f;
+    // largest radius inserted since the last Clear or SetCellSize, how loose the cells are
+    float m_maxRadius = 0.f;
+
+    CellMap m_cells;
+    std::vector<Entry> m_entries;
+    // entry index by handle slot, INVALID_SLOT for slots not in the grid
+    std::vector<uint> m_entryIdxOfSlot;
+};
@@ -3,6 +3,18 @@
 #include <thread>
 #include <chrono>
 
+#if defined( _WIN32 )
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <string.h>
+#endif
+
 namespace Thread
 {
 
@@ -32,4 +44,78 @@ void ThreadYield()
     std::this_thread::yield();
 }
 
-}
\ No newline at end of file
+bool ThreadSetName( char const *name )
+{
+#if defined( _WIN32 )
+    // SetThreadDescription only exists on windows 10 and later
+    typedef HRESULT( WINAPI *SetThreadDescriptionFunc )( HANDLE, PCWSTR );
+    static SetThreadDescriptionFunc s_setThreadDescription = (SetThreadDescriptionFunc)
+        GetProcAddress( GetModuleHandleA( "kernel32.dll" ), "SetThreadDescription" );
+    if( nullptr == s_setThreadDescription )
+        return false;
+
+    wchar_t wideName[64];
+    MultiByteToWideChar( CP_UTF8, 0, name, -1, wideName, 64 );
+    wideName[63] = 0;
+    return SUCCEEDED( s_setThreadDescription( GetCurrentThread(), wideName ) );
+#else
+    char shortName[16];
+    strncpy( shortName, name, sizeof( shortName ) - 1 );
+    shortName[sizeof( shortName ) - 1] = 0;
+    return pthread_setname_np( pthread_self(), shortName ) == 0;
+#endif
+}
+
+bool ThreadSetCoreAffinity( uint64 coreBitfield )
+{
+    if( coreBitfield == 0 )
+    {
+        for( uint coreIdx = 0; coreIdx < GetCoreCount(); ++coreIdx )
+            coreBitfield |= GetCoreBit( coreIdx );
+    }
+
+#if defined( _WIN32 )
+    return SetThreadAffinityMask( GetCurrentThread(), (DWORD_PTR) coreBitfield ) != 0;
+#else
+    cpu_set_t cpuSet;
+    CPU_ZERO( &cpuSet );
+    for( uint coreIdx = 0; coreIdx < 64; ++coreIdx )
+    {
+        if( coreBitfield & ( 1ull << coreIdx ) )
+            CPU_SET( coreIdx, &cpuSet );
+    }
+    return pthread_setaffinity_np( pthread_self(), sizeof( cpuSet ), &cpuSet ) == 0;
+#endif
+}
+
+bool ThreadSetPriority( ThreadPriority priority )
+{
+#if defined( _WIN32 )
+    int priorities[] = {
+        THREAD_PRIORITY_LOWEST,
+        THREAD_PRIORITY_BELOW_NORMAL,
+        THREAD_PRIORITY_NORMAL,
+        THREAD_PRIORITY_ABOVE_NORMAL,
+        THREAD_PRIORITY_HIGHEST };
+    return SetThreadPriority( GetCurrentThread(), priorities[(int) priority] ) != 0;
+#else
+    // normal threads all share one static priority on linux, but each
+    // thread has its own nice value which the scheduler weighs them by
+    int niceValues[] = { 10, 5, 0, -5, -10 };
+    pid_t threadId = (pid_t) syscall( SYS_gettid );
+    return setpriority( PRIO_PROCESS, threadId, niceValues[(int) priority] ) == 0;
+#endif
+}
+
+uint GetCoreCount()
+{
+    uint coreCount = std::thread::hardware_concurrency();
+    return coreCount > 0 ? coreCount : 1;
+}
+
+uint64 GetCoreBit( uint coreIdx )
+{
+    return coreIdx < 64 ? ( 1ull << coreIdx ) : 0;
+}
+
+}
@@ -32,16 +32,26 @@ void ThreadYield();
 
 
 
-// Debug
-// void ThreadSetName( char const *name );
-
-
-// Future reference
-
-// CoreAffinity -> Which Processor/Core do we prefer to run this thread on;
-// void ThreadSetCoreAffinity( uint core_bitfield );
-// Priority -> How important is it that this thread run (lower means it may be
-// get starved out.  Higher means it could starve others).
-// void ThreadSetPriority( uint priority );
+// Thread settings, these all apply to the calling thread and return false if the OS refused
+enum class ThreadPriority
+{
+    LOWEST,
+    LOW,
+    NORMAL,
+    HIGH,
+    HIGHEST     // may need elevated rights on linux
+};
+
+// Shows up in debuggers and profilers, linux truncates it to 15 characters
+bool ThreadSetName( char const *name );
+// Bit N set allows the thread to run on logical core N, 0 means no restriction
+bool ThreadSetCoreAffinity( uint64 coreBitfield );
+// Lower can starve, higher can starve others
+bool ThreadSetPriority( ThreadPriority priority );
+
+// Logical cores, at least 1
+uint GetCoreCount();
+// Bitfield for a single core, 0 for cores past what the bitfield can hold
+uint64 GetCoreBit( uint coreIdx );
 
-}
\ No newline at end of file
+}
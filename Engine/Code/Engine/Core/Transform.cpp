@@ -25,6 +25,7 @@ void Transform::operator=( const Transform& copyFrom )
 {
     copyFrom.RegenLocalToWorldIfDirty();
 
+    m_rotationMode = copyFrom.m_rotationMode;
     SetParent( copyFrom.m_parent );
 
     SetLocalToParent( copyFrom.GetLocalToParent() );
@@ -35,6 +36,7 @@ void Transform::SetIdentity()
     m_localToParent = Mat4::IDENTITY;
     m_localPosition = Vec3::ZEROS;
     m_localEuler = Vec3::ZEROS;
+    m_localRotation = Quaternion::IDENTITY;
     m_localScale = Vec3::ONES;
     SetLocalToParentDirty( false );
     SetLocalToWorldDirty( true );
@@ -79,7 +81,10 @@ const Mat4& Transform::GetLocalToParent() const
 void Transform::SetLocalToParent( const Mat4& mat )
 {
     m_localToParent = mat;
-    mat.DecomposeToSRT( m_localScale, m_localEuler, m_localPosition );
+    if( m_rotationMode == RotationMode::QUATERNION )
+        mat.DecomposeToSRT( m_localScale, m_localRotation, m_localPosition );
+    else
+        mat.DecomposeToSRT( m_localScale, m_localEuler, m_localPosition );
     SetLocalToParentDirty( false );
     SetLocalToWorldDirty( true );
 }
@@ -172,17 +177,28 @@ void Transform::TranslateWorld( const Vec3& translation )
 
 Vec3 Transform::GetLocalEuler() const
 {
+    if( m_rotationMode == RotationMode::QUATERNION )
+        return m_localRotation.GetEuler();
     return m_localEuler;
 }
 
 void Transform::SetLocalEuler( const Vec3& euler )
 {
-    m_localEuler = euler;
+    if( m_rotationMode == RotationMode::QUATERNION )
+        m_localRotation = Quaternion::MakeFromEuler( euler );
+    else
+        m_localEuler = euler;
     SetLocalToParentDirty( true );
 }
 
 void Transform::RotateLocalEuler( const Vec3& euler )
 {
+    if( m_rotationMode == RotationMode::QUATERNION )
+    {
+        RotateLocal( Quaternion::MakeFromEuler( euler ) );
+        return;
+    }
+
     Mat4 rot = Mat4::MakeRotationEuler( euler );
     SetLocalToParent( GetLocalToParent() * rot );
 
@@ -197,12 +213,19 @@ void Transform::RotateLocalEuler( const Vec3& euler )
 
 Vec3 Transform::GetWorldEuler() const
 {
+    if( m_rotationMode == RotationMode::QUATERNION )
+        return GetWorldRotation().GetEuler();
     RegenWorldSRTIfDirty();
     return m_worldEuler;
 }
 
 void Transform::SetWorldEuler( const Vec3& euler )
 {
+    if( m_rotationMode == RotationMode::QUATERNION )
+    {
+        SetWorldRotation( Quaternion::MakeFromEuler( euler ) );
+        return;
+    }
     if( !HasParent() )
     {
         SetLocalEuler( euler );
@@ -214,10 +237,71 @@ void Transform::SetWorldEuler( const Vec3& euler )
 
 void Transform::RotateWorldEuler( const Vec3& euler )
 {
+    if( m_rotationMode == RotationMode::QUATERNION )
+    {
+        RotateWorld( Quaternion::MakeFromEuler( euler ) );
+        return;
+    }
     Vec3 newWorlEuler = GetWorldEuler() + euler;
     SetWorldEuler( newWorlEuler );
 }
 
+void Transform::SetRotationMode( RotationMode mode )
+{
+    if( mode == m_rotationMode )
+        return;
+
+    if( mode == RotationMode::QUATERNION )
+        m_localRotation = Quaternion::MakeFromEuler( m_localEuler );
+    else
+        m_localEuler = m_localRotation.GetEuler();
+    m_rotationMode = mode;
+}
+
+Quaternion Transform::GetLocalRotation() const
+{
+    if( m_rotationMode == RotationMode::QUATERNION )
+        return m_localRotation;
+    return Quaternion::MakeFromEuler( m_localEuler );
+}
+
+void Transform::SetLocalRotation( const Quaternion& rotation )
+{
+    if( m_rotationMode == RotationMode::QUATERNION )
+        m_localRotation = rotation;
+    else
+        m_localEuler = rotation.GetEuler();
+    SetLocalToParentDirty( true );
+}
+
+void Transform::RotateLocal( const Quaternion& rotation )
+{
+    // renormalize so per frame rotations don't drift
+    SetLocalRotation( ( GetLocalRotation() * rotation ).GetNormalized() );
+}
+
+Quaternion Transform::GetWorldRotation() const
+{
+    if( !HasParent() )
+        return GetLocalRotation();
+    return m_parent->GetWorldRotation() * GetLocalRotation();
+}
+
+void Transform::SetWorldRotation( const Quaternion& rotation )
+{
+    if( !HasParent() )
+    {
+        SetLocalRotation( rotation );
+        return;
+    }
+    SetLocalRotation( m_parent->GetWorldRotation().GetConjugate() * rotation );
+}
+
+void Transform::RotateWorld( const Quaternion& rotation )
+{
+    SetWorldRotation( ( rotation * GetWorldRotation() ).GetNormalized() );
+}
+
 Vec3 Transform::GetLocalScale() const
 {
     return m_localScale;
@@ -294,6 +378,19 @@ void Transform::FaceCamera( const Camera* cam )
     SetWorldEuler( euler );
 }
 
+void Transform::InterpolateLocal( const Transform& from, const Transform& to, float t )
+{
+    m_localPosition = Lerp( from.GetLocalPosition(), to.GetLocalPosition(), t );
+    m_localScale = Lerp( from.GetLocalScale(), to.GetLocalScale(), t );
+
+    Quaternion rotation = Slerp( from.GetLocalRotation(), to.GetLocalRotation(), t );
+    if( m_rotationMode == RotationMode::QUATERNION )
+        m_localRotation = rotation;
+    else
+        m_localEuler = rotation.GetEuler();
+    SetLocalToParentDirty( true );
+}
+
 bool Transform::HasParent() const
 {
     return m_parent != nullptr;
@@ -307,7 +404,9 @@ bool Transform::HasChildren() const
 void Transform::SetParentKeepWorldTransform( Transform* parent )
 {
     // Save world rotation and position
-    Vec3 worldEuler = GetWorldEuler();
+    bool isQuaternion = m_rotationMode == RotationMode::QUATERNION;
+    Quaternion worldRotation = isQuaternion ? GetWorldRotation() : Quaternion::IDENTITY;
+    Vec3 worldEuler = isQuaternion ? Vec3::ZEROS : GetWorldEuler();
     Vec3 worldPosition = GetWorldPosition();
     // Remove from old parent
     if( m_parent )
@@ -315,7 +414,10 @@ void Transform::SetParentKeepWorldTransform( Transform* parent )
 
     // Set world rotation and position back
     m_parent = parent;
-    SetWorldEuler( worldEuler );
+    if( isQuaternion )
+        SetWorldRotation( worldRotation );
+    else
+        SetWorldEuler( worldEuler );
     SetWorldPosition( worldPosition );
 
     // Add to new parent
@@ -358,7 +460,12 @@ void Transform::SetLocalToParentDirty( bool dirty ) const
 
 void Transform::SetLocalToWorldDirty( bool dirty ) const
 {
-    m_localToWorldDirty = true;
+    // a dirty node's whole subtree is already dirty, since a child can only
+    // regenerate after its parent did, so deep trees are walked once per change
+    if( dirty && m_localToWorldDirty )
+        return;
+
+    m_localToWorldDirty = dirty;
     if( dirty )
     {
         SetWorldToLocalDirty( true );
@@ -398,7 +505,10 @@ void Transform::RegenLocalToParentIfDirty() const
 {
     if( m_localToParentDirty )
     {
-        m_localToParent = Mat4::MakeFromSRT( m_localScale, m_localEuler, m_localPosition );
+        if( m_rotationMode == RotationMode::QUATERNION )
+            m_localToParent = Mat4::MakeFromSRT( m_localScale, m_localRotation, m_localPosition );
+        else
+            m_localToParent = Mat4::MakeFromSRT( m_localScale, m_localEuler, m_localPosition );
         SetLocalToParentDirty( false );
     }
 }
@@ -407,6 +517,7 @@ void Transform::RegenWorldSRTIfDirty() const
 {
     if( m_worldSRTDirty )
     {
+        RegenLocalToWorldIfDirty();
         m_localToWorld.DecomposeToSRT( m_worldScale, m_worldEuler, m_worldPosition );
         SetLocalToWorldSRTDirty( false );
     }
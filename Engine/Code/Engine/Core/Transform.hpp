@@ -1,9 +1,15 @@
 #pragma once
 #include "Engine/Math/Vec3.hpp"
 #include "Engine/Math/Mat4.hpp"
+#include "Engine/Math/Quaternion.hpp"
 
 class Camera;
 
+enum class RotationMode
+{
+    EULER,      // euler angles are the source of truth, world rotations add angles
+    QUATERNION  // quaternion is the source of truth, euler getters convert on demand
+};
 
 class Transform
 {
@@ -59,6 +65,21 @@ public:
     void SetWorldEuler( const Vec3& euler );
     void RotateWorldEuler( const Vec3& euler );
 
+    // Switching keeps the current rotation
+    RotationMode GetRotationMode() const { return m_rotationMode; };
+    void SetRotationMode( RotationMode mode );
+
+    // Work in either mode, cheapest in QUATERNION mode
+    Quaternion GetLocalRotation() const;
+    void SetLocalRotation( const Quaternion& rotation );
+    // Rotation is applied in local space, after the current rotation
+    void RotateLocal( const Quaternion& rotation );
+
+    Quaternion GetWorldRotation() const;
+    void SetWorldRotation( const Quaternion& rotation );
+    // Rotation is applied in world space, after the current rotation
+    void RotateWorld( const Quaternion& rotation );
+
     // Scale
     Vec3 GetLocalScale() const;
     void SetLocalScale( const Vec3& scale );
@@ -68,13 +89,18 @@ public:
     void LookAt( const Vec3& target, const Vec3& worldUp = Vec3::UP );
     void FaceCamera( const Camera* cam );
 
+    // Sets local position, rotation and scale between from and to, rotation is slerped
+    void InterpolateLocal( const Transform& from, const Transform& to, float t );
+
 
     //-----------------------------------------------------------------------------------
     // Transform tree
     bool HasParent() const;
     bool HasChildren() const;
     Transform* GetParent() { return m_parent; };
+    const Transform* GetParent() const { return m_parent; };
     std::vector<Transform*>& GetChildren() { return m_children; };
+    const std::vector<Transform*>& GetChildren() const { return m_children; };
     // parent can be null
     void SetParentKeepWorldTransform( Transform* parent );
     void SetParent( Transform* parent );
@@ -117,6 +143,10 @@ private:
     Vec3 m_localEuler = Vec3::ZEROS;
     Vec3 m_localScale = Vec3::ONES;
 
+    // only used in QUATERNION mode, m_localEuler is stale then
+    RotationMode m_rotationMode = RotationMode::EULER;
+    Quaternion m_localRotation = Quaternion::IDENTITY;
+
     mutable bool m_worldSRTDirty = false;
     mutable Vec3 m_worldPosition = Vec3::ZEROS;
     mutable Vec3 m_worldEuler = Vec3::ZEROS;
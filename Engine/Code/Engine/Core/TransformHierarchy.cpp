@@ -0,0 +1,294 @@
+#include "Engine/Core/TransformHierarchy.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/Profiler.hpp"
+#include "Engine/Core/ErrorUtils.hpp"
+
+#include <string.h>
+
+TransformNodeId TransformHierarchy::CreateNode( TransformNodeId parent /*= INVALID_NODE */ )
+{
+    TransformNodeId node;
+    if( !m_freeNodeIds.empty() )
+    {
+        node = m_freeNodeIds.back();
+        m_freeNodeIds.pop_back();
+    }
+    else
+    {
+        node = (TransformNodeId) m_idxOfNode.size();
+        m_idxOfNode.push_back( INVALID_NODE );
+    }
+
+    uint idx = (uint) m_nodeIds.size();
+    m_idxOfNode[node] = idx;
+    m_nodeIds.push_back( node );
+    m_parentIdxs.push_back( IsValid( parent ) ? m_idxOfNode[parent] : INVALID_NODE );
+    m_localPositions.push_back( Vec3::ZEROS );
+    m_localEulers.push_back( Vec3::ZEROS );
+    m_localScales.push_back( Vec3::ONES );
+    m_localToWorlds.push_back( Mat4::IDENTITY );
+    m_isDirty.push_back( 1 );
+
+    m_isOrderDirty = true;
+    return node;
+}
+
+void TransformHierarchy::DestroyNode( TransformNodeId node )
+{
+    if( !IsValid( node ) )
+        return;
+
+    uint idx = m_idxOfNode[node];
+    uint lastIdx = (uint) m_nodeIds.size() - 1;
+
+    // one pass orphans the children and points the last node's children at its new index
+    for( uint childIdx = 0; childIdx <= lastIdx; ++childIdx )
+    {
+        if( m_parentIdxs[childIdx] == idx )
+        {
+            m_localToWorlds[childIdx].DecomposeToSRT( m_localScales[childIdx],
+                                                      m_localEulers[childIdx],
+                                                      m_localPositions[childIdx] );
+            m_parentIdxs[childIdx] = INVALID_NODE;
+            m_isDirty[childIdx] = 1;
+        }
+        else if( m_parentIdxs[childIdx] == lastIdx )
+        {
+            m_parentIdxs[childIdx] = idx;
+        }
+    }
+
+    // swap and pop, the order is fixed by the next sort
+    if( idx != lastIdx )
+    {
+        m_nodeIds[idx] = m_nodeIds[lastIdx];
+        m_parentIdxs[idx] = m_parentIdxs[lastIdx];
+        m_localPositions[idx] = m_localPositions[lastIdx];
+        m_localEulers[idx] = m_localEulers[lastIdx];
+        m_localScales[idx] = m_localScales[lastIdx];
+        m_localToWorlds[idx] = m_localToWorlds[lastIdx];
+        m_isDirty[idx] = m_isDirty[lastIdx];
+        m_idxOfNode[m_nodeIds[idx]] = idx;
+    }
+    m_nodeIds.pop_back();
+    m_parentIdxs.pop_back();
+    m_localPositions.pop_back();
+    m_localEulers.pop_back();
+    m_localScales.pop_back();
+    m_localToWorlds.pop_back();
+    m_isDirty.pop_back();
+
+    m_idxOfNode[node] = INVALID_NODE;
+    m_freeNodeIds.push_back( node );
+    m_isOrderDirty = true;
+}
+
+bool TransformHierarchy::IsValid( TransformNodeId node ) const
+{
+    return node < m_idxOfNode.size() && m_idxOfNode[node] != INVALID_NODE;
+}
+
+void TransformHierarchy::SetParent( TransformNodeId node, TransformNodeId parent )
+{
+    uint idx = m_idxOfNode[node];
+    uint parentIdx = IsValid( parent ) ? m_idxOfNode[parent] : INVALID_NODE;
+
+    // a node can't be moved under its own subtree
+    for( uint ancestorIdx = parentIdx; ancestorIdx != INVALID_NODE;
+         ancestorIdx = m_parentIdxs[ancestorIdx] )
+    {
+        if( ancestorIdx == idx )
+        {
+            ERROR_RECOVERABLE( "TransformHierarchy::SetParent would make a cycle" );
+            return;
+        }
+    }
+
+    m_parentIdxs[idx] = parentIdx;
+    m_isDirty[idx] = 1;
+    m_isOrderDirty = true;
+}
+
+TransformNodeId TransformHierarchy::GetParent( TransformNodeId node ) const
+{
+    uint parentIdx = m_parentIdxs[m_idxOfNode[node]];
+    return parentIdx == INVALID_NODE ? INVALID_NODE : m_nodeIds[parentIdx];
+}
+
+const Vec3& TransformHierarchy::GetLocalPosition( TransformNodeId node ) const
+{
+    return m_localPositions[m_idxOfNode[node]];
+}
+
+const Vec3& TransformHierarchy::GetLocalEuler( TransformNodeId node ) const
+{
+    return m_localEulers[m_idxOfNode[node]];
+}
+
+const Vec3& TransformHierarchy::GetLocalScale( TransformNodeId node ) const
+{
+    return m_localScales[m_idxOfNode[node]];
+}
+
+void TransformHierarchy::SetLocalPosition( TransformNodeId node, const Vec3& position )
+{
+    m_localPositions[m_idxOfNode[node]] = position;
+    MarkDirty( node );
+}
+
+void TransformHierarchy::SetLocalEuler( TransformNodeId node, const Vec3& euler )
+{
+    m_localEulers[m_idxOfNode[node]] = euler;
+    MarkDirty( node );
+}
+
+void TransformHierarchy::SetLocalScale( TransformNodeId node, const Vec3& scale )
+{
+    m_localScales[m_idxOfNode[node]] = scale;
+    MarkDirty( node );
+}
+
+void TransformHierarchy::SetLocalSRT( TransformNodeId node, const Vec3& scale,
+                                      const Vec3& euler, const Vec3& position )
+{
+    uint idx = m_idxOfNode[node];
+    m_localScales[idx] = scale;
+    m_localEulers[idx] = euler;
+    m_localPositions[idx] = position;
+    MarkDirty( node );
+}
+
+const Mat4& TransformHierarchy::GetLocalToWorld( TransformNodeId node ) const
+{
+    return m_localToWorlds[m_idxOfNode[node]];
+}
+
+Vec3 TransformHierarchy::GetWorldPosition( TransformNodeId node ) const
+{
+    return Vec3( GetLocalToWorld( node ).T );
+}
+
+void TransformHierarchy::UpdateWorldMatrices()
+{
+    PROFILER_SCOPED();
+
+    if( m_isOrderDirty )
+        SortByDepth();
+
+    // depths run in order, a depth only reads matrices and flags of the one before it
+    for( uint depth = 0; depth + 1 < m_depthStartIdxs.size(); ++depth )
+    {
+        uint startIdx = m_depthStartIdxs[depth];
+        uint endIdx = m_depthStartIdxs[depth + 1];
+        JobSystem::ParallelFor( (int) ( endIdx - startIdx ), [this, startIdx]( int start, int end ) {
+            UpdateDepth( startIdx + start, startIdx + end );
+        }, PARALLEL_UPDATE_GRAIN );
+    }
+
+    if( !m_isDirty.empty() )
+        memset( m_isDirty.data(), 0, m_isDirty.size() );
+}
+
+void TransformHierarchy::SortByDepth()
+{
+    PROFILER_SCOPED();
+
+    uint nodeCount = (uint) m_nodeIds.size();
+
+    // the arrays can be in any order here, walk up until a known depth
+    std::vector<uint> depths( nodeCount, INVALID_NODE );
+    uint maxDepth = 0;
+    for( uint idx = 0; idx < nodeCount; ++idx )
+    {
+        uint walkIdx = idx;
+        uint steps = 0;
+        while( depths[walkIdx] == INVALID_NODE && m_parentIdxs[walkIdx] != INVALID_NODE )
+        {
+            walkIdx = m_parentIdxs[walkIdx];
+            ++steps;
+        }
+        uint depth = ( depths[walkIdx] == INVALID_NODE ? 0 : depths[walkIdx] ) + steps;
+        for( walkIdx = idx; depths[walkIdx] == INVALID_NODE; walkIdx = m_parentIdxs[walkIdx] )
+        {
+            depths[walkIdx] = depth--;
+            if( m_parentIdxs[walkIdx] == INVALID_NODE )
+                break;
+        }
+        if( depths[idx] > maxDepth )
+            maxDepth = depths[idx];
+    }
+
+    // counting sort keeps the existing order within a depth
+    m_depthStartIdxs.assign( nodeCount > 0 ? maxDepth + 2 : 1, 0 );
+    for( uint idx = 0; idx < nodeCount; ++idx )
+    {
+        ++m_depthStartIdxs[depths[idx] + 1];
+    }
+    for( uint depth = 1; depth < m_depthStartIdxs.size(); ++depth )
+    {
+        m_depthStartIdxs[depth] += m_depthStartIdxs[depth - 1];
+    }
+
+    std::vector<uint> newIdxs( nodeCount );
+    std::vector<uint> nextIdxs( m_depthStartIdxs.begin(), m_depthStartIdxs.end() - 1 );
+    for( uint idx = 0; idx < nodeCount; ++idx )
+    {
+        newIdxs[idx] = nextIdxs[depths[idx]]++;
+    }
+
+    std::vector<TransformNodeId> nodeIds( nodeCount );
+    std::vector<uint> parentIdxs( nodeCount );
+    std::vector<Vec3> localPositions( nodeCount );
+    std::vector<Vec3> localEulers( nodeCount );
+    std::vector<Vec3> localScales( nodeCount );
+    std::vector<Mat4> localToWorlds( nodeCount );
+    std::vector<uchar> isDirty( nodeCount );
+    for( uint idx = 0; idx < nodeCount; ++idx )
+    {
+        uint newIdx = newIdxs[idx];
+        uint parentIdx = m_parentIdxs[idx];
+        nodeIds[newIdx] = m_nodeIds[idx];
+        parentIdxs[newIdx] = parentIdx == INVALID_NODE ? INVALID_NODE : newIdxs[parentIdx];
+        localPositions[newIdx] = m_localPositions[idx];
+        localEulers[newIdx] = m_localEulers[idx];
+        localScales[newIdx] = m_localScales[idx];
+        localToWorlds[newIdx] = m_localToWorlds[idx];
+        isDirty[newIdx] = m_isDirty[idx];
+        m_idxOfNode[m_nodeIds[idx]] = newIdx;
+    }
+    m_nodeIds.swap( nodeIds );
+    m_parentIdxs.swap( parentIdxs );
+    m_localPositions.swap( localPositions );
+    m_localEulers.swap( localEulers );
+    m_localScales.swap( localScales );
+    m_localToWorlds.swap( localToWorlds );
+    m_isDirty.swap( isDirty );
+
+    m_isOrderDirty = false;
+}
+
+void TransformHierarchy::UpdateDepth( uint startIdx, uint endIdx )
+{
+    for( uint idx = startIdx; idx < endIdx; ++idx )
+    {
+        uint parentIdx = m_parentIdxs[idx];
+        bool hasParent = parentIdx != INVALID_NODE;
+        if( hasParent && m_isDirty[parentIdx] )
+            m_isDirty[idx] = 1;
+        if( !m_isDirty[idx] )
+            continue;
+
+        Mat4 localToParent = Mat4::MakeFromSRT( m_localScales[idx], m_localEulers[idx],
+                                                m_localPositions[idx] );
+        if( hasParent )
+            m_localToWorlds[idx] = m_localToWorlds[parentIdx] * localToParent;
+        else
+            m_localToWorlds[idx] = localToParent;
+    }
+}
+
+void TransformHierarchy::MarkDirty( TransformNodeId node )
+{
+    // children pick it up from their parent during the update, no need to walk them
+    m_isDirty[m_idxOfNode[node]] = 1;
+}
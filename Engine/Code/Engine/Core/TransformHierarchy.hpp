@@ -0,0 +1,77 @@
+#pragma once
+#include <vector>
+#include "Engine/Core/Types.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Math/Mat4.hpp"
+
+typedef uint TransformNodeId;
+
+// Transform tree stored as parallel arrays sorted by depth, so every parent comes
+// before its children and one linear pass rebuilds all dirty world matrices
+// Nodes of the same depth don't depend on each other and are split across the JobSystem
+//
+// Node ids stay the same when the arrays are re-sorted, world matrices are only
+// valid as of the last UpdateWorldMatrices
+// Not thread safe, change nodes from one thread and outside of UpdateWorldMatrices
+//
+// Standalone, Transform and GameObject don't use it and still update their trees recursively
+// The owner creates the nodes and calls UpdateWorldMatrices once a frame
+class TransformHierarchy
+{
+public:
+    static constexpr TransformNodeId INVALID_NODE = 0xffffffff;
+
+    // Fewest nodes of one depth handed to one job
+    static constexpr int PARALLEL_UPDATE_GRAIN = 256;
+
+    TransformHierarchy() {};
+    ~TransformHierarchy() {};
+
+    TransformNodeId CreateNode( TransformNodeId parent = INVALID_NODE );
+    // Children become roots and keep their last world transform
+    void DestroyNode( TransformNodeId node );
+    bool IsValid( TransformNodeId node ) const;
+    uint GetNodeCount() const { return (uint) m_nodeIds.size(); };
+
+    // Keeps the local transform, parent can be INVALID_NODE
+    void SetParent( TransformNodeId node, TransformNodeId parent );
+    TransformNodeId GetParent( TransformNodeId node ) const;
+
+    // Local to parent, roll first, then pitch, then yaw like Transform
+    const Vec3& GetLocalPosition( TransformNodeId node ) const;
+    const Vec3& GetLocalEuler( TransformNodeId node ) const;
+    const Vec3& GetLocalScale( TransformNodeId node ) const;
+    void SetLocalPosition( TransformNodeId node, const Vec3& position );
+    void SetLocalEuler( TransformNodeId node, const Vec3& euler );
+    void SetLocalScale( TransformNodeId node, const Vec3& scale );
+    void SetLocalSRT( TransformNodeId node, const Vec3& scale, const Vec3& euler,
+                      const Vec3& position );
+
+    const Mat4& GetLocalToWorld( TransformNodeId node ) const;
+    Vec3 GetWorldPosition( TransformNodeId node ) const;
+
+    // Re-sorts if the tree changed, then rebuilds dirty nodes and everything below them
+    void UpdateWorldMatrices();
+
+private:
+    void SortByDepth();
+    void UpdateDepth( uint startIdx, uint endIdx );
+    void MarkDirty( TransformNodeId node );
+
+    // node id to array index, INVALID_NODE for destroyed ids
+    std::vector<uint> m_idxOfNode;
+    std::vector<TransformNodeId> m_freeNodeIds;
+
+    // indexed by array index
+    std::vector<TransformNodeId> m_nodeIds;
+    std::vector<uint> m_parentIdxs;     // INVALID_NODE for roots
+    std::vector<Vec3> m_localPositions;
+    std::vector<Vec3> m_localEulers;
+    std::vector<Vec3> m_localScales;
+    std::vector<Mat4> m_localToWorlds;
+    std::vector<uchar> m_isDirty;
+
+    // first index of every depth followed by the node count, rebuilt by SortByDepth
+    std::vector<uint> m_depthStartIdxs;
+    bool m_isOrderDirty = false;
+};
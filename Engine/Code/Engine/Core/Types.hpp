@@ -12,5 +12,7 @@ typedef std::vector<double> Doubles;
 typedef std::vector<unsigned int> Uints;
 
 typedef unsigned int uint;
+typedef unsigned long long uint64;
+typedef long long int64;
 typedef unsigned char uchar;
 typedef char Byte;
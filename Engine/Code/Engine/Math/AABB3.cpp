@@ -5,6 +5,7 @@
 #include "Engine/Core/StringUtils.hpp"
 #include "Engine/Renderer/MeshBuilder.hpp"
 #include "Engine/Math/Mat4.hpp"
+#include "Engine/Math/Mat4Kernels.hpp"
 
 const AABB3 AABB3::ZEROS_ONES = AABB3( 0, 0, 0, 1, 1, 1 );
 
@@ -48,17 +49,42 @@ AABB3 AABB3::FromMeshBuilder( const MeshBuilder& meshBuilder, const Mat4& transf
 {
     AABB3 bounds{};
     bool useTransform = ( transform != Mat4::IDENTITY );
-    uint vertCount = meshBuilder.GetVertCount();
-    for( uint vertIdx = 0; vertIdx < vertCount; ++vertIdx )
+    int vertCount = (int) meshBuilder.GetVertCount();
+    if( !useTransform )
     {
-        Vec3 pos = meshBuilder.GetVertex( vertIdx ).m_position;
-        if( useTransform )
-            pos = transform.TransformPosition( pos );
-        bounds.StretchToIncludePoint( pos );
+        for( int vertIdx = 0; vertIdx < vertCount; ++vertIdx )
+            bounds.StretchToIncludePoint( meshBuilder.GetVertex( vertIdx ).m_position );
+        return bounds;
+    }
+
+    // transform a block at a time into a small buffer instead of one vert at a time
+    constexpr int BLOCK_SIZE = 256;
+    Vec3 positions[BLOCK_SIZE];
+    for( int blockStart = 0; blockStart < vertCount; blockStart += BLOCK_SIZE )
+    {
+        int blockCount = vertCount - blockStart < BLOCK_SIZE ? vertCount - blockStart : BLOCK_SIZE;
+        const VertexBuilderData& first = meshBuilder.GetVertex( blockStart );
+        Mat4Kernels::TransformPositionsStrided( transform.el, first.m_position.el,
+                                                sizeof( VertexBuilderData ), positions[0].el,
+                                                sizeof( Vec3 ), blockCount );
+        for( int idx = 0; idx < blockCount; ++idx )
+            bounds.StretchToIncludePoint( positions[idx] );
     }
     return bounds;
 }
 
+AABB3 AABB3::FromTransformedBounds( const AABB3& bounds, const Mat4& transform )
+{
+    Vec3 corners[8];
+    bounds.GetCorners( corners );
+    transform.TransformPositions( corners, corners, 8 );
+
+    AABB3 transformedBounds;
+    for( const Vec3& corner : corners )
+        transformedBounds.StretchToIncludePoint( corner );
+    return transformedBounds;
+}
+
 void AABB3::StretchToIncludePoint( const Vec3& point )
 {
     mins = Min( mins, point );
@@ -306,6 +332,12 @@ bool AABB3::IsOverlap( const AABB3& a, const AABB3& b )
     return overlapHorizontal && overlapVertical && overlapDepth;
 }
 
+bool AABB3::IsOverlapSphere( const AABB3& bounds, const Vec3& center, float radius )
+{
+    Vec3 closest = Min( Max( center, bounds.mins ), bounds.maxs );
+    return Vec3::GetDistanceSquared( center, closest ) <= radius * radius;
+}
+
 AABB3 AABB3::MakeBoundsFromDimensions( const Vec3& dimensions )
 {
     return AABB3( Vec3::ZEROS, dimensions );
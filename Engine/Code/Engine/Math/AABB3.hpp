@@ -29,6 +29,8 @@ public:
     explicit AABB3( const Vec3& center, float width, float height, float depth );
 
     static AABB3 FromMeshBuilder( const MeshBuilder& meshBuilder, const Mat4& transform );
+    // Bounds around the 8 corners of bounds moved by transform
+    static AABB3 FromTransformedBounds( const AABB3& bounds, const Mat4& transform );
 
     // Mutators:
     void StretchToIncludePoint( const Vec3& point ); // note: stretch, not move
@@ -81,6 +83,7 @@ public:
 
     // static functions
     static bool IsOverlap( const AABB3& a, const AABB3& b );
+    static bool IsOverlapSphere( const AABB3& bounds, const Vec3& center, float radius );
     static AABB3 MakeBoundsFromDimensions( const Vec3& dimensions );
     static AABB3 MakeBoundsFromDimensions( const IVec3& dimensions );
 
@@ -1,6 +1,7 @@
 #include "Engine/Math/Frustum.hpp"
 #include "Engine/Math/Vec3.hpp"
 #include "Engine/Math/Vec4.hpp"
+#include "Engine/Math/SIMD.hpp"
 
 Frustum Frustum::FromMatrixAABB3(
     const Mat4& mat4, const AABB3& ndc /*= AABB3( Vec3::ZEROS, 2, 2, 2 ) */ )
@@ -39,3 +40,82 @@ Frustum Frustum::FromMatrixAABB3(
 
     return frustum;
 }
+
+int Frustum::CullSpheres( const float* centersX, const float* centersY, const float* centersZ,
+                          const float* radii, uchar* out_isVisible, int count ) const
+{
+    // a view projection that mirrors space turns the planes inside out, point them away
+    // from the middle so the test works either way
+    Vec3 middle = Vec3::ZEROS;
+    for( const Vec3& corner : m_worldCorners )
+        middle += corner;
+    middle *= 1.f / 8.f;
+
+    Plane planes[6];
+    for( int planeIdx = 0; planeIdx < 6; ++planeIdx )
+    {
+        planes[planeIdx] = m_planes[planeIdx];
+        if( planes[planeIdx].GetDistance( middle ) > 0.f )
+            planes[planeIdx].FlipNormal();
+    }
+
+    int visibleCount = 0;
+    int idx = 0;
+
+#if defined( ENGINE_SIMD_SSE )
+    __m128 normalsX[6];
+    __m128 normalsY[6];
+    __m128 normalsZ[6];
+    __m128 distances[6];
+    for( int planeIdx = 0; planeIdx < 6; ++planeIdx )
+    {
+        normalsX[planeIdx] = _mm_set1_ps( planes[planeIdx].normal.x );
+        normalsY[planeIdx] = _mm_set1_ps( planes[planeIdx].normal.y );
+        normalsZ[planeIdx] = _mm_set1_ps( planes[planeIdx].normal.z );
+        distances[planeIdx] = _mm_set1_ps( planes[planeIdx].distance );
+    }
+
+    for( ; idx + 4 <= count; idx += 4 )
+    {
+        __m128 x = _mm_loadu_ps( centersX + idx );
+        __m128 y = _mm_loadu_ps( centersY + idx );
+        __m128 z = _mm_loadu_ps( centersZ + idx );
+        __m128 radius = _mm_loadu_ps( radii + idx );
+
+        __m128 outside = _mm_setzero_ps();
+        for( int planeIdx = 0; planeIdx < 6; ++planeIdx )
+        {
+            __m128 distance = _mm_add_ps( _mm_mul_ps( x, normalsX[planeIdx] ),
+                                          _mm_mul_ps( y, normalsY[planeIdx] ) );
+            distance = _mm_add_ps( distance, _mm_mul_ps( z, normalsZ[planeIdx] ) );
+            distance = _mm_sub_ps( distance, distances[planeIdx] );
+            outside = _mm_or_ps( outside, _mm_cmpgt_ps( distance, radius ) );
+        }
+
+        int outsideBits = _mm_movemask_ps( outside );
+        for( int lane = 0; lane < 4; ++lane )
+        {
+            uchar isVisible = ( outsideBits & ( 1 << lane ) ) == 0;
+            out_isVisible[idx + lane] = isVisible;
+            visibleCount += isVisible;
+        }
+    }
+#endif
+
+    for( ; idx < count; ++idx )
+    {
+        uchar isVisible = 1;
+        for( const Plane& plane : planes )
+        {
+            float distance = centersX[idx] * plane.normal.x + centersY[idx] * plane.normal.y;
+            distance = distance + centersZ[idx] * plane.normal.z;
+            distance = distance - plane.distance;
+            if( distance > radii[idx] )
+                isVisible = 0;
+        }
+        out_isVisible[idx] = isVisible;
+        visibleCount += isVisible;
+    }
+
+    return visibleCount;
+}
@@ -22,6 +22,13 @@ public:
 
     const Vec3* GetCorners() const { return m_worldCorners; };
 
+    // Bounding spheres come as separate x, y, z and radius arrays
+    // Sets out_isVisible to 0 for spheres fully outside one of the planes and 1 for the rest,
+    // spheres just past an edge of the frustum can be kept, returns how many were kept
+    // Runs 4 spheres at a time with SSE
+    int CullSpheres( const float* centersX, const float* centersY, const float* centersZ,
+                     const float* radii, uchar* out_isVisible, int count ) const;
+
 private:
     //disable VS warning
 #pragma warning(disable : 4201)
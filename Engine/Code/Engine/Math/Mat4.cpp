@@ -4,6 +4,8 @@
 #include "Engine/Math/Vec3.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Math/Plane.hpp"
+#include "Engine/Math/Quaternion.hpp"
+#include "Engine/Math/Mat4Kernels.hpp"
 #include "Engine/Core/StringUtils.hpp"
 
 const Mat4 Mat4::IDENTITY = Mat4();
@@ -82,6 +84,11 @@ Mat4 Mat4::MakeRotationEuler( Vec3 euler )
     return MakeRotationEuler( euler.y, euler.x, euler.z );
 }
 
+Mat4 Mat4::MakeRotation( const Quaternion& rotation )
+{
+    return rotation.GetRotationMatrix();
+}
+
 void Mat4::operator=( const Mat4& copyFrom )
 {
     std::memcpy( this, &copyFrom, sizeof( float ) * 16 );
@@ -95,27 +102,7 @@ const Mat4 Mat4::operator*( const Mat4& rhs )  const
     //  Iw Jw Kw Tw     Iw Jw Kw Tw
 
     Mat4 result;
-
-    result.Ix = ( Ix * rhs.Ix ) + ( Jx * rhs.Iy ) + ( Kx * rhs.Iz ) + ( Tx * rhs.Iw );
-    result.Iy = ( Iy * rhs.Ix ) + ( Jy * rhs.Iy ) + ( Ky * rhs.Iz ) + ( Ty * rhs.Iw );
-    result.Iz = ( Iz * rhs.Ix ) + ( Jz * rhs.Iy ) + ( Kz * rhs.Iz ) + ( Tz * rhs.Iw );
-    result.Iw = ( Iw * rhs.Ix ) + ( Jw * rhs.Iy ) + ( Kw * rhs.Iz ) + ( Tw * rhs.Iw );
-
-    result.Jx = ( Ix * rhs.Jx ) + ( Jx * rhs.Jy ) + ( Kx * rhs.Jz ) + ( Tx * rhs.Jw );
-    result.Jy = ( Iy * rhs.Jx ) + ( Jy * rhs.Jy ) + ( Ky * rhs.Jz ) + ( Ty * rhs.Jw );
-    result.Jz = ( Iz * rhs.Jx ) + ( Jz * rhs.Jy ) + ( Kz * rhs.Jz ) + ( Tz * rhs.Jw );
-    result.Jw = ( Iw * rhs.Jx ) + ( Jw * rhs.Jy ) + ( Kw * rhs.Jz ) + ( Tw * rhs.Jw );
-
-    result.Kx = ( Ix * rhs.Kx ) + ( Jx * rhs.Ky ) + ( Kx * rhs.Kz ) + ( Tx * rhs.Kw );
-    result.Ky = ( Iy * rhs.Kx ) + ( Jy * rhs.Ky ) + ( Ky * rhs.Kz ) + ( Ty * rhs.Kw );
-    result.Kz = ( Iz * rhs.Kx ) + ( Jz * rhs.Ky ) + ( Kz * rhs.Kz ) + ( Tz * rhs.Kw );
-    result.Kw = ( Iw * rhs.Kx ) + ( Jw * rhs.Ky ) + ( Kw * rhs.Kz ) + ( Tw * rhs.Kw );
-
-    result.Tx = ( Ix * rhs.Tx ) + ( Jx * rhs.Ty ) + ( Kx * rhs.Tz ) + ( Tx * rhs.Tw );
-    result.Ty = ( Iy * rhs.Tx ) + ( Jy * rhs.Ty ) + ( Ky * rhs.Tz ) + ( Ty * rhs.Tw );
-    result.Tz = ( Iz * rhs.Tx ) + ( Jz * rhs.Ty ) + ( Kz * rhs.Tz ) + ( Tz * rhs.Tw );
-    result.Tw = ( Iw * rhs.Tx ) + ( Jw * rhs.Ty ) + ( Kw * rhs.Tz ) + ( Tw * rhs.Tw );
-
+    Mat4Kernels::Multiply( el, rhs.el, result.el );
     return result;
 }
 
@@ -132,10 +119,7 @@ const Vec4 Mat4::operator*( const Vec4& rhs ) const
     //  Iz Jz Kz Tz     z
     //  Iw Jw Kw Tw     w
     Vec4 result;
-    result.x = ( Ix * rhs.x ) + ( Jx * rhs.y ) + ( Kx * rhs.z ) + ( Tx * rhs.w );
-    result.y = ( Iy * rhs.x ) + ( Jy * rhs.y ) + ( Ky * rhs.z ) + ( Ty * rhs.w );
-    result.z = ( Iz * rhs.x ) + ( Jz * rhs.y ) + ( Kz * rhs.z ) + ( Tz * rhs.w );
-    result.w = ( Iw * rhs.x ) + ( Jw * rhs.y ) + ( Kw * rhs.z ) + ( Tw * rhs.w );
+    Mat4Kernels::Transform( el, &rhs.x, &result.x );
     return result;
 }
 
@@ -152,150 +136,7 @@ bool Mat4::operator!=( const Mat4& rhs ) const
 
 bool Mat4::Invert()
 {
-
-    float inv[16], det;
-    int i;
-
-    inv[0] =
-        el[5] * el[10] * el[15] -
-        el[5] * el[11] * el[14] -
-        el[9] * el[6] * el[15] +
-        el[9] * el[7] * el[14] +
-        el[13] * el[6] * el[11] -
-        el[13] * el[7] * el[10];
-
-    inv[4] =
-        -el[4] * el[10] * el[15] +
-        el[4] * el[11] * el[14] +
-        el[8] * el[6] * el[15] -
-        el[8] * el[7] * el[14] -
-        el[12] * el[6] * el[11] +
-        el[12] * el[7] * el[10];
-
-    inv[8] =
-        el[4] * el[9] * el[15] -
-        el[4] * el[11] * el[13] -
-        el[8] * el[5] * el[15] +
-        el[8] * el[7] * el[13] +
-        el[12] * el[5] * el[11] -
-        el[12] * el[7] * el[9];
-
-    inv[12] =
-        -el[4] * el[9] * el[14] +
-        el[4] * el[10] * el[13] +
-        el[8] * el[5] * el[14] -
-        el[8] * el[6] * el[13] -
-        el[12] * el[5] * el[10] +
-        el[12] * el[6] * el[9];
-
-    inv[1] =
-        -el[1] * el[10] * el[15] +
-        el[1] * el[11] * el[14] +
-        el[9] * el[2] * el[15] -
-        el[9] * el[3] * el[14] -
-        el[13] * el[2] * el[11] +
-        el[13] * el[3] * el[10];
-
-    inv[5] =
-        el[0] * el[10] * el[15] -
-        el[0] * el[11] * el[14] -
-        el[8] * el[2] * el[15] +
-        el[8] * el[3] * el[14] +
-        el[12] * el[2] * el[11] -
-        el[12] * el[3] * el[10];
-
-    inv[9] =
-        -el[0] * el[9] * el[15] +
-        el[0] * el[11] * el[13] +
-        el[8] * el[1] * el[15] -
-        el[8] * el[3] * el[13] -
-        el[12] * el[1] * el[11] +
-        el[12] * el[3] * el[9];
-
-    inv[13] =
-        el[0] * el[9] * el[14] -
-        el[0] * el[10] * el[13] -
-        el[8] * el[1] * el[14] +
-        el[8] * el[2] * el[13] +
-        el[12] * el[1] * el[10] -
-        el[12] * el[2] * el[9];
-
-    inv[2] =
-        el[1] * el[6] * el[15] -
-        el[1] * el[7] * el[14] -
-        el[5] * el[2] * el[15] +
-        el[5] * el[3] * el[14] +
-        el[13] * el[2] * el[7] -
-        el[13] * el[3] * el[6];
-
-    inv[6] =
-        -el[0] * el[6] * el[15] +
-        el[0] * el[7] * el[14] +
-        el[4] * el[2] * el[15] -
-        el[4] * el[3] * el[14] -
-        el[12] * el[2] * el[7] +
-        el[12] * el[3] * el[6];
-
-    inv[10] =
-        el[0] * el[5] * el[15] -
-        el[0] * el[7] * el[13] -
-        el[4] * el[1] * el[15] +
-        el[4] * el[3] * el[13] +
-        el[12] * el[1] * el[7] -
-        el[12] * el[3] * el[5];
-
-    inv[14] =
-        -el[0] * el[5] * el[14] +
-        el[0] * el[6] * el[13] +
-        el[4] * el[1] * el[14] -
-        el[4] * el[2] * el[13] -
-        el[12] * el[1] * el[6] +
-        el[12] * el[2] * el[5];
-
-    inv[3] =
-        -el[1] * el[6] * el[11] +
-        el[1] * el[7] * el[10] +
-        el[5] * el[2] * el[11] -
-        el[5] * el[3] * el[10] -
-        el[9] * el[2] * el[7] +
-        el[9] * el[3] * el[6];
-
-    inv[7] =
-        el[0] * el[6] * el[11] -
-        el[0] * el[7] * el[10] -
-        el[4] * el[2] * el[11] +
-        el[4] * el[3] * el[10] +
-        el[8] * el[2] * el[7] -
-        el[8] * el[3] * el[6];
-
-    inv[11] =
-        -el[0] * el[5] * el[11] +
-        el[0] * el[7] * el[9] +
-        el[4] * el[1] * el[11] -
-        el[4] * el[3] * el[9] -
-        el[8] * el[1] * el[7] +
-        el[8] * el[3] * el[5];
-
-    inv[15] =
-        el[0] * el[5] * el[10] -
-        el[0] * el[6] * el[9] -
-        el[4] * el[1] * el[10] +
-        el[4] * el[2] * el[9] +
-        el[8] * el[1] * el[6] -
-        el[8] * el[2] * el[5];
-
-    det = el[0] * inv[0] + el[1] * inv[4] + el[2] * inv[8] + el[3] * inv[12];
-
-    if( det == 0 )
-        return false;
-
-    det = 1.0f / det;
-
-    for( i = 0; i < 16; i++ )
-        el[i] = inv[i] * det;
-
-    return true;
-
+    return Mat4Kernels::Invert( el, el );
 }
 
 void Mat4::Transpose()
@@ -379,6 +220,18 @@ Vec3 Mat4::TransformDisplacement( const Vec3& rhs ) const
     return Vec3( ( *this ) * Vec4( rhs, 0 ) );
 }
 
+void Mat4::TransformPositions( const Vec3* positions, Vec3* out_positions, int count ) const
+{
+    static_assert( sizeof( Vec3 ) == sizeof( float ) * 3, "Vec3 must be packed xyz" );
+    Mat4Kernels::TransformPositions( el, positions->el, out_positions->el, count );
+}
+
+void Mat4::TransformDisplacements( const Vec3* displacements, Vec3* out_displacements,
+                                   int count ) const
+{
+    Mat4Kernels::TransformDisplacements( el, displacements->el, out_displacements->el, count );
+}
+
 Plane Mat4::TransformPlane( const Plane& plane ) const
 {
     Vec3 point = plane.GetPoint();
@@ -441,6 +294,20 @@ void Mat4::DecomposeToSRT( Vec3& out_scale, Vec3& out_euler, Vec3& out_translati
     out_euler = rot.DecomposeEuler();
 }
 
+void Mat4::DecomposeToSRT( Vec3& out_scale, Quaternion& out_rotation, Vec3& out_translation ) const
+{
+    out_translation = Vec3( T );
+    out_scale = DecomposeScale();
+    Mat4 rot = *this;
+    if( 0 == out_scale.x || 0 == out_scale.y || 0 == out_scale.z )
+    {
+        LOG_WARNING( "could not decompose matrix to srt, scale was 0" );
+        return;
+    }
+    rot.Scale( Vec3::ONES / out_scale );
+    out_rotation = Quaternion::MakeFromMat4( rot );
+}
+
 Mat4 Mat4::GetRotationalPart() const
 {
     Vec3 scale = DecomposeScale();
@@ -668,6 +535,14 @@ Mat4 Mat4::MakeFromSRT( const Vec3& scale, const Vec3& euler, const Vec3& transl
     return srt;
 }
 
+Mat4 Mat4::MakeFromSRT( const Vec3& scale, const Quaternion& rotation, const Vec3& translation )
+{
+    Mat4 srt = rotation.GetRotationMatrix();
+    srt.Scale( scale );
+    srt.T = Vec4( translation, 1 );
+    return srt;
+}
+
 Mat4 Mat4::MakeRotationDegrees2D( float rotationDegreesAboutZ )
 {
     //    c -s  0  0
@@ -6,6 +6,7 @@
 class Vec2;
 class Vec3;
 class Plane;
+class Quaternion;
 
 class Mat4
 {
@@ -27,6 +28,10 @@ public:
 
     Vec3 TransformPosition( const Vec3& position ) const;
     Vec3 TransformDisplacement( const Vec3& displacement ) const;
+    // Same results as one at a time, SIMD over blocks of points, in and out may be the same array
+    void TransformPositions( const Vec3* positions, Vec3* out_positions, int count ) const;
+    void TransformDisplacements( const Vec3* displacements, Vec3* out_displacements,
+                                 int count ) const;
     Plane TransformPlane( const Plane& plane ) const;
 
     // Accessors
@@ -37,6 +42,7 @@ public:
     Vec4 GetRowZ() const;
     Vec4 GetRowW() const;
     void DecomposeToSRT( Vec3& out_scale, Vec3& out_euler, Vec3& out_translation ) const;
+    void DecomposeToSRT( Vec3& out_scale, Quaternion& out_rotation, Vec3& out_translation ) const;
     Mat4 GetRotationalPart() const;
     // Rotation part must be pure rotation (no scale), translation is ignored
     Vec3 DecomposeEuler() const;
@@ -76,11 +82,15 @@ public:
     // Producers
     static Mat4 MakeFromSRT( const Vec3& scale,
                              const Vec3& euler, const Vec3& translation );
+    // no trig, cheaper than the euler version
+    static Mat4 MakeFromSRT( const Vec3& scale,
+                             const Quaternion& rotation, const Vec3& translation );
     static Mat4 MakeTranslation( const Vec3& translation );
     static Mat4 MakeTranslation( float x, float y, float z );
     // roll first, then pitch, then yaw
     static Mat4 MakeRotationEuler( float yawDeg, float pitchDeg, float rollDeg );
     static Mat4 MakeRotationEuler( Vec3 euler );
+    static Mat4 MakeRotation( const Quaternion& rotation );
     static Mat4 MakeRotationDegrees2D( float rotationDegreesAboutZ );
     static Mat4 MakeTranslation2D( const Vec2& translation );
     static Mat4 MakeScaleUniform2D( float scaleXY );
@@ -0,0 +1,745 @@
+#include "Engine/Math/Mat4Kernels.hpp"
+#include <math.h>
+
+namespace Mat4Kernels
+{
+
+void Multiply( const float* lhs, const float* rhs, float* out )
+{
+#if defined( ENGINE_SIMD_AVX )
+    MultiplyAVX( lhs, rhs, out );
+#elif defined( ENGINE_SIMD_SSE )
+    MultiplySSE( lhs, rhs, out );
+#else
+    MultiplyScalar( lhs, rhs, out );
+#endif
+}
+
+void Transform( const float* mat, const float* vec, float* out )
+{
+#if defined( ENGINE_SIMD_SSE )
+    TransformSSE( mat, vec, out );
+#else
+    TransformScalar( mat, vec, out );
+#endif
+}
+
+bool Invert( const float* mat, float* out )
+{
+#if defined( ENGINE_SIMD_SSE )
+    return InvertSSE( mat, out );
+#else
+    return InvertScalar( mat, out );
+#endif
+}
+
+void TransformPositions( const float* mat, const float* positions, float* out_positions, int count )
+{
+#if defined( ENGINE_SIMD_AVX )
+    TransformPositionsAVX( mat, positions, out_positions, count );
+#elif defined( ENGINE_SIMD_SSE )
+    TransformPositionsSSE( mat, positions, out_positions, count );
+#else
+    TransformPositionsScalar( mat, positions, out_positions, count );
+#endif
+}
+
+void TransformDisplacements( const float* mat, const float* displacements,
+                             float* out_displacements, int count )
+{
+#if defined( ENGINE_SIMD_AVX )
+    TransformDisplacementsAVX( mat, displacements, out_displacements, count );
+#elif defined( ENGINE_SIMD_SSE )
+    TransformDisplacementsSSE( mat, displacements, out_displacements, count );
+#else
+    TransformDisplacementsScalar( mat, displacements, out_displacements, count );
+#endif
+}
+
+void TransformPositionsStrided( const float* mat, const float* positions, size_t stride,
+                                float* out_positions, size_t outStride, int count )
+{
+#if defined( ENGINE_SIMD_SSE )
+    TransformPositionsStridedSSE( mat, positions, stride, out_positions, outStride, count );
+#else
+    TransformPositionsStridedScalar( mat, positions, stride, out_positions, outStride, count );
+#endif
+}
+
+void TransformDisplacementsStrided( const float* mat, const float* displacements, size_t stride,
+                                    float* out_displacements, size_t outStride, int count )
+{
+#if defined( ENGINE_SIMD_SSE )
+    TransformDisplacementsStridedSSE( mat, displacements, stride, out_displacements, outStride,
+                                      count );
+#else
+    TransformDisplacementsStridedScalar( mat, displacements, stride, out_displacements,
+                                         outStride, count );
+#endif
+}
+
+void TransformNormalsStrided( const float* mat, const float* normals, size_t stride,
+                              float* out_normals, size_t outStride, int count )
+{
+#if defined( ENGINE_SIMD_SSE )
+    TransformNormalsStridedSSE( mat, normals, stride, out_normals, outStride, count );
+#else
+    TransformNormalsStridedScalar( mat, normals, stride, out_normals, outStride, count );
+#endif
+}
+
+enum class PointType
+{
+    POSITION,
+    DISPLACEMENT,
+    NORMAL
+};
+
+static inline const float* StrideAt( const float* first, size_t stride, int idx )
+{
+    return (const float*) ( (const char*) first + stride * idx );
+}
+
+static inline float* StrideAt( float* first, size_t stride, int idx )
+{
+    return (float*) ( (char*) first + stride * idx );
+}
+
+//-----------------------------------------------------------------------------------
+// Scalar
+void MultiplyScalar( const float* lhs, const float* rhs, float* out )
+{
+    //  Ix Jx Kx Tx     Ix Jx Kx Tx
+    //  Iy Jy Ky Ty  *  Iy Jy Ky Ty
+    //  Iz Jz Kz Tz     Iz Jz Kz Tz
+    //  Iw Jw Kw Tw     Iw Jw Kw Tw
+    for( int col = 0; col < 16; col += 4 )
+    {
+        for( int row = 0; row < 4; ++row )
+        {
+            out[col + row] = ( lhs[row] * rhs[col] ) + ( lhs[4 + row] * rhs[col + 1] )
+                + ( lhs[8 + row] * rhs[col + 2] ) + ( lhs[12 + row] * rhs[col + 3] );
+        }
+    }
+}
+
+void TransformScalar( const float* mat, const float* vec, float* out )
+{
+    for( int row = 0; row < 4; ++row )
+    {
+        out[row] = ( mat[row] * vec[0] ) + ( mat[4 + row] * vec[1] )
+            + ( mat[8 + row] * vec[2] ) + ( mat[12 + row] * vec[3] );
+    }
+}
+
+bool InvertScalar( const float* el, float* out )
+{
+    float inv[16], det;
+    int i;
+
+    inv[0] =
+        el[5] * el[10] * el[15] -
+        el[5] * el[11] * el[14] -
+        el[9] * el[6] * el[15] +
+        el[9] * el[7] * el[14] +
+        el[13] * el[6] * el[11] -
+        el[13] * el[7] * el[10];
+
+    inv[4] =
+        -el[4] * el[10] * el[15] +
+        el[4] * el[11] * el[14] +
+        el[8] * el[6] * el[15] -
+        el[8] * el[7] * el[14] -
+        el[12] * el[6] * el[11] +
+        el[12] * el[7] * el[10];
+
+    inv[8] =
+        el[4] * el[9] * el[15] -
+        el[4] * el[11] * el[13] -
+        el[8] * el[5] * el[15] +
+        el[8] * el[7] * el[13] +
+        el[12] * el[5] * el[11] -
+        el[12] * el[7] * el[9];
+
+    inv[12] =
+        -el[4] * el[9] * el[14] +
+        el[4] * el[10] * el[13] +
+        el[8] * el[5] * el[14] -
+        el[8] * el[6] * el[13] -
+        el[12] * el[5] * el[10] +
+        el[12] * el[6] * el[9];
+
+    inv[1] =
+        -el[1] * el[10] * el[15] +
+        el[1] * el[11] * el[14] +
+        el[9] * el[2] * el[15] -
+        el[9] * el[3] * el[14] -
+        el[13] * el[2] * el[11] +
+        el[13] * el[3] * el[10];
+
+    inv[5] =
+        el[0] * el[10] * el[15] -
+        el[0] * el[11] * el[14] -
+        el[8] * el[2] * el[15] +
+        el[8] * el[3] * el[14] +
+        el[12] * el[2] * el[11] -
+        el[12] * el[3] * el[10];
+
+    inv[9] =
+        -el[0] * el[9] * el[15] +
+        el[0] * el[11] * el[13] +
+        el[8] * el[1] * el[15] -
+        el[8] * el[3] * el[13] -
+        el[12] * el[1] * el[11] +
+        el[12] * el[3] * el[9];
+
+    inv[13] =
+        el[0] * el[9] * el[14] -
+        el[0] * el[10] * el[13] -
+        el[8] * el[1] * el[14] +
+        el[8] * el[2] * el[13] +
+        el[12] * el[1] * el[10] -
+        el[12] * el[2] * el[9];
+
+    inv[2] =
+        el[1] * el[6] * el[15] -
+        el[1] * el[7] * el[14] -
+        el[5] * el[2] * el[15] +
+        el[5] * el[3] * el[14] +
+        el[13] * el[2] * el[7] -
+        el[13] * el[3] * el[6];
+
+    inv[6] =
+        -el[0] * el[6] * el[15] +
+        el[0] * el[7] * el[14] +
+        el[4] * el[2] * el[15] -
+        el[4] * el[3] * el[14] -
+        el[12] * el[2] * el[7] +
+        el[12] * el[3] * el[6];
+
+    inv[10] =
+        el[0] * el[5] * el[15] -
+        el[0] * el[7] * el[13] -
+        el[4] * el[1] * el[15] +
+        el[4] * el[3] * el[13] +
+        el[12] * el[1] * el[7] -
+        el[12] * el[3] * el[5];
+
+    inv[14] =
+        -el[0] * el[5] * el[14] +
+        el[0] * el[6] * el[13] +
+        el[4] * el[1] * el[14] -
+        el[4] * el[2] * el[13] -
+        el[12] * el[1] * el[6] +
+        el[12] * el[2] * el[5];
+
+    inv[3] =
+        -el[1] * el[6] * el[11] +
+        el[1] * el[7] * el[10] +
+        el[5] * el[2] * el[11] -
+        el[5] * el[3] * el[10] -
+        el[9] * el[2] * el[7] +
+        el[9] * el[3] * el[6];
+
+    inv[7] =
+        el[0] * el[6] * el[11] -
+        el[0] * el[7] * el[10] -
+        el[4] * el[2] * el[11] +
+        el[4] * el[3] * el[10] +
+        el[8] * el[2] * el[7] -
+        el[8] * el[3] * el[6];
+
+    inv[11] =
+        -el[0] * el[5] * el[11] +
+        el[0] * el[7] * el[9] +
+        el[4] * el[1] * el[11] -
+        el[4] * el[3] * el[9] -
+        el[8] * el[1] * el[7] +
+        el[8] * el[3] * el[5];
+
+    inv[15] =
+        el[0] * el[5] * el[10] -
+        el[0] * el[6] * el[9] -
+        el[4] * el[1] * el[10] +
+        el[4] * el[2] * el[9] +
+        el[8] * el[1] * el[6] -
+        el[8] * el[2] * el[5];
+
+    det = el[0] * inv[0] + el[1] * inv[4] + el[2] * inv[8] + el[3] * inv[12];
+
+    if( det == 0 )
+        return false;
+
+    det = 1.0f / det;
+
+    for( i = 0; i < 16; i++ )
+        out[i] = inv[i] * det;
+
+    return true;
+}
+
+static void TransformPointsScalar( const float* mat, const float* in, float* out, int count,
+                                   bool addTranslation )
+{
+    for( int idx = 0; idx < count * 3; idx += 3 )
+    {
+        float x = in[idx];
+        float y = in[idx + 1];
+        float z = in[idx + 2];
+        for( int row = 0; row < 3; ++row )
+        {
+            float result = ( mat[row] * x ) + ( mat[4 + row] * y ) + ( mat[8 + row] * z );
+            if( addTranslation )
+                result = result + mat[12 + row];
+            out[idx + row] = result;
+        }
+    }
+}
+
+void TransformPositionsScalar( const float* mat, const float* positions, float* out_positions,
+                               int count )
+{
+    TransformPointsScalar( mat, positions, out_positions, count, true );
+}
+
+void TransformDisplacementsScalar( const float* mat, const float* displacements,
+                                   float* out_displacements, int count )
+{
+    TransformPointsScalar( mat, displacements, out_displacements, count, false );
+}
+
+static void TransformStridedScalar( const float* mat, const float* in, size_t stride,
+                                   float* out, size_t outStride, int count, PointType type )
+{
+    for( int idx = 0; idx < count; ++idx )
+    {
+        const float* point = StrideAt( in, stride, idx );
+        float x = point[0];
+        float y = point[1];
+        float z = point[2];
+
+        float result[3];
+        for( int row = 0; row < 3; ++row )
+        {
+            result[row] = ( mat[row] * x ) + ( mat[4 + row] * y ) + ( mat[8 + row] * z );
+            if( type == PointType::POSITION )
+                result[row] = result[row] + mat[12 + row];
+        }
+
+        if( type == PointType::NORMAL )
+        {
+            float lengthSq = ( result[0] * result[0] ) + ( result[1] * result[1] )
+                + ( result[2] * result[2] );
+            if( lengthSq > 0.f )
+            {
+                float length = sqrtf( lengthSq );
+                for( int row = 0; row < 3; ++row )
+                    result[row] = result[row] / length;
+            }
+        }
+
+        float* outPoint = StrideAt( out, outStride, idx );
+        outPoint[0] = result[0];
+        outPoint[1] = result[1];
+        outPoint[2] = result[2];
+    }
+}
+
+void TransformPositionsStridedScalar( const float* mat, const float* positions, size_t stride,
+                                      float* out_positions, size_t outStride, int count )
+{
+    TransformStridedScalar( mat, positions, stride, out_positions, outStride, count,
+                            PointType::POSITION );
+}
+
+void TransformDisplacementsStridedScalar( const float* mat, const float* displacements,
+                                          size_t stride, float* out_displacements,
+                                          size_t outStride, int count )
+{
+    TransformStridedScalar( mat, displacements, stride, out_displacements, outStride, count,
+                            PointType::DISPLACEMENT );
+}
+
+void TransformNormalsStridedScalar( const float* mat, const float* normals, size_t stride,
+                                    float* out_normals, size_t outStride, int count )
+{
+    TransformStridedScalar( mat, normals, stride, out_normals, outStride, count,
+                            PointType::NORMAL );
+}
+
+//-----------------------------------------------------------------------------------
+// SSE
+#if defined( ENGINE_SIMD_SSE )
+
+#define SPLAT_PS( vec, lane ) _mm_shuffle_ps( vec, vec, _MM_SHUFFLE( lane, lane, lane, lane ) )
+
+// one column of lhs * rhs, the adds run in the same order as the scalar version
+static inline __m128 MultiplyColumnSSE( __m128 I, __m128 J, __m128 K, __m128 T, __m128 column )
+{
+    __m128 result = _mm_add_ps( _mm_mul_ps( I, SPLAT_PS( column, 0 ) ),
+                                _mm_mul_ps( J, SPLAT_PS( column, 1 ) ) );
+    result = _mm_add_ps( result, _mm_mul_ps( K, SPLAT_PS( column, 2 ) ) );
+    return _mm_add_ps( result, _mm_mul_ps( T, SPLAT_PS( column, 3 ) ) );
+}
+
+void MultiplySSE( const float* lhs, const float* rhs, float* out )
+{
+    __m128 I = _mm_loadu_ps( lhs );
+    __m128 J = _mm_loadu_ps( lhs + 4 );
+    __m128 K = _mm_loadu_ps( lhs + 8 );
+    __m128 T = _mm_loadu_ps( lhs + 12 );
+    for( int col = 0; col < 16; col += 4 )
+    {
+        _mm_storeu_ps( out + col, MultiplyColumnSSE( I, J, K, T, _mm_loadu_ps( rhs + col ) ) );
+    }
+}
+
+void TransformSSE( const float* mat, const float* vec, float* out )
+{
+    _mm_storeu_ps( out, MultiplyColumnSSE( _mm_loadu_ps( mat ), _mm_loadu_ps( mat + 4 ),
+                                           _mm_loadu_ps( mat + 8 ), _mm_loadu_ps( mat + 12 ),
+                                           _mm_loadu_ps( vec ) ) );
+}
+
+bool InvertSSE( const float* mat, float* out )
+{
+    // Cramer's rule on the transposed matrix, after Intel's "Streaming SIMD Extensions -
+    // Inverse of 4x4 Matrix", rows are kept half swapped so the minors need fewer shuffles
+    __m128 col0 = _mm_loadu_ps( mat );
+    __m128 col1 = _mm_loadu_ps( mat + 4 );
+    __m128 col2 = _mm_loadu_ps( mat + 8 );
+    __m128 col3 = _mm_loadu_ps( mat + 12 );
+
+    __m128 tmp = _mm_movelh_ps( col0, col1 );
+    __m128 row1 = _mm_movelh_ps( col2, col3 );
+    __m128 row0 = _mm_shuffle_ps( tmp, row1, 0x88 );
+    row1 = _mm_shuffle_ps( row1, tmp, 0xDD );
+    tmp = _mm_movehl_ps( col1, col0 );
+    __m128 row3 = _mm_movehl_ps( col3, col2 );
+    __m128 row2 = _mm_shuffle_ps( tmp, row3, 0x88 );
+    row3 = _mm_shuffle_ps( row3, tmp, 0xDD );
+
+    __m128 minor0, minor1, minor2, minor3;
+
+    tmp = _mm_mul_ps( row2, row3 );
+    tmp = _mm_shuffle_ps( tmp, tmp, 0xB1 );
+    minor0 = _mm_mul_ps( row1, tmp );
+    minor1 = _mm_mul_ps( row0, tmp );
+    tmp = _mm_shuffle_ps( tmp, tmp, 0x4E );
+    minor0 = _mm_sub_ps( _mm_mul_ps( row1, tmp ), minor0 );
+    minor1 = _mm_sub_ps( _mm_mul_ps( row0, tmp ), minor1 );
+    minor1 = _mm_shuffle_ps( minor1, minor1, 0x4E );
+
+    tmp = _mm_mul_ps( row1, row2 );
+    tmp = _mm_shuffle_ps( tmp, tmp, 0xB1 );
+    minor0 = _mm_add_ps( _mm_mul_ps( row3, tmp ), minor0 );
+    minor3 = _mm_mul_ps( row0, tmp );
+    tmp = _mm_shuffle_ps( tmp, tmp, 0x4E );
+    minor0 = _mm_sub_ps( minor0, _mm_mul_ps( row3, tmp ) );
+    minor3 = _mm_sub_ps( _mm_mul_ps( row0, tmp ), minor3 );
+    minor3 = _mm_shuffle_ps( minor3, minor3, 0x4E );
+
+    tmp = _mm_mul_ps( _mm_shuffle_ps( row1, row1, 0x4E ), row3 );
+    tmp = _mm_shuffle_ps( tmp, tmp, 0xB1 );
+    row2 = _mm_shuffle_ps( row2, row2, 0x4E );
+    minor0 = _mm_add_ps( _mm_mul_ps( row2, tmp ), minor0 );
+    minor2 = _mm_mul_ps( row0, tmp );
+    tmp = _mm_shuffle_ps( tmp, tmp, 0x4E );
+    minor0 = _mm_sub_ps( minor0, _mm_mul_ps( row2, tmp ) );
+    minor2 = _mm_sub_ps( _mm_mul_ps( row0, tmp ), minor2 );
+    minor2 = _mm_shuffle_ps( minor2, minor2, 0x4E );
+
+    tmp = _mm_mul_ps( row0, row1 );
+    tmp = _mm_shuffle_ps( tmp, tmp, 0xB1 );
+    minor2 = _mm_add_ps( _mm_mul_ps( row3, tmp ), minor2 );
+    minor3 = _mm_sub_ps( _mm_mul_ps( row2, tmp ), minor3 );
+    tmp = _mm_shuffle_ps( tmp, tmp, 0x4E );
+    minor2 = _mm_sub_ps( _mm_mul_ps( row3, tmp ), minor2 );
+    minor3 = _mm_sub_ps( minor3, _mm_mul_ps( row2, tmp ) );
+
+    tmp = _mm_mul_ps( row0, row3 );
+    tmp = _mm_shuffle_ps( tmp, tmp, 0xB1 );
+    minor1 = _mm_sub_ps( minor1, _mm_mul_ps( row2, tmp ) );
+    minor2 = _mm_add_ps( _mm_mul_ps( row1, tmp ), minor2 );
+    tmp = _mm_shuffle_ps( tmp, tmp, 0x4E );
+    minor1 = _mm_add_ps( _mm_mul_ps( row2, tmp ), minor1 );
+    minor2 = _mm_sub_ps( minor2, _mm_mul_ps( row1, tmp ) );
+
+    tmp = _mm_mul_ps( row0, row2 );
+    tmp = _mm_shuffle_ps( tmp, tmp, 0xB1 );
+    minor1 = _mm_add_ps( _mm_mul_ps( row3, tmp ), minor1 );
+    minor3 = _mm_sub_ps( minor3, _mm_mul_ps( row1, tmp ) );
+    tmp = _mm_shuffle_ps( tmp, tmp, 0x4E );
+    minor1 = _mm_sub_ps( minor1, _mm_mul_ps( row3, tmp ) );
+    minor3 = _mm_add_ps( _mm_mul_ps( row1, tmp ), minor3 );
+
+    __m128 det = _mm_mul_ps( row0, minor0 );
+    det = _mm_add_ps( _mm_shuffle_ps( det, det, 0x4E ), det );
+    det = _mm_add_ss( _mm_shuffle_ps( det, det, 0xB1 ), det );
+    if( _mm_cvtss_f32( det ) == 0 )
+        return false;
+
+    // a real divide, the rcp estimate is too coarse for camera matrices
+    det = _mm_div_ss( _mm_set_ss( 1.f ), det );
+    det = SPLAT_PS( det, 0 );
+    _mm_storeu_ps( out, _mm_mul_ps( det, minor0 ) );
+    _mm_storeu_ps( out + 4, _mm_mul_ps( det, minor1 ) );
+    _mm_storeu_ps( out + 8, _mm_mul_ps( det, minor2 ) );
+    _mm_storeu_ps( out + 12, _mm_mul_ps( det, minor3 ) );
+    return true;
+}
+
+// 4 packed xyz points to x, y, z lanes and back
+static inline void LoadPointsSSE( const float* in, __m128& x, __m128& y, __m128& z )
+{
+    __m128 a = _mm_loadu_ps( in );      // x0 y0 z0 x1
+    __m128 b = _mm_loadu_ps( in + 4 );  // y1 z1 x2 y2
+    __m128 c = _mm_loadu_ps( in + 8 );  // z2 x3 y3 z3
+    __m128 x2y2x3y3 = _mm_shuffle_ps( b, c, _MM_SHUFFLE( 2, 1, 3, 2 ) );
+    __m128 y0z0y1z1 = _mm_shuffle_ps( a, b, _MM_SHUFFLE( 1, 0, 2, 1 ) );
+    x = _mm_shuffle_ps( a, x2y2x3y3, _MM_SHUFFLE( 2, 0, 3, 0 ) );
+    y = _mm_shuffle_ps( y0z0y1z1, x2y2x3y3, _MM_SHUFFLE( 3, 1, 2, 0 ) );
+    z = _mm_shuffle_ps( y0z0y1z1, c, _MM_SHUFFLE( 3, 0, 3, 1 ) );
+}
+
+static inline void StorePointsSSE( float* out, __m128 x, __m128 y, __m128 z )
+{
+    __m128 x0y0x1y1 = _mm_unpacklo_ps( x, y );
+    __m128 z0z0x1x1 = _mm_shuffle_ps( z, x, _MM_SHUFFLE( 1, 1, 0, 0 ) );
+    __m128 y1y1z1z1 = _mm_shuffle_ps( y, z, _MM_SHUFFLE( 1, 1, 1, 1 ) );
+    __m128 x2x2y2y2 = _mm_shuffle_ps( x, y, _MM_SHUFFLE( 2, 2, 2, 2 ) );
+    __m128 z2z2x3x3 = _mm_shuffle_ps( z, x, _MM_SHUFFLE( 3, 3, 2, 2 ) );
+    __m128 y3y3z3z3 = _mm_shuffle_ps( y, z, _MM_SHUFFLE( 3, 3, 3, 3 ) );
+    _mm_storeu_ps( out, _mm_shuffle_ps( x0y0x1y1, z0z0x1x1, _MM_SHUFFLE( 2, 0, 1, 0 ) ) );
+    _mm_storeu_ps( out + 4, _mm_shuffle_ps( y1y1z1z1, x2x2y2y2, _MM_SHUFFLE( 2, 0, 2, 0 ) ) );
+    _mm_storeu_ps( out + 8, _mm_shuffle_ps( z2z2x3x3, y3y3z3z3, _MM_SHUFFLE( 2, 0, 2, 0 ) ) );
+}
+
+static void TransformPointsSSE( const float* mat, const float* in, float* out, int count,
+                                bool addTranslation )
+{
+    __m128 el[12];
+    for( int row = 0; row < 3; ++row )
+    {
+        el[row] = _mm_set1_ps( mat[row] );
+        el[3 + row] = _mm_set1_ps( mat[4 + row] );
+        el[6 + row] = _mm_set1_ps( mat[8 + row] );
+        el[9 + row] = _mm_set1_ps( mat[12 + row] );
+    }
+
+    int blockEnd = count & ~3;
+    for( int idx = 0; idx < blockEnd; idx += 4 )
+    {
+        __m128 in_[3];
+        LoadPointsSSE( in + idx * 3, in_[0], in_[1], in_[2] );
+        __m128 result[3];
+        for( int row = 0; row < 3; ++row )
+        {
+            result[row] = _mm_add_ps( _mm_mul_ps( el[row], in_[0] ),
+                                      _mm_mul_ps( el[3 + row], in_[1] ) );
+            result[row] = _mm_add_ps( result[row], _mm_mul_ps( el[6 + row], in_[2] ) );
+            if( addTranslation )
+                result[row] = _mm_add_ps( result[row], el[9 + row] );
+        }
+        StorePointsSSE( out + idx * 3, result[0], result[1], result[2] );
+    }
+    TransformPointsScalar( mat, in + blockEnd * 3, out + blockEnd * 3, count - blockEnd,
+                           addTranslation );
+}
+
+// never reads past z, the struct may end there
+static inline __m128 LoadXYZ( const float* point )
+{
+    __m128 xy = _mm_castpd_ps( _mm_load_sd( (const double*) point ) );
+    return _mm_movelh_ps( xy, _mm_load_ss( point + 2 ) );
+}
+
+static inline void StoreXYZ( float* point, __m128 xyz )
+{
+    _mm_store_sd( (double*) point, _mm_castps_pd( xyz ) );
+    _mm_store_ss( point + 2, _mm_movehl_ps( xyz, xyz ) );
+}
+
+static void TransformStridedSSE( const float* mat, const float* in, size_t stride,
+                                 float* out, size_t outStride, int count, PointType type )
+{
+    __m128 el[12];
+    for( int row = 0; row < 3; ++row )
+    {
+        el[row] = _mm_set1_ps( mat[row] );
+        el[3 + row] = _mm_set1_ps( mat[4 + row] );
+        el[6 + row] = _mm_set1_ps( mat[8 + row] );
+        el[9 + row] = _mm_set1_ps( mat[12 + row] );
+    }
+
+    int blockEnd = count & ~3;
+    for( int idx = 0; idx < blockEnd; idx += 4 )
+    {
+        // 4 structs to x, y, z lanes
+        __m128 x = LoadXYZ( StrideAt( in, stride, idx ) );
+        __m128 y = LoadXYZ( StrideAt( in, stride, idx + 1 ) );
+        __m128 z = LoadXYZ( StrideAt( in, stride, idx + 2 ) );
+        __m128 w = LoadXYZ( StrideAt( in, stride, idx + 3 ) );
+        _MM_TRANSPOSE4_PS( x, y, z, w );
+
+        __m128 result[4];
+        for( int row = 0; row < 3; ++row )
+        {
+            result[row] = _mm_add_ps( _mm_mul_ps( el[row], x ), _mm_mul_ps( el[3 + row], y ) );
+            result[row] = _mm_add_ps( result[row], _mm_mul_ps( el[6 + row], z ) );
+            if( type == PointType::POSITION )
+                result[row] = _mm_add_ps( result[row], el[9 + row] );
+        }
+
+        if( type == PointType::NORMAL )
+        {
+            __m128 lengthSq = _mm_add_ps( _mm_mul_ps( result[0], result[0] ),
+                                          _mm_mul_ps( result[1], result[1] ) );
+            lengthSq = _mm_add_ps( lengthSq, _mm_mul_ps( result[2], result[2] ) );
+            __m128 length = _mm_sqrt_ps( lengthSq );
+            __m128 hasLength = _mm_cmpgt_ps( lengthSq, _mm_setzero_ps() );
+            for( int row = 0; row < 3; ++row )
+            {
+                __m128 normalized = _mm_div_ps( result[row], length );
+                result[row] = _mm_or_ps( _mm_and_ps( hasLength, normalized ),
+                                         _mm_andnot_ps( hasLength, result[row] ) );
+            }
+        }
+
+        result[3] = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS( result[0], result[1], result[2], result[3] );
+        StoreXYZ( StrideAt( out, outStride, idx ), result[0] );
+        StoreXYZ( StrideAt( out, outStride, idx + 1 ), result[1] );
+        StoreXYZ( StrideAt( out, outStride, idx + 2 ), result[2] );
+        StoreXYZ( StrideAt( out, outStride, idx + 3 ), result[3] );
+    }
+    TransformStridedScalar( mat, StrideAt( in, stride, blockEnd ), stride,
+                            StrideAt( out, outStride, blockEnd ), outStride, count - blockEnd,
+                            type );
+}
+
+void TransformPositionsStridedSSE( const float* mat, const float* positions, size_t stride,
+                                   float* out_positions, size_t outStride, int count )
+{
+    TransformStridedSSE( mat, positions, stride, out_positions, outStride, count,
+                         PointType::POSITION );
+}
+
+void TransformDisplacementsStridedSSE( const float* mat, const float* displacements,
+                                       size_t stride, float* out_displacements,
+                                       size_t outStride, int count )
+{
+    TransformStridedSSE( mat, displacements, stride, out_displacements, outStride, count,
+                         PointType::DISPLACEMENT );
+}
+
+void TransformNormalsStridedSSE( const float* mat, const float* normals, size_t stride,
+                                 float* out_normals, size_t outStride, int count )
+{
+    TransformStridedSSE( mat, normals, stride, out_normals, outStride, count,
+                         PointType::NORMAL );
+}
+
+void TransformPositionsSSE( const float* mat, const float* positions, float* out_positions,
+                            int count )
+{
+    TransformPointsSSE( mat, positions, out_positions, count, true );
+}
+
+void TransformDisplacementsSSE( const float* mat, const float* displacements,
+                                float* out_displacements, int count )
+{
+    TransformPointsSSE( mat, displacements, out_displacements, count, false );
+}
+
+#endif // ENGINE_SIMD_SSE
+
+//-----------------------------------------------------------------------------------
+// AVX, two matrix columns or 8 points per op
+#if defined( ENGINE_SIMD_AVX )
+
+static inline __m256 Duplicate128( __m128 vec )
+{
+    return _mm256_insertf128_ps( _mm256_castps128_ps256( vec ), vec, 1 );
+}
+
+static inline __m256 Combine128( __m128 low, __m128 high )
+{
+    return _mm256_insertf128_ps( _mm256_castps128_ps256( low ), high, 1 );
+}
+
+void MultiplyAVX( const float* lhs, const float* rhs, float* out )
+{
+    __m256 I = Duplicate128( _mm_loadu_ps( lhs ) );
+    __m256 J = Duplicate128( _mm_loadu_ps( lhs + 4 ) );
+    __m256 K = Duplicate128( _mm_loadu_ps( lhs + 8 ) );
+    __m256 T = Duplicate128( _mm_loadu_ps( lhs + 12 ) );
+    for( int col = 0; col < 16; col += 8 )
+    {
+        __m256 columns = _mm256_loadu_ps( rhs + col );
+        __m256 result = _mm256_add_ps( _mm256_mul_ps( I, _mm256_permute_ps( columns, 0x00 ) ),
+                                       _mm256_mul_ps( J, _mm256_permute_ps( columns, 0x55 ) ) );
+        result = _mm256_add_ps( result, _mm256_mul_ps( K, _mm256_permute_ps( columns, 0xAA ) ) );
+        result = _mm256_add_ps( result, _mm256_mul_ps( T, _mm256_permute_ps( columns, 0xFF ) ) );
+        _mm256_storeu_ps( out + col, result );
+    }
+}
+
+static void TransformPointsAVX( const float* mat, const float* in, float* out, int count,
+                                bool addTranslation )
+{
+    __m256 el[12];
+    for( int row = 0; row < 3; ++row )
+    {
+        el[row] = _mm256_set1_ps( mat[row] );
+        el[3 + row] = _mm256_set1_ps( mat[4 + row] );
+        el[6 + row] = _mm256_set1_ps( mat[8 + row] );
+        el[9 + row] = _mm256_set1_ps( mat[12 + row] );
+    }
+
+    int blockEnd = count & ~7;
+    for( int idx = 0; idx < blockEnd; idx += 8 )
+    {
+        __m128 low[3];
+        __m128 high[3];
+        LoadPointsSSE( in + idx * 3, low[0], low[1], low[2] );
+        LoadPointsSSE( in + idx * 3 + 12, high[0], high[1], high[2] );
+        __m256 in_[3];
+        for( int axis = 0; axis < 3; ++axis )
+        {
+            in_[axis] = Combine128( low[axis], high[axis] );
+        }
+
+        __m256 result[3];
+        for( int row = 0; row < 3; ++row )
+        {
+            result[row] = _mm256_add_ps( _mm256_mul_ps( el[row], in_[0] ),
+                                         _mm256_mul_ps( el[3 + row], in_[1] ) );
+            result[row] = _mm256_add_ps( result[row], _mm256_mul_ps( el[6 + row], in_[2] ) );
+            if( addTranslation )
+                result[row] = _mm256_add_ps( result[row], el[9 + row] );
+        }
+        StorePointsSSE( out + idx * 3, _mm256_castps256_ps128( result[0] ),
+                        _mm256_castps256_ps128( result[1] ), _mm256_castps256_ps128( result[2] ) );
+        StorePointsSSE( out + idx * 3 + 12, _mm256_extractf128_ps( result[0], 1 ),
+                        _mm256_extractf128_ps( result[1], 1 ), _mm256_extractf128_ps( result[2], 1 ) );
+    }
+    TransformPointsSSE( mat, in + blockEnd * 3, out + blockEnd * 3, count - blockEnd,
+                        addTranslation );
+}
+
+void TransformPositionsAVX( const float* mat, const float* positions, float* out_positions,
+                            int count )
+{
+    TransformPointsAVX( mat, positions, out_positions, count, true );
+}
+
+void TransformDisplacementsAVX( const float* mat, const float* displacements,
+                                float* out_displacements, int count )
+{
+    TransformPointsAVX( mat, displacements, out_displacements, count, false );
+}
+
+#endif // ENGINE_SIMD_AVX
+
+}
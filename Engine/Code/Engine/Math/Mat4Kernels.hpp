@@ -0,0 +1,76 @@
+#pragma once
+#include <stddef.h>
+#include "Engine/Math/SIMD.hpp"
+
+// Raw float kernels under Mat4, matrices are 16 floats in Mat4 order (Ix, Iy, Iz, Iw, Jx...)
+// Points are packed xyz triples like an array of Vec3, the Strided versions instead take
+// the xyz at the start of every stride bytes, so they run straight over vertex structs
+// and only touch those 3 floats
+//
+// The unsuffixed functions use the widest compiled in version, the suffixed ones are
+// exposed so they can be checked against each other
+// Multiply and Transform do the same float ops in the same order in every version,
+// so all versions give bit identical results, Invert does not
+namespace Mat4Kernels
+{
+
+// out must not alias lhs or rhs
+void Multiply( const float* lhs, const float* rhs, float* out );
+// vec and out are 4 floats, out must not alias vec
+void Transform( const float* mat, const float* vec, float* out );
+// out may be mat, returns false and leaves out alone if mat can't be inverted
+bool Invert( const float* mat, float* out );
+// w = 1 for positions, w = 0 for displacements, in and out may be the same array
+void TransformPositions( const float* mat, const float* positions, float* out_positions, int count );
+void TransformDisplacements( const float* mat, const float* displacements,
+                             float* out_displacements, int count );
+void TransformPositionsStrided( const float* mat, const float* positions, size_t stride,
+                                float* out_positions, size_t outStride, int count );
+void TransformDisplacementsStrided( const float* mat, const float* displacements, size_t stride,
+                                    float* out_displacements, size_t outStride, int count );
+// Transforms as displacements then renormalizes, zero length normals stay zero
+// Pass the inverse transpose of the model matrix
+void TransformNormalsStrided( const float* mat, const float* normals, size_t stride,
+                              float* out_normals, size_t outStride, int count );
+
+void MultiplyScalar( const float* lhs, const float* rhs, float* out );
+void TransformScalar( const float* mat, const float* vec, float* out );
+bool InvertScalar( const float* mat, float* out );
+void TransformPositionsScalar( const float* mat, const float* positions, float* out_positions,
+                               int count );
+void TransformDisplacementsScalar( const float* mat, const float* displacements,
+                                   float* out_displacements, int count );
+void TransformPositionsStridedScalar( const float* mat, const float* positions, size_t stride,
+                                      float* out_positions, size_t outStride, int count );
+void TransformDisplacementsStridedScalar( const float* mat, const float* displacements,
+                                          size_t stride, float* out_displacements,
+                                          size_t outStride, int count );
+void TransformNormalsStridedScalar( const float* mat, const float* normals, size_t stride,
+                                    float* out_normals, size_t outStride, int count );
+
+#if defined( ENGINE_SIMD_SSE )
+void MultiplySSE( const float* lhs, const float* rhs, float* out );
+void TransformSSE( const float* mat, const float* vec, float* out );
+bool InvertSSE( const float* mat, float* out );
+void TransformPositionsSSE( const float* mat, const float* positions, float* out_positions,
+                            int count );
+void TransformDisplacementsSSE( const float* mat, const float* displacements,
+                                float* out_displacements, int count );
+void TransformPositionsStridedSSE( const float* mat, const float* positions, size_t stride,
+                                   float* out_positions, size_t outStride, int count );
+void TransformDisplacementsStridedSSE( const float* mat, const float* displacements,
+                                       size_t stride, float* out_displacements,
+                                       size_t outStride, int count );
+void TransformNormalsStridedSSE( const float* mat, const float* normals, size_t stride,
+                                 float* out_normals, size_t outStride, int count );
+#endif
+
+#if defined( ENGINE_SIMD_AVX )
+void MultiplyAVX( const float* lhs, const float* rhs, float* out );
+void TransformPositionsAVX( const float* mat, const float* positions, float* out_positions,
+                            int count );
+void TransformDisplacementsAVX( const float* mat, const float* displacements,
+                                float* out_displacements, int count );
+#endif
+
+}
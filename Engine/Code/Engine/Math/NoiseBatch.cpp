@@ -0,0 +1,986 @@
+#include <vector>
+
+#include "Engine/Math/NoiseBatch.hpp"
+#include "Engine/Math/SIMD.hpp"
+#include "Engine/Math/RawNoise.hpp"
+#include "Engine/Math/SmoothNoise.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Math/Vec4.hpp"
+#include "Engine/Math/IVec2.hpp"
+#include "Engine/Core/HeatMap.hpp"
+#include "Engine/Core/Image.hpp"
+#include "Engine/Core/Rgba.hpp"
+
+namespace Noise
+{
+
+namespace
+{
+
+typedef float( *Noise2dFunction )( float posX, float posY, float scale, unsigned int numOctaves,
+                                    float octavePersistence, float octaveScale, bool renormalize,
+                                    unsigned int seed );
+typedef float( *Noise3dFunction )( float posX, float posY, float posZ, float scale,
+                                    unsigned int numOctaves, float octavePersistence,
+                                    float octaveScale, bool renormalize, unsigned int seed );
+typedef float( *Noise4dFunction )( float posX, float posY, float posZ, float posT, float scale,
+                                    unsigned int numOctaves, float octavePersistence,
+                                    float octaveScale, bool renormalize, unsigned int seed );
+
+#if defined( ENGINE_SIMD_SSE )
+
+const float OCTAVE_OFFSET = 0.636764989593174f; // Same as SmoothNoise.cpp
+
+// Everything in the octave loop that doesn't depend on the position
+struct OctaveSettings
+{
+    OctaveSettings( float scale, unsigned int numOctaves, float octavePersistence,
+                    float octaveScale, bool renormalize, unsigned int seed )
+        : m_invScale( 1.f / scale )
+        , m_octaveScale( octaveScale )
+        , m_renormalize( renormalize )
+        , m_seed( seed )
+    {
+        // same accumulation order as the single sample functions
+        float currentAmplitude = 1.f;
+        for( unsigned int octaveNum = 0; octaveNum < numOctaves; ++octaveNum )
+        {
+            m_amplitudes.push_back( currentAmplitude );
+            m_totalAmplitude += currentAmplitude;
+            currentAmplitude *= octavePersistence;
+        }
+    }
+
+    float m_invScale;
+    float m_octaveScale;
+    bool m_renormalize;
+    unsigned int m_seed;
+    float m_totalAmplitude = 0.f;
+    std::vector<float> m_amplitudes;
+};
+
+typedef __m128( *Noise2dLanesFunction )( __m128 posX, __m128 posY,
+                                          const OctaveSettings& settings );
+typedef __m128( *Noise3dLanesFunction )( __m128 posX, __m128 posY, __m128 posZ,
+                                          const OctaveSettings& settings );
+typedef __m128( *Noise4dLanesFunction )( __m128 posX, __m128 posY, __m128 posZ, __m128 posT,
+                                          const OctaveSettings& settings );
+
+__m128i MultiplyLow( __m128i a, __m128i b )
+{
+    // SSE2 has no 32 bit low multiply, do even and odd lanes as 64 bit and repack
+    __m128i even = _mm_mul_epu32( a, b );
+    __m128i odd = _mm_mul_epu32( _mm_srli_epi64( a, 32 ), _mm_srli_epi64( b, 32 ) );
+    return _mm_unpacklo_epi32( _mm_shuffle_epi32( even, _MM_SHUFFLE( 0, 0, 2, 0 ) ),
+                               _mm_shuffle_epi32( odd, _MM_SHUFFLE( 0, 0, 2, 0 ) ) );
+}
+
+// Get1dUint on 4 lanes
+__m128i Get1dUintLanes( __m128i positionX, __m128i seed )
+{
+    const __m128i BIT_NOISE1 = _mm_set1_epi32( (int) 0xD2A80A23 );
+    const __m128i BIT_NOISE2 = _mm_set1_epi32( (int) 0xA884F197 );
+    const __m128i BIT_NOISE3 = _mm_set1_epi32( (int) 0x1B56C4E9 );
+
+    __m128i mangledBits = MultiplyLow( positionX, BIT_NOISE1 );
+    mangledBits = _mm_add_epi32( mangledBits, seed );
+    mangledBits = _mm_xor_si128( mangledBits, _mm_srli_epi32( mangledBits, 7 ) );
+    mangledBits = _mm_add_epi32( mangledBits, BIT_NOISE2 );
+    mangledBits = _mm_xor_si128( mangledBits, _mm_srli_epi32( mangledBits, 8 ) );
+    mangledBits = MultiplyLow( mangledBits, BIT_NOISE3 );
+    mangledBits = _mm_xor_si128( mangledBits, _mm_srli_epi32( mangledBits, 11 ) );
+    return mangledBits;
+}
+
+__m128i Get2dUintLanes( __m128i indexX, __m128i indexY, __m128i seed )
+{
+    const __m128i PRIME_NUMBER = _mm_set1_epi32( 198491317 );
+    return Get1dUintLanes( _mm_add_epi32( indexX, MultiplyLow( PRIME_NUMBER, indexY ) ), seed );
+}
+
+__m128i Get3dUintLanes( __m128i indexX, __m128i indexY, __m128i indexZ, __m128i seed )
+{
+    const __m128i PRIME1 = _mm_set1_epi32( 198491317 );
+    const __m128i PRIME2 = _mm_set1_epi32( 6542989 );
+    __m128i index = _mm_add_epi32( indexX, MultiplyLow( PRIME1, indexY ) );
+    index = _mm_add_epi32( index, MultiplyLow( PRIME2, indexZ ) );
+    return Get1dUintLanes( index, seed );
+}
+
+__m128i Get4dUintLanes( __m128i indexX, __m128i indexY, __m128i indexZ, __m128i indexT,
+                        __m128i seed )
+{
+    const __m128i PRIME1 = _mm_set1_epi32( 198491317 );
+    const __m128i PRIME2 = _mm_set1_epi32( 6542989 );
+    const __m128i PRIME3 = _mm_set1_epi32( 357239 );
+    __m128i index = _mm_add_epi32( indexX, MultiplyLow( PRIME1, indexY ) );
+    index = _mm_add_epi32( index, MultiplyLow( PRIME2, indexZ ) );
+    index = _mm_add_epi32( index, MultiplyLow( PRIME3, indexT ) );
+    return Get1dUintLanes( index, seed );
+}
+
+__m128 ZeroToOneLanes( __m128i noise )
+{
+    // No unsigned convert in SSE2, flip to signed and add the bias back as double
+    // the double math is exact so this rounds to float the same as the scalar cast
+    const __m128i SIGN_BIT = _mm_set1_epi32( (int) 0x80000000 );
+    const __m128d UNSIGNED_BIAS = _mm_set1_pd( 2147483648.0 );
+    const __m128d ONE_OVER_MAX_UINT = _mm_set1_pd( 1.0 / (double) 0xFFFFFFFF );
+
+    __m128i flipped = _mm_xor_si128( noise, SIGN_BIT );
+    __m128i flippedHigh = _mm_shuffle_epi32( flipped, _MM_SHUFFLE( 3, 2, 3, 2 ) );
+    __m128d low = _mm_add_pd( _mm_cvtepi32_pd( flipped ), UNSIGNED_BIAS );
+    __m128d high = _mm_add_pd( _mm_cvtepi32_pd( flippedHigh ), UNSIGNED_BIAS );
+    low = _mm_mul_pd( ONE_OVER_MAX_UINT, low );
+    high = _mm_mul_pd( ONE_OVER_MAX_UINT, high );
+    return _mm_movelh_ps( _mm_cvtpd_ps( low ), _mm_cvtpd_ps( high ) );
+}
+
+__m128 FloorLanes( __m128 values )
+{
+    // SSE2 has no round, truncate then step down where that rounded up
+    __m128 truncated = _mm_cvtepi32_ps( _mm_cvttps_epi32( values ) );
+    __m128 roundedUp = _mm_cmpgt_ps( truncated, values );
+    return _mm_sub_ps( truncated, _mm_and_ps( roundedUp, _mm_set1_ps( 1.f ) ) );
+}
+
+// Easing::SmoothStep3 op for op
+__m128 SmoothStep3Lanes( __m128 t )
+{
+    const __m128 ONE = _mm_set1_ps( 1.f );
+    __m128 start = _mm_mul_ps( _mm_mul_ps( t, t ), t );
+    __m128 t1 = _mm_sub_ps( ONE, t );
+    __m128 stop = _mm_sub_ps( ONE, _mm_mul_ps( _mm_mul_ps( t1, t1 ), t1 ) );
+    return _mm_add_ps( start, _mm_mul_ps( _mm_sub_ps( stop, start ), t ) );
+}
+
+__m128 RenormalizeLanes( __m128 totalNoise, const OctaveSettings& settings )
+{
+    if( !settings.m_renormalize || !( settings.m_totalAmplitude > 0.f ) )
+        return totalNoise;
+
+    const __m128 HALF = _mm_set1_ps( 0.5f );
+    totalNoise = _mm_div_ps( totalNoise, _mm_set1_ps( settings.m_totalAmplitude ) );
+    totalNoise = _mm_add_ps( _mm_mul_ps( totalNoise, HALF ), HALF );
+    totalNoise = SmoothStep3Lanes( totalNoise );
+    totalNoise = _mm_sub_ps( _mm_mul_ps( totalNoise, _mm_set1_ps( 2.f ) ), _mm_set1_ps( 1.f ) );
+    return totalNoise;
+}
+
+// Picks one of the 8 Compute2dPerlin gradients per lane from the low 3 bits
+// Gradient k is at 22.5 + 45k degrees, so the components are +-a or +-b
+// x is b when bit 0 and bit 1 differ, y is the other one
+// x is negative for k in [2,5], y is negative for k in [4,7]
+void GetGradientLanes( __m128i noise, __m128& out_gradientX, __m128& out_gradientY )
+{
+    const __m128i ONE = _mm_set1_epi32( 1 );
+    const __m128 A = _mm_set1_ps( 0.923879533f );
+    const __m128 B = _mm_set1_ps( 0.382683432f );
+
+    __m128i k = _mm_and_si128( noise, _mm_set1_epi32( 7 ) );
+    __m128i xIsB = _mm_and_si128( _mm_xor_si128( k, _mm_srli_epi32( k, 1 ) ), ONE );
+    __m128 xIsBMask = _mm_castsi128_ps( _mm_cmpeq_epi32( xIsB, ONE ) );
+    __m128 magnitudeX = _mm_or_ps( _mm_and_ps( xIsBMask, B ), _mm_andnot_ps( xIsBMask, A ) );
+    __m128 magnitudeY = _mm_or_ps( _mm_and_ps( xIsBMask, A ), _mm_andnot_ps( xIsBMask, B ) );
+
+    __m128i signX = _mm_slli_epi32(
+        _mm_and_si128( _mm_srli_epi32( _mm_add_epi32( k, _mm_set1_epi32( 2 ) ), 2 ), ONE ), 31 );
+    __m128i signY = _mm_slli_epi32( _mm_and_si128( _mm_srli_epi32( k, 2 ), ONE ), 31 );
+    out_gradientX = _mm_xor_ps( magnitudeX, _mm_castsi128_ps( signX ) );
+    out_gradientY = _mm_xor_ps( magnitudeY, _mm_castsi128_ps( signY ) );
+}
+
+// Compute2dFractal on 4 lanes
+__m128 Fractal2dLanes( __m128 posX, __m128 posY, const OctaveSettings& settings )
+{
+    const __m128i ONE = _mm_set1_epi32( 1 );
+    const __m128 ONE_F = _mm_set1_ps( 1.f );
+    __m128 totalNoise = _mm_setzero_ps();
+    __m128 invScale = _mm_set1_ps( settings.m_invScale );
+    __m128 currentPosX = _mm_mul_ps( posX, invScale );
+    __m128 currentPosY = _mm_mul_ps( posY, invScale );
+
+    unsigned int numOctaves = (unsigned int) settings.m_amplitudes.size();
+    for( unsigned int octaveNum = 0; octaveNum < numOctaves; ++octaveNum )
+    {
+        __m128i seed = _mm_set1_epi32( (int) ( settings.m_seed + octaveNum ) );
+        __m128 cellMinsX = FloorLanes( currentPosX );
+        __m128 cellMinsY = FloorLanes( currentPosY );
+        __m128i indexWestX = _mm_cvttps_epi32( cellMinsX );
+        __m128i indexSouthY = _mm_cvttps_epi32( cellMinsY );
+        __m128i indexEastX = _mm_add_epi32( indexWestX, ONE );
+        __m128i indexNorthY = _mm_add_epi32( indexSouthY, ONE );
+        __m128 valueSouthWest = ZeroToOneLanes( Get2dUintLanes( indexWestX, indexSouthY, seed ) );
+        __m128 valueSouthEast = ZeroToOneLanes( Get2dUintLanes( indexEastX, indexSouthY, seed ) );
+        __m128 valueNorthWest = ZeroToOneLanes( Get2dUintLanes( indexWestX, indexNorthY, seed ) );
+        __m128 valueNorthEast = ZeroToOneLanes( Get2dUintLanes( indexEastX, indexNorthY, seed ) );
+
+        __m128 weightEast = SmoothStep3Lanes( _mm_sub_ps( currentPosX, cellMinsX ) );
+        __m128 weightNorth = SmoothStep3Lanes( _mm_sub_ps( currentPosY, cellMinsY ) );
+        __m128 weightWest = _mm_sub_ps( ONE_F, weightEast );
+        __m128 weightSouth = _mm_sub_ps( ONE_F, weightNorth );
+
+        __m128 blendSouth = _mm_add_ps( _mm_mul_ps( weightEast, valueSouthEast ),
+                                        _mm_mul_ps( weightWest, valueSouthWest ) );
+        __m128 blendNorth = _mm_add_ps( _mm_mul_ps( weightEast, valueNorthEast ),
+                                        _mm_mul_ps( weightWest, valueNorthWest ) );
+        __m128 blendTotal = _mm_add_ps( _mm_mul_ps( weightSouth, blendSouth ),
+                                        _mm_mul_ps( weightNorth, blendNorth ) );
+        __m128 noiseThisOctave = _mm_mul_ps( _mm_set1_ps( 2.f ),
+                                             _mm_sub_ps( blendTotal, _mm_set1_ps( 0.5f ) ) );
+
+        totalNoise = _mm_add_ps( totalNoise, _mm_mul_ps(
+            noiseThisOctave, _mm_set1_ps( settings.m_amplitudes[octaveNum] ) ) );
+        __m128 octaveScale = _mm_set1_ps( settings.m_octaveScale );
+        currentPosX = _mm_add_ps( _mm_mul_ps( currentPosX, octaveScale ),
+                                  _mm_set1_ps( OCTAVE_OFFSET ) );
+        currentPosY = _mm_add_ps( _mm_mul_ps( currentPosY, octaveScale ),
+                                  _mm_set1_ps( OCTAVE_OFFSET ) );
+    }
+
+    return RenormalizeLanes( totalNoise, settings );
+}
+
+// Compute2dPerlin on 4 lanes
+__m128 Perlin2dLanes( __m128 posX, __m128 posY, const OctaveSettings& settings )
+{
+    const __m128i ONE = _mm_set1_epi32( 1 );
+    const __m128 ONE_F = _mm_set1_ps( 1.f );
+    __m128 totalNoise = _mm_setzero_ps();
+    __m128 invScale = _mm_set1_ps( settings.m_invScale );
+    __m128 currentPosX = _mm_mul_ps( posX, invScale );
+    __m128 currentPosY = _mm_mul_ps( posY, invScale );
+
+    unsigned int numOctaves = (unsigned int) settings.m_amplitudes.size();
+    for( unsigned int octaveNum = 0; octaveNum < numOctaves; ++octaveNum )
+    {
+        __m128i seed = _mm_set1_epi32( (int) ( settings.m_seed + octaveNum ) );
+        __m128 cellMinsX = FloorLanes( currentPosX );
+        __m128 cellMinsY = FloorLanes( currentPosY );
+        __m128 cellMaxsX = _mm_add_ps( cellMinsX, ONE_F );
+        __m128 cellMaxsY = _mm_add_ps( cellMinsY, ONE_F );
+        __m128i indexWestX = _mm_cvttps_epi32( cellMinsX );
+        __m128i indexSouthY = _mm_cvttps_epi32( cellMinsY );
+        __m128i indexEastX = _mm_add_epi32( indexWestX, ONE );
+        __m128i indexNorthY = _mm_add_epi32( indexSouthY, ONE );
+
+        __m128 gradientSWX, gradientSWY, gradientSEX, gradientSEY;
+        __m128 gradientNWX, gradientNWY, gradientNEX, gradientNEY;
+        GetGradientLanes( Get2dUintLanes( indexWestX, indexSouthY, seed ), gradientSWX, gradientSWY );
+        GetGradientLanes( Get2dUintLanes( indexEastX, indexSouthY, seed ), gradientSEX, gradientSEY );
+        GetGradientLanes( Get2dUintLanes( indexWestX, indexNorthY, seed ), gradientNWX, gradientNWY );
+        GetGradientLanes( Get2dUintLanes( indexEastX, indexNorthY, seed ), gradientNEX, gradientNEY );
+
+        __m128 displacementWestX = _mm_sub_ps( currentPosX, cellMinsX );
+        __m128 displacementEastX = _mm_sub_ps( currentPosX, cellMaxsX );
+        __m128 displacementSouthY = _mm_sub_ps( currentPosY, cellMinsY );
+        __m128 displacementNorthY = _mm_sub_ps( currentPosY, cellMaxsY );
+
+        __m128 dotSouthWest = _mm_add_ps( _mm_mul_ps( gradientSWX, displacementWestX ),
+                                          _mm_mul_ps( gradientSWY, displacementSouthY ) );
+        __m128 dotSouthEast = _mm_add_ps( _mm_mul_ps( gradientSEX, displacementEastX ),
+                                          _mm_mul_ps( gradientSEY, displacementSouthY ) );
+        __m128 dotNorthWest = _mm_add_ps( _mm_mul_ps( gradientNWX, displacementWestX ),
+                                          _mm_mul_ps( gradientNWY, displacementNorthY ) );
+        __m128 dotNorthEast = _mm_add_ps( _mm_mul_ps( gradientNEX, displacementEastX ),
+                                          _mm_mul_ps( gradientNEY, displacementNorthY ) );
+
+        __m128 weightEast = SmoothStep3Lanes( displacementWestX );
+        __m128 weightNorth = SmoothStep3Lanes( displacementSouthY );
+        __m128 weightWest = _mm_sub_ps( ONE_F, weightEast );
+        __m128 weightSouth = _mm_sub_ps( ONE_F, weightNorth );
+
+        __m128 blendSouth = _mm_add_ps( _mm_mul_ps( weightEast, dotSouthEast ),
+                                        _mm_mul_ps( weightWest, dotSouthWest ) );
+        __m128 blendNorth = _mm_add_ps( _mm_mul_ps( weightEast, dotNorthEast ),
+                                        _mm_mul_ps( weightWest, dotNorthWest ) );
+        __m128 blendTotal = _mm_add_ps( _mm_mul_ps( weightSouth, blendSouth ),
+                                        _mm_mul_ps( weightNorth, blendNorth ) );
+        __m128 noiseThisOctave = _mm_mul_ps( blendTotal, _mm_set1_ps( 1.f / 0.662578106f ) );
+
+        totalNoise = _mm_add_ps( totalNoise, _mm_mul_ps(
+            noiseThisOctave, _mm_set1_ps( settings.m_amplitudes[octaveNum] ) ) );
+        __m128 octaveScale = _mm_set1_ps( settings.m_octaveScale );
+        currentPosX = _mm_add_ps( _mm_mul_ps( currentPosX, octaveScale ),
+                                  _mm_set1_ps( OCTAVE_OFFSET ) );
+        currentPosY = _mm_add_ps( _mm_mul_ps( currentPosY, octaveScale ),
+                                  _mm_set1_ps( OCTAVE_OFFSET ) );
+    }
+
+    return RenormalizeLanes( totalNoise, settings );
+}
+
+// Sign bit set in the lanes where hash bit BIT is set, for the +-c gradient components
+template<int BIT>
+__m128 GetGradientSignLanes( __m128i noise )
+{
+    return _mm_castsi128_ps( _mm_and_si128( _mm_slli_epi32( noise, 31 - BIT ),
+                                            _mm_set1_epi32( (int) 0x80000000 ) ) );
+}
+
+// GetSimplexCornerContribution in SmoothNoise.cpp, max( a, b ) is a > b ? a : b like the clamp
+__m128 SimplexCornerLanes( __m128 distanceSquared, __m128 gradientDot )
+{
+    __m128 falloff = _mm_sub_ps( _mm_set1_ps( 0.5f ), distanceSquared );
+    falloff = _mm_max_ps( falloff, _mm_setzero_ps() );
+    falloff = _mm_mul_ps( falloff, falloff );
+    return _mm_mul_ps( _mm_mul_ps( falloff, falloff ), gradientDot );
+}
+
+__m128 Dot2Lanes( __m128 ax, __m128 ay, __m128 bx, __m128 by )
+{
+    return _mm_add_ps( _mm_mul_ps( ax, bx ), _mm_mul_ps( ay, by ) );
+}
+
+__m128 Dot3Lanes( __m128 ax, __m128 ay, __m128 az, __m128 bx, __m128 by, __m128 bz )
+{
+    return _mm_add_ps( Dot2Lanes( ax, ay, bx, by ), _mm_mul_ps( az, bz ) );
+}
+
+__m128 Dot4Lanes( __m128 ax, __m128 ay, __m128 az, __m128 aw,
+                  __m128 bx, __m128 by, __m128 bz, __m128 bw )
+{
+    return _mm_add_ps( Dot3Lanes( ax, ay, az, bx, by, bz ), _mm_mul_ps( aw, bw ) );
+}
+
+// Simplex corner steps, 1 where rank > threshold, as ints for hashing and floats for displacement
+void GetSimplexStepLanes( __m128i rank, int threshold, __m128i& out_step, __m128& out_stepFloat )
+{
+    __m128i mask = _mm_cmpgt_epi32( rank, _mm_set1_epi32( threshold ) );
+    out_step = _mm_srli_epi32( mask, 31 );
+    out_stepFloat = _mm_and_ps( _mm_castsi128_ps( mask ), _mm_set1_ps( 1.f ) );
+}
+
+// Compute2dSimplex on 4 lanes
+__m128 Simplex2dLanes( __m128 posX, __m128 posY, const OctaveSettings& settings )
+{
+    const float SKEW = 0.366025403784f;
+    const float UNSKEW = 0.211324865405f;
+    const __m128i ONE = _mm_set1_epi32( 1 );
+    const __m128 ONE_F = _mm_set1_ps( 1.f );
+    const __m128 UNSKEW_1 = _mm_set1_ps( UNSKEW );
+    const __m128 UNSKEW_2 = _mm_set1_ps( 2.f * UNSKEW );
+    __m128 totalNoise = _mm_setzero_ps();
+    __m128 invScale = _mm_set1_ps( settings.m_invScale );
+    __m128 currentPosX = _mm_mul_ps( posX, invScale );
+    __m128 currentPosY = _mm_mul_ps( posY, invScale );
+
+    unsigned int numOctaves = (unsigned int) settings.m_amplitudes.size();
+    for( unsigned int octaveNum = 0; octaveNum < numOctaves; ++octaveNum )
+    {
+        __m128i seed = _mm_set1_epi32( (int) ( settings.m_seed + octaveNum ) );
+        __m128 skew = _mm_mul_ps( _mm_add_ps( currentPosX, currentPosY ), _mm_set1_ps( SKEW ) );
+        __m128 cellMinsX = FloorLanes( _mm_add_ps( currentPosX, skew ) );
+        __m128 cellMinsY = FloorLanes( _mm_add_ps( currentPosY, skew ) );
+        __m128i indexFirstX = _mm_cvttps_epi32( cellMinsX );
+        __m128i indexFirstY = _mm_cvttps_epi32( cellMinsY );
+        __m128 unskew = _mm_mul_ps( _mm_add_ps( cellMinsX, cellMinsY ), UNSKEW_1 );
+        __m128 firstX = _mm_sub_ps( currentPosX, _mm_sub_ps( cellMinsX, unskew ) );
+        __m128 firstY = _mm_sub_ps( currentPosY, _mm_sub_ps( cellMinsY, unskew ) );
+
+        __m128 stepMask = _mm_cmpgt_ps( firstX, firstY );
+        __m128i stepX = _mm_srli_epi32( _mm_castps_si128( stepMask ), 31 );
+        __m128i stepY = _mm_sub_epi32( ONE, stepX );
+        __m128 stepXFloat = _mm_and_ps( stepMask, ONE_F );
+        __m128 stepYFloat = _mm_andnot_ps( stepMask, ONE_F );
+
+        __m128 secondX = _mm_add_ps( _mm_sub_ps( firstX, stepXFloat ), UNSKEW_1 );
+        __m128 secondY = _mm_add_ps( _mm_sub_ps( firstY, stepYFloat ), UNSKEW_1 );
+        __m128 thirdX = _mm_add_ps( _mm_sub_ps( firstX, ONE_F ), UNSKEW_2 );
+        __m128 thirdY = _mm_add_ps( _mm_sub_ps( firstY, ONE_F ), UNSKEW_2 );
+
+        __m128 gradientX, gradientY;
+        GetGradientLanes( Get2dUintLanes( indexFirstX, indexFirstY, seed ), gradientX, gradientY );
+        __m128 blendTotal = SimplexCornerLanes( Dot2Lanes( firstX, firstY, firstX, firstY ),
+                                                Dot2Lanes( gradientX, gradientY, firstX, firstY ) );
+        GetGradientLanes( Get2dUintLanes( _mm_add_epi32( indexFirstX, stepX ),
+                                          _mm_add_epi32( indexFirstY, stepY ), seed ),
+                          gradientX, gradientY );
+        blendTotal = _mm_add_ps( blendTotal, SimplexCornerLanes(
+            Dot2Lanes( secondX, secondY, secondX, secondY ),
+            Dot2Lanes( gradientX, gradientY, secondX, secondY ) ) );
+        GetGradientLanes( Get2dUintLanes( _mm_add_epi32( indexFirstX, ONE ),
+                                          _mm_add_epi32( indexFirstY, ONE ), seed ),
+                          gradientX, gradientY );
+        blendTotal = _mm_add_ps( blendTotal, SimplexCornerLanes(
+            Dot2Lanes( thirdX, thirdY, thirdX, thirdY ),
+            Dot2Lanes( gradientX, gradientY, thirdX, thirdY ) ) );
+        __m128 noiseThisOctave = _mm_mul_ps( blendTotal, _mm_set1_ps( 1.f / 0.00999599154f ) );
+
+        totalNoise = _mm_add_ps( totalNoise, _mm_mul_ps(
+            noiseThisOctave, _mm_set1_ps( settings.m_amplitudes[octaveNum] ) ) );
+        __m128 octaveScale = _mm_set1_ps( settings.m_octaveScale );
+        currentPosX = _mm_add_ps( _mm_mul_ps( currentPosX, octaveScale ),
+                                  _mm_set1_ps( OCTAVE_OFFSET ) );
+        currentPosY = _mm_add_ps( _mm_mul_ps( currentPosY, octaveScale ),
+                                  _mm_set1_ps( OCTAVE_OFFSET ) );
+    }
+
+    return RenormalizeLanes( totalNoise, settings );
+}
+
+// Compute3dSimplex on 4 lanes
+__m128 Simplex3dLanes( __m128 posX, __m128 posY, __m128 posZ, const OctaveSettings& settings )
+{
+    const float SKEW = 0.333333333f;
+    const float UNSKEW = 0.166666667f;
+    const __m128i ONE = _mm_set1_epi32( 1 );
+    const __m128 ONE_F = _mm_set1_ps( 1.f );
+    const __m128 UNSKEW_1 = _mm_set1_ps( UNSKEW );
+    const __m128 UNSKEW_2 = _mm_set1_ps( 2.f * UNSKEW );
+    const __m128 UNSKEW_3 = _mm_set1_ps( 3.f * UNSKEW );
+    const __m128 GRADIENT = _mm_set1_ps( 0.577350269189f );
+    __m128 totalNoise = _mm_setzero_ps();
+    __m128 invScale = _mm_set1_ps( settings.m_invScale );
+    __m128 currentPosX = _mm_mul_ps( posX, invScale );
+    __m128 currentPosY = _mm_mul_ps( posY, invScale );
+    __m128 currentPosZ = _mm_mul_ps( posZ, invScale );
+
+    unsigned int numOctaves = (unsigned int) settings.m_amplitudes.size();
+    for( unsigned int octaveNum = 0; octaveNum < numOctaves; ++octaveNum )
+    {
+        __m128i seed = _mm_set1_epi32( (int) ( settings.m_seed + octaveNum ) );
+        __m128 skew = _mm_mul_ps( _mm_add_ps( _mm_add_ps( currentPosX, currentPosY ), currentPosZ ),
+                                  _mm_set1_ps( SKEW ) );
+        __m128 cellMinsX = FloorLanes( _mm_add_ps( currentPosX, skew ) );
+        __m128 cellMinsY = FloorLanes( _mm_add_ps( currentPosY, skew ) );
+        __m128 cellMinsZ = FloorLanes( _mm_add_ps( currentPosZ, skew ) );
+        __m128i indexFirstX = _mm_cvttps_epi32( cellMinsX );
+        __m128i indexFirstY = _mm_cvttps_epi32( cellMinsY );
+        __m128i indexFirstZ = _mm_cvttps_epi32( cellMinsZ );
+        __m128 unskew = _mm_mul_ps( _mm_add_ps( _mm_add_ps( cellMinsX, cellMinsY ), cellMinsZ ),
+                                    UNSKEW_1 );
+        __m128 firstX = _mm_sub_ps( currentPosX, _mm_sub_ps( cellMinsX, unskew ) );
+        __m128 firstY = _mm_sub_ps( currentPosY, _mm_sub_ps( cellMinsY, unskew ) );
+        __m128 firstZ = _mm_sub_ps( currentPosZ, _mm_sub_ps( cellMinsZ, unskew ) );
+
+        // masks are -1 where true, so subtracting one counts it
+        __m128i greaterXY = _mm_castps_si128( _mm_cmpgt_ps( firstX, firstY ) );
+        __m128i greaterXZ = _mm_castps_si128( _mm_cmpgt_ps( firstX, firstZ ) );
+        __m128i greaterYZ = _mm_castps_si128( _mm_cmpgt_ps( firstY, firstZ ) );
+        __m128i rankX = _mm_sub_epi32( _mm_sub_epi32( _mm_setzero_si128(), greaterXY ), greaterXZ );
+        __m128i rankY = _mm_sub_epi32( _mm_add_epi32( ONE, greaterXY ), greaterYZ );
+        __m128i rankZ = _mm_add_epi32( _mm_add_epi32( ONE, greaterXZ ), _mm_add_epi32( ONE, greaterYZ ) );
+
+        __m128i secondStepX, secondStepY, secondStepZ, thirdStepX, thirdStepY, thirdStepZ;
+        __m128 secondStepXFloat, secondStepYFloat, secondStepZFloat;
+        __m128 thirdStepXFloat, thirdStepYFloat, thirdStepZFloat;
+        GetSimplexStepLanes( rankX, 1, secondStepX, secondStepXFloat );
+        GetSimplexStepLanes( rankY, 1, secondStepY, secondStepYFloat );
+        GetSimplexStepLanes( rankZ, 1, secondStepZ, secondStepZFloat );
+        GetSimplexStepLanes( rankX, 0, thirdStepX, thirdStepXFloat );
+        GetSimplexStepLanes( rankY, 0, thirdStepY, thirdStepYFloat );
+        GetSimplexStepLanes( rankZ, 0, thirdStepZ, thirdStepZFloat );
+
+        __m128 cornerX[4];
+        __m128 cornerY[4];
+        __m128 cornerZ[4];
+        __m128i noise[4];
+        cornerX[0] = firstX;
+        cornerY[0] = firstY;
+        cornerZ[0] = firstZ;
+        cornerX[1] = _mm_add_ps( _mm_sub_ps( firstX, secondStepXFloat ), UNSKEW_1 );
+        cornerY[1] = _mm_add_ps( _mm_sub_ps( firstY, secondStepYFloat ), UNSKEW_1 );
+        cornerZ[1] = _mm_add_ps( _mm_sub_ps( firstZ, secondStepZFloat ), UNSKEW_1 );
+        cornerX[2] = _mm_add_ps( _mm_sub_ps( firstX, thirdStepXFloat ), UNSKEW_2 );
+        cornerY[2] = _mm_add_ps( _mm_sub_ps( firstY, thirdStepYFloat ), UNSKEW_2 );
+        cornerZ[2] = _mm_add_ps( _mm_sub_ps( firstZ, thirdStepZFloat ), UNSKEW_2 );
+        cornerX[3] = _mm_add_ps( _mm_sub_ps( firstX, ONE_F ), UNSKEW_3 );
+        cornerY[3] = _mm_add_ps( _mm_sub_ps( firstY, ONE_F ), UNSKEW_3 );
+        cornerZ[3] = _mm_add_ps( _mm_sub_ps( firstZ, ONE_F ), UNSKEW_3 );
+        noise[0] = Get3dUintLanes( indexFirstX, indexFirstY, indexFirstZ, seed );
+        noise[1] = Get3dUintLanes( _mm_add_epi32( indexFirstX, secondStepX ),
+                                   _mm_add_epi32( indexFirstY, secondStepY ),
+                                   _mm_add_epi32( indexFirstZ, secondStepZ ), seed );
+        noise[2] = Get3dUintLanes( _mm_add_epi32( indexFirstX, thirdStepX ),
+                                   _mm_add_epi32( indexFirstY, thirdStepY ),
+                                   _mm_add_epi32( indexFirstZ, thirdStepZ ), seed );
+        noise[3] = Get3dUintLanes( _mm_add_epi32( indexFirstX, ONE ),
+                                   _mm_add_epi32( indexFirstY, ONE ),
+                                   _mm_add_epi32( indexFirstZ, ONE ), seed );
+
+        __m128 blendTotal = _mm_setzero_ps();
+        for( int cornerIdx = 0; cornerIdx < 4; ++cornerIdx )
+        {
+            __m128 gradientX = _mm_xor_ps( GRADIENT, GetGradientSignLanes<0>( noise[cornerIdx] ) );
+            __m128 gradientY = _mm_xor_ps( GRADIENT, GetGradientSignLanes<1>( noise[cornerIdx] ) );
+            __m128 gradientZ = _mm_xor_ps( GRADIENT, GetGradientSignLanes<2>( noise[cornerIdx] ) );
+            __m128 contribution = SimplexCornerLanes(
+                Dot3Lanes( cornerX[cornerIdx], cornerY[cornerIdx], cornerZ[cornerIdx],
+                           cornerX[cornerIdx], cornerY[cornerIdx], cornerZ[cornerIdx] ),
+                Dot3Lanes( gradientX, gradientY, gradientZ,
+                           cornerX[cornerIdx], cornerY[cornerIdx], cornerZ[cornerIdx] ) );
+            // first corner alone, so 0 + c doesn't turn a -0 into +0 where the scalar one has -0
+            blendTotal = cornerIdx == 0 ? contribution : _mm_add_ps( blendTotal, contribution );
+        }
+        __m128 noiseThisOctave = _mm_mul_ps( blendTotal, _mm_set1_ps( 1.f / 0.00928906293f ) );
+
+        totalNoise = _mm_add_ps( totalNoise, _mm_mul_ps(
+            noiseThisOctave, _mm_set1_ps( settings.m_amplitudes[octaveNum] ) ) );
+        __m128 octaveScale = _mm_set1_ps( settings.m_octaveScale );
+        currentPosX = _mm_add_ps( _mm_mul_ps( currentPosX, octaveScale ),
+                                  _mm_set1_ps( OCTAVE_OFFSET ) );
+        currentPosY = _mm_add_ps( _mm_mul_ps( currentPosY, octaveScale ),
+                                  _mm_set1_ps( OCTAVE_OFFSET ) );
+        currentPosZ = _mm_add_ps( _mm_mul_ps( currentPosZ, octaveScale ),
+                                  _mm_set1_ps( OCTAVE_OFFSET ) );
+    }
+
+    return RenormalizeLanes( totalNoise, settings );
+}
+
+// Compute4dSimplex on 4 lanes
+__m128 Simplex4dLanes( __m128 posX, __m128 posY, __m128 posZ, __m128 posT,
+                       const OctaveSettings& settings )
+{
+    const float SKEW = 0.309016994375f;
+    const float UNSKEW = 0.138196601125f;
+    const __m128i ONE = _mm_set1_epi32( 1 );
+    const __m128 GRADIENT = _mm_set1_ps( 0.5f );
+    const __m128 UNSKEWS[5] = { _mm_setzero_ps(), _mm_set1_ps( UNSKEW ),
+                                _mm_set1_ps( 2.f * UNSKEW ), _mm_set1_ps( 3.f * UNSKEW ),
+                                _mm_set1_ps( 4.f * UNSKEW ) };
+    __m128 totalNoise = _mm_setzero_ps();
+    __m128 invScale = _mm_set1_ps( settings.m_invScale );
+    __m128 currentPosX = _mm_mul_ps( posX, invScale );
+    __m128 currentPosY = _mm_mul_ps( posY, invScale );
+    __m128 currentPosZ = _mm_mul_ps( posZ, invScale );
+    __m128 currentPosT = _mm_mul_ps( posT, invScale );
+
+    unsigned int numOctaves = (unsigned int) settings.m_amplitudes.size();
+    for( unsigned int octaveNum = 0; octaveNum < numOctaves; ++octaveNum )
+    {
+        __m128i seed = _mm_set1_epi32( (int) ( settings.m_seed + octaveNum ) );
+        __m128 skew = _mm_add_ps( _mm_add_ps( _mm_add_ps( currentPosX, currentPosY ), currentPosZ ),
+                                  currentPosT );
+        skew = _mm_mul_ps( skew, _mm_set1_ps( SKEW ) );
+        __m128 cellMinsX = FloorLanes( _mm_add_ps( currentPosX, skew ) );
+        __m128 cellMinsY = FloorLanes( _mm_add_ps( currentPosY, skew ) );
+        __m128 cellMinsZ = FloorLanes( _mm_add_ps( currentPosZ, skew ) );
+        __m128 cellMinsT = FloorLanes( _mm_add_ps( currentPosT, skew ) );
+        __m128i indexFirstX = _mm_cvttps_epi32( cellMinsX );
+        __m128i indexFirstY = _mm_cvttps_epi32( cellMinsY );
+        __m128i indexFirstZ = _mm_cvttps_epi32( cellMinsZ );
+        __m128i indexFirstT = _mm_cvttps_epi32( cellMinsT );
+        __m128 unskew = _mm_add_ps( _mm_add_ps( _mm_add_ps( cellMinsX, cellMinsY ), cellMinsZ ),
+                                    cellMinsT );
+        unskew = _mm_mul_ps( unskew, UNSKEWS[1] );
+        __m128 firstX = _mm_sub_ps( currentPosX, _mm_sub_ps( cellMinsX, unskew ) );
+        __m128 firstY = _mm_sub_ps( currentPosY, _mm_sub_ps( cellMinsY, unskew ) );
+        __m128 firstZ = _mm_sub_ps( currentPosZ, _mm_sub_ps( cellMinsZ, unskew ) );
+        __m128 firstT = _mm_sub_ps( currentPosT, _mm_sub_ps( cellMinsT, unskew ) );
+
+        // masks are -1 where true, so subtracting one counts it
+        __m128i greaterXY = _mm_castps_si128( _mm_cmpgt_ps( firstX, firstY ) );
+        __m128i greaterXZ = _mm_castps_si128( _mm_cmpgt_ps( firstX, firstZ ) );
+        __m128i greaterXT = _mm_castps_si128( _mm_cmpgt_ps( firstX, firstT ) );
+        __m128i greaterYZ = _mm_castps_si128( _mm_cmpgt_ps( firstY, firstZ ) );
+        __m128i greaterYT = _mm_castps_si128( _mm_cmpgt_ps( firstY, firstT ) );
+        __m128i greaterZT = _mm_castps_si128( _mm_cmpgt_ps( firstZ, firstT ) );
+        __m128i rankX = _mm_sub_epi32( _mm_sub_epi32( _mm_sub_epi32( _mm_setzero_si128(), greaterXY ),
+                                                      greaterXZ ), greaterXT );
+        __m128i rankY = _mm_sub_epi32( _mm_sub_epi32( _mm_add_epi32( ONE, greaterXY ), greaterYZ ),
+                                       greaterYT );
+        __m128i rankZ = _mm_sub_epi32( _mm_add_epi32( _mm_add_epi32( ONE, greaterXZ ),
+                                                      _mm_add_epi32( ONE, greaterYZ ) ), greaterZT );
+        __m128i rankT = _mm_add_epi32( _mm_add_epi32( _mm_add_epi32( ONE, greaterXT ),
+                                                      _mm_add_epi32( ONE, greaterYT ) ),
+                                       _mm_add_epi32( ONE, greaterZT ) );
+
+        __m128 blendTotal = _mm_setzero_ps();
+        for( int cornerIdx = 0; cornerIdx < 5; ++cornerIdx )
+        {
+            // corner n steps along every axis ranked above 4 - n
+            __m128i stepX = _mm_setzero_si128();
+            __m128i stepY = _mm_setzero_si128();
+            __m128i stepZ = _mm_setzero_si128();
+            __m128i stepT = _mm_setzero_si128();
+            __m128 stepXFloat = _mm_setzero_ps();
+            __m128 stepYFloat = _mm_setzero_ps();
+            __m128 stepZFloat = _mm_setzero_ps();
+            __m128 stepTFloat = _mm_setzero_ps();
+            if( cornerIdx > 0 )
+            {
+                int threshold = 3 - cornerIdx;
+                GetSimplexStepLanes( rankX, threshold, stepX, stepXFloat );
+                GetSimplexStepLanes( rankY, threshold, stepY, stepYFloat );
+                GetSimplexStepLanes( rankZ, threshold, stepZ, stepZFloat );
+                GetSimplexStepLanes( rankT, threshold, stepT, stepTFloat );
+            }
+
+            __m128 cornerX = firstX;
+            __m128 cornerY = firstY;
+            __m128 cornerZ = firstZ;
+            __m128 cornerT = firstT;
+            if( cornerIdx > 0 )
+            {
+                cornerX = _mm_add_ps( _mm_sub_ps( firstX, stepXFloat ), UNSKEWS[cornerIdx] );
+                cornerY = _mm_add_ps( _mm_sub_ps( firstY, stepYFloat ), UNSKEWS[cornerIdx] );
+                cornerZ = _mm_add_ps( _mm_sub_ps( firstZ, stepZFloat ), UNSKEWS[cornerIdx] );
+                cornerT = _mm_add_ps( _mm_sub_ps( firstT, stepTFloat ), UNSKEWS[cornerIdx] );
+            }
+            __m128i noise = Get4dUintLanes( _mm_add_epi32( indexFirstX, stepX ),
+                                            _mm_add_epi32( indexFirstY, stepY ),
+                                            _mm_add_epi32( indexFirstZ, stepZ ),
+                                            _mm_add_epi32( indexFirstT, stepT ), seed );
+
+            __m128 gradientX = _mm_xor_ps( GRADIENT, GetGradientSignLanes<0>( noise ) );
+            __m128 gradientY = _mm_xor_ps( GRADIENT, GetGradientSignLanes<1>( noise ) );
+            __m128 gradientZ = _mm_xor_ps( GRADIENT, GetGradientSignLanes<2>( noise ) );
+            __m128 gradientT = _mm_xor_ps( GRADIENT, GetGradientSignLanes<3>( noise ) );
+            __m128 contribution = SimplexCornerLanes(
+                Dot4Lanes( cornerX, cornerY, cornerZ, cornerT, cornerX, cornerY, cornerZ, cornerT ),
+                Dot4Lanes( gradientX, gradientY, gradientZ, gradientT,
+                           cornerX, cornerY, cornerZ, cornerT ) );
+            blendTotal = cornerIdx == 0 ? contribution : _mm_add_ps( blendTotal, contribution );
+        }
+        __m128 noiseThisOctave = _mm_mul_ps( blendTotal, _mm_set1_ps( 1.f / 0.00919673505f ) );
+
+        totalNoise = _mm_add_ps( totalNoise, _mm_mul_ps(
+            noiseThisOctave, _mm_set1_ps( settings.m_amplitudes[octaveNum] ) ) );
+        __m128 octaveScale = _mm_set1_ps( settings.m_octaveScale );
+        currentPosX = _mm_add_ps( _mm_mul_ps( currentPosX, octaveScale ),
+                                  _mm_set1_ps( OCTAVE_OFFSET ) );
+        currentPosY = _mm_add_ps( _mm_mul_ps( currentPosY, octaveScale ),
+                                  _mm_set1_ps( OCTAVE_OFFSET ) );
+        currentPosZ = _mm_add_ps( _mm_mul_ps( currentPosZ, octaveScale ),
+                                  _mm_set1_ps( OCTAVE_OFFSET ) );
+        currentPosT = _mm_add_ps( _mm_mul_ps( currentPosT, octaveScale ),
+                                  _mm_set1_ps( OCTAVE_OFFSET ) );
+    }
+
+    return RenormalizeLanes( totalNoise, settings );
+}
+
+template<Noise2dLanesFunction NOISE_LANES, Noise2dFunction NOISE>
+void Compute2dBatch( const Vec2* positions, float* out_noise, int count, float scale,
+                   unsigned int numOctaves, float octavePersistence, float octaveScale,
+                   bool renormalize, unsigned int seed )
+{
+    OctaveSettings settings( scale, numOctaves, octavePersistence, octaveScale, renormalize, seed );
+
+    int idx = 0;
+    for( ; idx + 4 <= count; idx += 4 )
+    {
+        __m128 posX = _mm_setr_ps( positions[idx].x, positions[idx + 1].x,
+                                   positions[idx + 2].x, positions[idx + 3].x );
+        __m128 posY = _mm_setr_ps( positions[idx].y, positions[idx + 1].y,
+                                   positions[idx + 2].y, positions[idx + 3].y );
+        _mm_storeu_ps( out_noise + idx, NOISE_LANES( posX, posY, settings ) );
+    }
+    for( ; idx < count; ++idx )
+    {
+        out_noise[idx] = NOISE( positions[idx].x, positions[idx].y, scale, numOctaves,
+                                octavePersistence, octaveScale, renormalize, seed );
+    }
+}
+
+template<Noise2dLanesFunction NOISE_LANES, Noise2dFunction NOISE>
+void Compute2dGrid( float* out_noise, const IVec2& dimensions, const Vec2& mins,
+                  const Vec2& spacing, float scale, unsigned int numOctaves,
+                  float octavePersistence, float octaveScale, bool renormalize,
+                  unsigned int seed )
+{
+    OctaveSettings settings( scale, numOctaves, octavePersistence, octaveScale, renormalize, seed );
+    __m128 minsX = _mm_set1_ps( mins.x );
+    __m128 spacingX = _mm_set1_ps( spacing.x );
+
+    for( int y = 0; y < dimensions.y; ++y )
+    {
+        float posY = mins.y + spacing.y * (float) y;
+        __m128 posYLanes = _mm_set1_ps( posY );
+        float* rowNoise = out_noise + IVec2::CoordsToIndex( 0, y, dimensions.x );
+
+        int x = 0;
+        for( ; x + 4 <= dimensions.x; x += 4 )
+        {
+            __m128 column = _mm_cvtepi32_ps( _mm_setr_epi32( x, x + 1, x + 2, x + 3 ) );
+            __m128 posX = _mm_add_ps( minsX, _mm_mul_ps( spacingX, column ) );
+            _mm_storeu_ps( rowNoise + x, NOISE_LANES( posX, posYLanes, settings ) );
+        }
+        for( ; x < dimensions.x; ++x )
+        {
+            rowNoise[x] = NOISE( mins.x + spacing.x * (float) x, posY, scale, numOctaves,
+                                 octavePersistence, octaveScale, renormalize, seed );
+        }
+    }
+}
+
+template<Noise3dLanesFunction NOISE_LANES, Noise3dFunction NOISE>
+void Compute3dBatch( const Vec3* positions, float* out_noise, int count, float scale,
+                     unsigned int numOctaves, float octavePersistence, float octaveScale,
+                     bool renormalize, unsigned int seed )
+{
+    OctaveSettings settings( scale, numOctaves, octavePersistence, octaveScale, renormalize, seed );
+
+    int idx = 0;
+    for( ; idx + 4 <= count; idx += 4 )
+    {
+        __m128 posX = _mm_setr_ps( positions[idx].x, positions[idx + 1].x,
+                                   positions[idx + 2].x, positions[idx + 3].x );
+        __m128 posY = _mm_setr_ps( positions[idx].y, positions[idx + 1].y,
+                                   positions[idx + 2].y, positions[idx + 3].y );
+        __m128 posZ = _mm_setr_ps( positions[idx].z, positions[idx + 1].z,
+                                   positions[idx + 2].z, positions[idx + 3].z );
+        _mm_storeu_ps( out_noise + idx, NOISE_LANES( posX, posY, posZ, settings ) );
+    }
+    for( ; idx < count; ++idx )
+    {
+        out_noise[idx] = NOISE( positions[idx].x, positions[idx].y, positions[idx].z, scale,
+                                numOctaves, octavePersistence, octaveScale, renormalize, seed );
+    }
+}
+
+template<Noise4dLanesFunction NOISE_LANES, Noise4dFunction NOISE>
+void Compute4dBatch( const Vec4* positions, float* out_noise, int count, float scale,
+                     unsigned int numOctaves, float octavePersistence, float octaveScale,
+                     bool renormalize, unsigned int seed )
+{
+    OctaveSettings settings( scale, numOctaves, octavePersistence, octaveScale, renormalize, seed );
+
+    int idx = 0;
+    for( ; idx + 4 <= count; idx += 4 )
+    {
+        // Vec4 is 4 packed floats, so this is a plain transpose
+        __m128 posX = _mm_loadu_ps( &positions[idx].x );
+        __m128 posY = _mm_loadu_ps( &positions[idx + 1].x );
+        __m128 posZ = _mm_loadu_ps( &positions[idx + 2].x );
+        __m128 posT = _mm_loadu_ps( &positions[idx + 3].x );
+        _MM_TRANSPOSE4_PS( posX, posY, posZ, posT );
+        _mm_storeu_ps( out_noise + idx, NOISE_LANES( posX, posY, posZ, posT, settings ) );
+    }
+    for( ; idx < count; ++idx )
+    {
+        out_noise[idx] = NOISE( positions[idx].x, positions[idx].y, positions[idx].z,
+                                positions[idx].w, scale, numOctaves, octavePersistence,
+                                octaveScale, renormalize, seed );
+    }
+}
+
+#else
+
+template<Noise2dFunction NOISE>
+void Compute2dBatch( const Vec2* positions, float* out_noise, int count, float scale,
+                   unsigned int numOctaves, float octavePersistence, float octaveScale,
+                   bool renormalize, unsigned int seed )
+{
+    for( int idx = 0; idx < count; ++idx )
+    {
+        out_noise[idx] = NOISE( positions[idx].x, positions[idx].y, scale, numOctaves,
+                                octavePersistence, octaveScale, renormalize, seed );
+    }
+}
+
+template<Noise2dFunction NOISE>
+void Compute2dGrid( float* out_noise, const IVec2& dimensions, const Vec2& mins,
+                  const Vec2& spacing, float scale, unsigned int numOctaves,
+                  float octavePersistence, float octaveScale, bool renormalize,
+                  unsigned int seed )
+{
+    for( int y = 0; y < dimensions.y; ++y )
+    {
+        float posY = mins.y + spacing.y * (float) y;
+        float* rowNoise = out_noise + IVec2::CoordsToIndex( 0, y, dimensions.x );
+        for( int x = 0; x < dimensions.x; ++x )
+        {
+            rowNoise[x] = NOISE( mins.x + spacing.x * (float) x, posY, scale, numOctaves,
+                                 octavePersistence, octaveScale, renormalize, seed );
+        }
+    }
+}
+
+template<Noise3dFunction NOISE>
+void Compute3dBatch( const Vec3* positions, float* out_noise, int count, float scale,
+                     unsigned int numOctaves, float octavePersistence, float octaveScale,
+                     bool renormalize, unsigned int seed )
+{
+    for( int idx = 0; idx < count; ++idx )
+    {
+        out_noise[idx] = NOISE( positions[idx].x, positions[idx].y, positions[idx].z, scale,
+                                numOctaves, octavePersistence, octaveScale, renormalize, seed );
+    }
+}
+
+template<Noise4dFunction NOISE>
+void Compute4dBatch( const Vec4* positions, float* out_noise, int count, float scale,
+                     unsigned int numOctaves, float octavePersistence, float octaveScale,
+                     bool renormalize, unsigned int seed )
+{
+    for( int idx = 0; idx < count; ++idx )
+    {
+        out_noise[idx] = NOISE( positions[idx].x, positions[idx].y, positions[idx].z,
+                                positions[idx].w, scale, numOctaves, octavePersistence,
+                                octaveScale, renormalize, seed );
+    }
+}
+
+#endif // ENGINE_SIMD_SSE
+
+}
+
+void Get2dUintBatch( const int* indicesX, const int* indicesY, unsigned int* out_noise,
+                     int count, unsigned int seed /*= 0 */ )
+{
+    int idx = 0;
+#if defined( ENGINE_SIMD_SSE )
+    __m128i seedLanes = _mm_set1_epi32( (int) seed );
+    for( ; idx + 4 <= count; idx += 4 )
+    {
+        __m128i indexX = _mm_loadu_si128( (const __m128i*) ( indicesX + idx ) );
+        __m128i indexY = _mm_loadu_si128( (const __m128i*) ( indicesY + idx ) );
+        _mm_storeu_si128( (__m128i*) ( out_noise + idx ),
+                          Get2dUintLanes( indexX, indexY, seedLanes ) );
+    }
+#endif
+    for( ; idx < count; ++idx )
+        out_noise[idx] = Get2dUint( indicesX[idx], indicesY[idx], seed );
+}
+
+void Compute2dFractalBatch( const Vec2* positions, float* out_noise, int count,
+                            float scale /*= 1.f*/, unsigned int numOctaves /*= 1*/,
+                            float octavePersistence /*= 0.5f*/, float octaveScale /*= 2.f*/,
+                            bool renormalize /*= true*/, unsigned int seed /*= 0 */ )
+{
+#if defined( ENGINE_SIMD_SSE )
+    Compute2dBatch<Fractal2dLanes, Compute2dFractal>(
+#else
+    Compute2dBatch<Compute2dFractal>(
+#endif
+        positions, out_noise, count, scale, numOctaves, octavePersistence, octaveScale,
+        renormalize, seed );
+}
+
+void Compute2dPerlinBatch( const Vec2* positions, float* out_noise, int count,
+                           float scale /*= 1.f*/, unsigned int numOctaves /*= 1*/,
+                           float octavePersistence /*= 0.5f*/, float octaveScale /*= 2.f*/,
+                           bool renormalize /*= true*/, unsigned int seed /*= 0 */ )
+{
+#if defined( ENGINE_SIMD_SSE )
+    Compute2dBatch<Perlin2dLanes, Compute2dPerlin>(
+#else
+    Compute2dBatch<Compute2dPerlin>(
+#endif
+        positions, out_noise, count, scale, numOctaves, octavePersistence, octaveScale,
+        renormalize, seed );
+}
+
+void Compute2dSimplexBatch( const Vec2* positions, float* out_noise, int count,
+                            float scale /*= 1.f*/, unsigned int numOctaves /*= 1*/,
+                            float octavePersistence /*= 0.5f*/, float octaveScale /*= 2.f*/,
+                            bool renormalize /*= true*/, unsigned int seed /*= 0 */ )
+{
+#if defined( ENGINE_SIMD_SSE )
+    Compute2dBatch<Simplex2dLanes, Compute2dSimplex>(
+#else
+    Compute2dBatch<Compute2dSimplex>(
+#endif
+        positions, out_noise, count, scale, numOctaves, octavePersistence, octaveScale,
+        renormalize, seed );
+}
+
+void Compute3dSimplexBatch( const Vec3* positions, float* out_noise, int count,
+                            float scale /*= 1.f*/, unsigned int numOctaves /*= 1*/,
+                            float octavePersistence /*= 0.5f*/, float octaveScale /*= 2.f*/,
+                            bool renormalize /*= true*/, unsigned int seed /*= 0 */ )
+{
+#if defined( ENGINE_SIMD_SSE )
+    Compute3dBatch<Simplex3dLanes, Compute3dSimplex>(
+#else
+    Compute3dBatch<Compute3dSimplex>(
+#endif
+        positions, out_noise, count, scale, numOctaves, octavePersistence, octaveScale,
+        renormalize, seed );
+}
+
+void Compute4dSimplexBatch( const Vec4* positions, float* out_noise, int count,
+                            float scale /*= 1.f*/, unsigned int numOctaves /*= 1*/,
+                            float octavePersistence /*= 0.5f*/, float octaveScale /*= 2.f*/,
+                            bool renormalize /*= true*/, unsigned int seed /*= 0 */ )
+{
+#if defined( ENGINE_SIMD_SSE )
+    Compute4dBatch<Simplex4dLanes, Compute4dSimplex>(
+#else
+    Compute4dBatch<Compute4dSimplex>(
+#endif
+        positions, out_noise, count, scale, numOctaves, octavePersistence, octaveScale,
+        renormalize, seed );
+}
+
+void Compute2dFractalGrid( float* out_noise, const IVec2& dimensions, const Vec2& mins,
+                           const Vec2& spacing, float scale /*= 1.f*/,
+                           unsigned int numOctaves /*= 1*/, float octavePersistence /*= 0.5f*/,
+                           float octaveScale /*= 2.f*/, bool renormalize /*= true*/,
+                           unsigned int seed /*= 0 */ )
+{
+#if defined( ENGINE_SIMD_SSE )
+    Compute2dGrid<Fractal2dLanes, Compute2dFractal>(
+#else
+    Compute2dGrid<Compute2dFractal>(
+#endif
+        out_noise, dimensions, mins, spacing, scale, numOctaves, octavePersistence,
+        octaveScale, renormalize, seed );
+}
+
+void Compute2dPerlinGrid( float* out_noise, const IVec2& dimensions, const Vec2& mins,
+                          const Vec2& spacing, float scale /*= 1.f*/,
+                          unsigned int numOctaves /*= 1*/, float octavePersistence /*= 0.5f*/,
+                          float octaveScale /*= 2.f*/, bool renormalize /*= true*/,
+                          unsigned int seed /*= 0 */ )
+{
+#if defined( ENGINE_SIMD_SSE )
+    Compute2dGrid<Perlin2dLanes, Compute2dPerlin>(
+#else
+    Compute2dGrid<Compute2dPerlin>(
+#endif
+        out_noise, dimensions, mins, spacing, scale, numOctaves, octavePersistence,
+        octaveScale, renormalize, seed );
+}
+
+void Compute2dSimplexGrid( float* out_noise, const IVec2& dimensions, const Vec2& mins,
+                           const Vec2& spacing, float scale /*= 1.f*/,
+                           unsigned int numOctaves /*= 1*/, float octavePersistence /*= 0.5f*/,
+                           float octaveScale /*= 2.f*/, bool renormalize /*= true*/,
+                           unsigned int seed /*= 0 */ )
+{
+#if defined( ENGINE_SIMD_SSE )
+    Compute2dGrid<Simplex2dLanes, Compute2dSimplex>(
+#else
+    Compute2dGrid<Compute2dSimplex>(
+#endif
+        out_noise, dimensions, mins, spacing, scale, numOctaves, octavePersistence,
+        octaveScale, renormalize, seed );
+}
+
+void Compute2dPerlinGrid( HeatMap<float>& out_heatMap, const Vec2& mins, const Vec2& spacing,
+                          float scale /*= 1.f*/, unsigned int numOctaves /*= 1*/,
+                          float octavePersistence /*= 0.5f*/, float octaveScale /*= 2.f*/,
+                          bool renormalize /*= true*/, unsigned int seed /*= 0 */ )
+{
+    Compute2dPerlinGrid( out_heatMap.GetData(), out_heatMap.GetDimensions(), mins, spacing,
+                         scale, numOctaves, octavePersistence, octaveScale, renormalize, seed );
+}
+
+void Compute2dPerlinGrid( Image& out_image, const Vec2& mins, const Vec2& spacing,
+                          float scale /*= 1.f*/, unsigned int numOctaves /*= 1*/,
+                          float octavePersistence /*= 0.5f*/, float octaveScale /*= 2.f*/,
+                          bool renormalize /*= true*/, unsigned int seed /*= 0 */ )
+{
+    IVec2 dimensions = out_image.GetDimentions();
+    std::vector<float> noise( out_image.m_texels.size() );
+    Compute2dPerlinGrid( noise.data(), dimensions, mins, spacing, scale, numOctaves,
+                         octavePersistence, octaveScale, renormalize, seed );
+
+    for( size_t texelIdx = 0; texelIdx < noise.size(); ++texelIdx )
+    {
+        float height = Clampf01( noise[texelIdx] * 0.5f + 0.5f );
+        unsigned char grey = (unsigned char) ( height * 255.f );
+        Rgba& texel = out_image.m_texels[texelIdx];
+        texel.r = grey;
+        texel.g = grey;
+        texel.b = grey;
+    }
+}
+
+}
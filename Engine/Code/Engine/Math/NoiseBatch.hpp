@@ -0,0 +1,70 @@
+#pragma once
+
+class Vec2;
+class Vec3;
+class Vec4;
+class IVec2;
+class Image;
+template<typename T> class HeatMap;
+
+// Many sample versions of the functions in RawNoise.hpp and SmoothNoise.hpp
+// Hashing runs 4 samples across SSE lanes and the per octave amplitude and seed math is
+// done once per call instead of once per sample, the remainder is done one at a time
+// Every version gives bit identical results to calling the single sample function
+// on the same inputs, so batched and unbatched noise can be mixed freely
+namespace Noise
+{
+
+void Get2dUintBatch( const int* indicesX, const int* indicesY, unsigned int* out_noise,
+                     int count, unsigned int seed = 0 );
+
+void Compute2dFractalBatch( const Vec2* positions, float* out_noise, int count,
+                            float scale = 1.f, unsigned int numOctaves = 1,
+                            float octavePersistence = 0.5f, float octaveScale = 2.f,
+                            bool renormalize = true, unsigned int seed = 0 );
+void Compute2dPerlinBatch( const Vec2* positions, float* out_noise, int count,
+                           float scale = 1.f, unsigned int numOctaves = 1,
+                           float octavePersistence = 0.5f, float octaveScale = 2.f,
+                           bool renormalize = true, unsigned int seed = 0 );
+
+void Compute2dSimplexBatch( const Vec2* positions, float* out_noise, int count,
+                            float scale = 1.f, unsigned int numOctaves = 1,
+                            float octavePersistence = 0.5f, float octaveScale = 2.f,
+                            bool renormalize = true, unsigned int seed = 0 );
+void Compute3dSimplexBatch( const Vec3* positions, float* out_noise, int count,
+                            float scale = 1.f, unsigned int numOctaves = 1,
+                            float octavePersistence = 0.5f, float octaveScale = 2.f,
+                            bool renormalize = true, unsigned int seed = 0 );
+void Compute4dSimplexBatch( const Vec4* positions, float* out_noise, int count,
+                            float scale = 1.f, unsigned int numOctaves = 1,
+                            float octavePersistence = 0.5f, float octaveScale = 2.f,
+                            bool renormalize = true, unsigned int seed = 0 );
+
+// Samples at mins + spacing * (x, y) for every cell, out_noise is row major
+// and holds dimensions.x * dimensions.y floats
+void Compute2dFractalGrid( float* out_noise, const IVec2& dimensions, const Vec2& mins,
+                           const Vec2& spacing, float scale = 1.f, unsigned int numOctaves = 1,
+                           float octavePersistence = 0.5f, float octaveScale = 2.f,
+                           bool renormalize = true, unsigned int seed = 0 );
+void Compute2dPerlinGrid( float* out_noise, const IVec2& dimensions, const Vec2& mins,
+                          const Vec2& spacing, float scale = 1.f, unsigned int numOctaves = 1,
+                          float octavePersistence = 0.5f, float octaveScale = 2.f,
+                          bool renormalize = true, unsigned int seed = 0 );
+void Compute2dSimplexGrid( float* out_noise, const IVec2& dimensions, const Vec2& mins,
+                           const Vec2& spacing, float scale = 1.f, unsigned int numOctaves = 1,
+                           float octavePersistence = 0.5f, float octaveScale = 2.f,
+                           bool renormalize = true, unsigned int seed = 0 );
+
+// Fills every cell of an already sized heat map
+void Compute2dPerlinGrid( HeatMap<float>& out_heatMap, const Vec2& mins, const Vec2& spacing,
+                          float scale = 1.f, unsigned int numOctaves = 1,
+                          float octavePersistence = 0.5f, float octaveScale = 2.f,
+                          bool renormalize = true, unsigned int seed = 0 );
+// Writes [-1,1] noise as grey [0,255] texels, alpha is left alone
+// Meant for height maps, e.g. SurfacePatch_HeightMap
+void Compute2dPerlinGrid( Image& out_image, const Vec2& mins, const Vec2& spacing,
+                          float scale = 1.f, unsigned int numOctaves = 1,
+                          float octavePersistence = 0.5f, float octaveScale = 2.f,
+                          bool renormalize = true, unsigned int seed = 0 );
+
+}
@@ -0,0 +1,241 @@
+#include "Engine/Math/Quaternion.hpp"
+#include "Engine/Math/Mat4.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/StringUtils.hpp"
+
+const Quaternion Quaternion::IDENTITY = Quaternion();
+
+Quaternion::Quaternion( float initX /*= 0.f*/, float initY /*= 0.f*/, float initZ /*= 0.f*/,
+                        float initW /*= 1.f */ )
+    : x( initX )
+    , y( initY )
+    , z( initZ )
+    , w( initW )
+{
+
+}
+
+Quaternion Quaternion::MakeFromEuler( const Vec3& euler )
+{
+    // yaw * pitch * roll expanded, half angles so 6 trig calls like the matrix version
+    float cy = CosDeg( euler.y * 0.5f );
+    float sy = SinDeg( euler.y * 0.5f );
+    float cp = CosDeg( euler.x * 0.5f );
+    float sp = SinDeg( euler.x * 0.5f );
+    float cr = CosDeg( euler.z * 0.5f );
+    float sr = SinDeg( euler.z * 0.5f );
+
+    Quaternion quat;
+    quat.x = ( cy * sp * cr ) + ( sy * cp * sr );
+    quat.y = ( sy * cp * cr ) - ( cy * sp * sr );
+    quat.z = ( cy * cp * sr ) - ( sy * sp * cr );
+    quat.w = ( cy * cp * cr ) + ( sy * sp * sr );
+    return quat;
+}
+
+Quaternion Quaternion::MakeFromAxisAngle( const Vec3& axis, float angleDeg )
+{
+    Vec3 unitAxis = axis.GetNormalized();
+    float halfSin = SinDeg( angleDeg * 0.5f );
+    return Quaternion( unitAxis.x * halfSin, unitAxis.y * halfSin, unitAxis.z * halfSin,
+                       CosDeg( angleDeg * 0.5f ) );
+}
+
+Quaternion Quaternion::MakeFromMat4( const Mat4& rotation )
+{
+    const Mat4& m = rotation;
+    Quaternion quat;
+
+    // divide by the largest component to stay stable near 180 degrees
+    float trace = m.Ix + m.Jy + m.Kz;
+    if( trace > 0.f )
+    {
+        float s = sqrtf( trace + 1.f ) * 2.f;
+        quat.w = 0.25f * s;
+        quat.x = ( m.Jz - m.Ky ) / s;
+        quat.y = ( m.Kx - m.Iz ) / s;
+        quat.z = ( m.Iy - m.Jx ) / s;
+    }
+    else if( m.Ix > m.Jy && m.Ix > m.Kz )
+    {
+        float s = sqrtf( 1.f + m.Ix - m.Jy - m.Kz ) * 2.f;
+        quat.w = ( m.Jz - m.Ky ) / s;
+        quat.x = 0.25f * s;
+        quat.y = ( m.Jx + m.Iy ) / s;
+        quat.z = ( m.Kx + m.Iz ) / s;
+    }
+    else if( m.Jy > m.Kz )
+    {
+        float s = sqrtf( 1.f + m.Jy - m.Ix - m.Kz ) * 2.f;
+        quat.w = ( m.Kx - m.Iz ) / s;
+        quat.x = ( m.Jx + m.Iy ) / s;
+        quat.y = 0.25f * s;
+        quat.z = ( m.Ky + m.Jz ) / s;
+    }
+    else
+    {
+        float s = sqrtf( 1.f + m.Kz - m.Ix - m.Jy ) * 2.f;
+        quat.w = ( m.Iy - m.Jx ) / s;
+        quat.x = ( m.Kx + m.Iz ) / s;
+        quat.y = ( m.Ky + m.Jz ) / s;
+        quat.z = 0.25f * s;
+    }
+    quat.Normalize();
+    return quat;
+}
+
+const Quaternion Quaternion::operator*( const Quaternion& rhs ) const
+{
+    return Quaternion( ( w * rhs.x ) + ( x * rhs.w ) + ( y * rhs.z ) - ( z * rhs.y ),
+                       ( w * rhs.y ) - ( x * rhs.z ) + ( y * rhs.w ) + ( z * rhs.x ),
+                       ( w * rhs.z ) + ( x * rhs.y ) - ( y * rhs.x ) + ( z * rhs.w ),
+                       ( w * rhs.w ) - ( x * rhs.x ) - ( y * rhs.y ) - ( z * rhs.z ) );
+}
+
+const Vec3 Quaternion::operator*( const Vec3& rhs ) const
+{
+    return Rotate( rhs );
+}
+
+bool Quaternion::operator==( const Quaternion& compare ) const
+{
+    return x == compare.x && y == compare.y && z == compare.z && w == compare.w;
+}
+
+bool Quaternion::operator!=( const Quaternion& compare ) const
+{
+    return !( *this == compare );
+}
+
+Vec3 Quaternion::GetEuler() const
+{
+    // same as GetRotationMatrix().DecomposeEuler() without building the matrix
+    float Ky = 2.f * ( ( y * z ) - ( w * x ) );
+    Ky = ClampfNegativeOneToOne( Ky );
+
+    Vec3 euler;
+    euler.x = -ArcSinDeg( Ky );
+
+    if( Ky != 1 && Ky != -1 )
+    {
+        euler.z = Atan2Deg( 2.f * ( ( x * y ) + ( w * z ) ), 1.f - 2.f * ( ( x * x ) + ( z * z ) ) );
+        euler.y = Atan2Deg( 2.f * ( ( x * z ) + ( w * y ) ), 1.f - 2.f * ( ( x * x ) + ( y * y ) ) );
+    }
+    // pitch is +-90, looking straight up or down, pretend roll is 0, and only calc yaw
+    else
+    {
+        euler.z = 0;
+        euler.y = Atan2Deg( 2.f * ( ( x * y ) - ( w * z ) ), 2.f * ( ( y * z ) + ( w * x ) ) );
+    }
+    return euler;
+}
+
+Mat4 Quaternion::GetRotationMatrix() const
+{
+    float xx = x * x;
+    float yy = y * y;
+    float zz = z * z;
+    float xy = x * y;
+    float xz = x * z;
+    float yz = y * z;
+    float wx = w * x;
+    float wy = w * y;
+    float wz = w * z;
+
+    Mat4 mat;
+    mat.Ix = 1.f - 2.f * ( yy + zz );
+    mat.Iy = 2.f * ( xy + wz );
+    mat.Iz = 2.f * ( xz - wy );
+    mat.Jx = 2.f * ( xy - wz );
+    mat.Jy = 1.f - 2.f * ( xx + zz );
+    mat.Jz = 2.f * ( yz + wx );
+    mat.Kx = 2.f * ( xz + wy );
+    mat.Ky = 2.f * ( yz - wx );
+    mat.Kz = 1.f - 2.f * ( xx + yy );
+    return mat;
+}
+
+Quaternion Quaternion::GetConjugate() const
+{
+    return Quaternion( -x, -y, -z, w );
+}
+
+float Quaternion::GetLengthSquared() const
+{
+    return Dot( *this, *this );
+}
+
+void Quaternion::Normalize()
+{
+    float lengthSq = GetLengthSquared();
+    if( lengthSq == 0.f )
+    {
+        *this = IDENTITY;
+        return;
+    }
+    float invLength = 1.f / sqrtf( lengthSq );
+    x *= invLength;
+    y *= invLength;
+    z *= invLength;
+    w *= invLength;
+}
+
+Quaternion Quaternion::GetNormalized() const
+{
+    Quaternion quat = *this;
+    quat.Normalize();
+    return quat;
+}
+
+Vec3 Quaternion::Rotate( const Vec3& vec ) const
+{
+    // v + w * t + u x t, where t = 2 * u x v
+    Vec3 axis( x, y, z );
+    Vec3 t = 2.f * Cross( axis, vec );
+    return vec + w * t + Cross( axis, t );
+}
+
+String Quaternion::ToString() const
+{
+    return Stringf( "Quaternion(%.3f, %.3f, %.3f, %.3f)", x, y, z, w );
+}
+
+float Dot( const Quaternion& a, const Quaternion& b )
+{
+    return ( a.x * b.x ) + ( a.y * b.y ) + ( a.z * b.z ) + ( a.w * b.w );
+}
+
+Quaternion Slerp( const Quaternion& a, const Quaternion& b, float t )
+{
+    Quaternion end = b;
+    float cosAngle = Dot( a, b );
+    if( cosAngle < 0.f )
+    {
+        end = Quaternion( -b.x, -b.y, -b.z, -b.w );
+        cosAngle = -cosAngle;
+    }
+
+    // nearly the same rotation, sin goes to 0
+    if( cosAngle > 0.9995f )
+        return Nlerp( a, end, t );
+
+    float angle = acosf( Clampf( cosAngle, -1.f, 1.f ) );
+    float den = sinf( angle );
+    float aWeight = sinf( ( 1.f - t ) * angle ) / den;
+    float bWeight = sinf( t * angle ) / den;
+    return Quaternion( aWeight * a.x + bWeight * end.x,
+                       aWeight * a.y + bWeight * end.y,
+                       aWeight * a.z + bWeight * end.z,
+                       aWeight * a.w + bWeight * end.w );
+}
+
+Quaternion Nlerp( const Quaternion& a, const Quaternion& b, float t )
+{
+    float sign = Dot( a, b ) < 0.f ? -1.f : 1.f;
+    Quaternion quat( Lerp( a.x, sign * b.x, t ),
+                     Lerp( a.y, sign * b.y, t ),
+                     Lerp( a.z, sign * b.z, t ),
+                     Lerp( a.w, sign * b.w, t ) );
+    quat.Normalize();
+    return quat;
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include "Engine/Math/Vec3.hpp"
+
+class Mat4;
+
+// Unit quaternion rotation, angles in degrees like the rest of Math
+// a * b rotates by b first, then by a, same order as Mat4
+class Quaternion
+{
+public:
+    static const Quaternion IDENTITY;
+
+    explicit Quaternion( float initX = 0.f, float initY = 0.f, float initZ = 0.f, float initW = 1.f );
+
+    // roll first, then pitch, then yaw, matches Mat4::MakeRotationEuler
+    static Quaternion MakeFromEuler( const Vec3& euler );
+    static Quaternion MakeFromAxisAngle( const Vec3& axis, float angleDeg );
+    // Rotation part must be pure rotation (no scale), translation is ignored
+    static Quaternion MakeFromMat4( const Mat4& rotation );
+
+    // Operators
+    const Quaternion operator*( const Quaternion& rhs ) const;
+    const Vec3 operator*( const Vec3& rhs ) const;
+    bool operator==( const Quaternion& compare ) const;
+    bool operator!=( const Quaternion& compare ) const;
+
+    // Operations
+    Vec3 GetEuler() const;
+    Mat4 GetRotationMatrix() const;
+    // Same as inverse for unit quaternions
+    Quaternion GetConjugate() const;
+    float GetLengthSquared() const;
+    void Normalize();
+    Quaternion GetNormalized() const;
+    Vec3 Rotate( const Vec3& vec ) const;
+    String ToString() const;
+
+    float x = 0.f;
+    float y = 0.f;
+    float z = 0.f;
+    float w = 1.f;
+};
+
+// free functions
+float Dot( const Quaternion& a, const Quaternion& b );
+// Both take the shortest way around
+Quaternion Slerp( const Quaternion& a, const Quaternion& b, float t );
+// Cheaper than Slerp, fine for small steps like network smoothing
+Quaternion Nlerp( const Quaternion& a, const Quaternion& b, float t );
@@ -6,9 +6,94 @@
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Math/AABB3.hpp"
 #include "Engine/Math/IVec2.hpp"
+#include "Engine/Math/SIMD.hpp"
 
 #include <stdarg.h>
 
+namespace
+{
+// Same math as ToAABB3, INFINITY for a miss
+float GetSlabEntry( float startX, float startY, float startZ,
+                    float dirInvX, float dirInvY, float dirInvZ,
+                    float minX, float minY, float minZ, float maxX, float maxY, float maxZ,
+                    float maxDistance )
+{
+    float t1 = ( minX - startX ) * dirInvX;
+    float t2 = ( maxX - startX ) * dirInvX;
+    float t3 = ( minY - startY ) * dirInvY;
+    float t4 = ( maxY - startY ) * dirInvY;
+    float t5 = ( minZ - startZ ) * dirInvZ;
+    float t6 = ( maxZ - startZ ) * dirInvZ;
+
+    float tmin = Maxf( Maxf( Minf( t1, t2 ), Minf( t3, t4 ) ), Minf( t5, t6 ) );
+    float tmax = Minf( Minf( Maxf( t1, t2 ), Maxf( t3, t4 ) ), Maxf( t5, t6 ) );
+
+    // written as the hit test so a NaN from 0 * inf misses like the SIMD lanes do
+    if( !( tmax >= 0.f && tmin <= tmax && tmin <= maxDistance ) )
+        return INFINITY;
+    return tmin;
+}
+
+int CountSetBits( int bits )
+{
+    int count = 0;
+    for( ; bits != 0; bits &= bits - 1 )
+        ++count;
+    return count;
+}
+
+#if defined( ENGINE_SIMD_SSE )
+__m128 GetSlabEntry4( __m128 startX, __m128 startY, __m128 startZ,
+                      __m128 dirInvX, __m128 dirInvY, __m128 dirInvZ,
+                      __m128 minX, __m128 minY, __m128 minZ,
+                      __m128 maxX, __m128 maxY, __m128 maxZ, __m128 maxDistance )
+{
+    __m128 t1 = _mm_mul_ps( _mm_sub_ps( minX, startX ), dirInvX );
+    __m128 t2 = _mm_mul_ps( _mm_sub_ps( maxX, startX ), dirInvX );
+    __m128 t3 = _mm_mul_ps( _mm_sub_ps( minY, startY ), dirInvY );
+    __m128 t4 = _mm_mul_ps( _mm_sub_ps( maxY, startY ), dirInvY );
+    __m128 t5 = _mm_mul_ps( _mm_sub_ps( minZ, startZ ), dirInvZ );
+    __m128 t6 = _mm_mul_ps( _mm_sub_ps( maxZ, startZ ), dirInvZ );
+
+    // _mm_min_ps( a, b ) is a < b ? a : b like Minf, same for max
+    __m128 tmin = _mm_max_ps( _mm_max_ps( _mm_min_ps( t1, t2 ), _mm_min_ps( t3, t4 ) ),
+                              _mm_min_ps( t5, t6 ) );
+    __m128 tmax = _mm_min_ps( _mm_min_ps( _mm_max_ps( t1, t2 ), _mm_max_ps( t3, t4 ) ),
+                              _mm_max_ps( t5, t6 ) );
+
+    __m128 isHit = _mm_and_ps( _mm_cmpge_ps( tmax, _mm_setzero_ps() ), _mm_cmple_ps( tmin, tmax ) );
+    isHit = _mm_and_ps( isHit, _mm_cmple_ps( tmin, maxDistance ) );
+    return _mm_or_ps( _mm_and_ps( isHit, tmin ),
+                      _mm_andnot_ps( isHit, _mm_set1_ps( INFINITY ) ) );
+}
+#endif
+
+#if defined( ENGINE_SIMD_AVX )
+__m256 GetSlabEntry8( __m256 startX, __m256 startY, __m256 startZ,
+                      __m256 dirInvX, __m256 dirInvY, __m256 dirInvZ,
+                      __m256 minX, __m256 minY, __m256 minZ,
+                      __m256 maxX, __m256 maxY, __m256 maxZ, __m256 maxDistance )
+{
+    __m256 t1 = _mm256_mul_ps( _mm256_sub_ps( minX, startX ), dirInvX );
+    __m256 t2 = _mm256_mul_ps( _mm256_sub_ps( maxX, startX ), dirInvX );
+    __m256 t3 = _mm256_mul_ps( _mm256_sub_ps( minY, startY ), dirInvY );
+    __m256 t4 = _mm256_mul_ps( _mm256_sub_ps( maxY, startY ), dirInvY );
+    __m256 t5 = _mm256_mul_ps( _mm256_sub_ps( minZ, startZ ), dirInvZ );
+    __m256 t6 = _mm256_mul_ps( _mm256_sub_ps( maxZ, startZ ), dirInvZ );
+
+    __m256 tmin = _mm256_max_ps( _mm256_max_ps( _mm256_min_ps( t1, t2 ), _mm256_min_ps( t3, t4 ) ),
+                                 _mm256_min_ps( t5, t6 ) );
+    __m256 tmax = _mm256_min_ps( _mm256_min_ps( _mm256_max_ps( t1, t2 ), _mm256_max_ps( t3, t4 ) ),
+                                 _mm256_max_ps( t5, t6 ) );
+
+    __m256 isHit = _mm256_and_ps( _mm256_cmp_ps( tmax, _mm256_setzero_ps(), _CMP_GE_OQ ),
+                                  _mm256_cmp_ps( tmin, tmax, _CMP_LE_OQ ) );
+    isHit = _mm256_and_ps( isHit, _mm256_cmp_ps( tmin, maxDistance, _CMP_LE_OQ ) );
+    return _mm256_blendv_ps( _mm256_set1_ps( INFINITY ), tmin, isHit );
+}
+#endif
+}
+
 namespace Raycast
 {
 
@@ -118,5 +203,149 @@ RaycastHit3 GetClosest( const RaycastHit3& hit1, const RaycastHit3& hit2 )
     return hit2;
 }
 
+int ToAABB3Batch( const Ray3& ray, const float* minsX, const float* minsY, const float* minsZ,
+                  const float* maxsX, const float* maxsY, const float* maxsZ, int boxCount,
+                  float* out_distances, float maxDistance /*= INFINITY */ )
+{
+    Vec3 dirInv = Vec3( 1, 1, 1 ) / ray.direction;
+    int idx = 0;
+
+#if defined( ENGINE_SIMD_AVX )
+    {
+        __m256 startX = _mm256_set1_ps( ray.start.x );
+        __m256 startY = _mm256_set1_ps( ray.start.y );
+        __m256 startZ = _mm256_set1_ps( ray.start.z );
+        __m256 dirInvX = _mm256_set1_ps( dirInv.x );
+        __m256 dirInvY = _mm256_set1_ps( dirInv.y );
+        __m256 dirInvZ = _mm256_set1_ps( dirInv.z );
+        __m256 maxDistances = _mm256_set1_ps( maxDistance );
+        for( ; idx + 8 <= boxCount; idx += 8 )
+        {
+            __m256 entry = GetSlabEntry8(
+                startX, startY, startZ, dirInvX, dirInvY, dirInvZ,
+                _mm256_loadu_ps( minsX + idx ), _mm256_loadu_ps( minsY + idx ),
+                _mm256_loadu_ps( minsZ + idx ), _mm256_loadu_ps( maxsX + idx ),
+                _mm256_loadu_ps( maxsY + idx ), _mm256_loadu_ps( maxsZ + idx ), maxDistances );
+            _mm256_storeu_ps( out_distances + idx, entry );
+        }
+    }
+#endif
+
+#if defined( ENGINE_SIMD_SSE )
+    {
+        __m128 startX = _mm_set1_ps( ray.start.x );
+        __m128 startY = _mm_set1_ps( ray.start.y );
+        __m128 startZ = _mm_set1_ps( ray.start.z );
+        __m128 dirInvX = _mm_set1_ps( dirInv.x );
+        __m128 dirInvY = _mm_set1_ps( dirInv.y );
+        __m128 dirInvZ = _mm_set1_ps( dirInv.z );
+        __m128 maxDistances = _mm_set1_ps( maxDistance );
+        for( ; idx + 4 <= boxCount; idx += 4 )
+        {
+            __m128 entry = GetSlabEntry4(
+                startX, startY, startZ, dirInvX, dirInvY, dirInvZ,
+                _mm_loadu_ps( minsX + idx ), _mm_loadu_ps( minsY + idx ),
+                _mm_loadu_ps( minsZ + idx ), _mm_loadu_ps( maxsX + idx ),
+                _mm_loadu_ps( maxsY + idx ), _mm_loadu_ps( maxsZ + idx ), maxDistances );
+            _mm_storeu_ps( out_distances + idx, entry );
+        }
+    }
+#endif
+
+    for( ; idx < boxCount; ++idx )
+    {
+        out_distances[idx] = GetSlabEntry( ray.start.x, ray.start.y, ray.start.z,
+                                           dirInv.x, dirInv.y, dirInv.z,
+                                           minsX[idx], minsY[idx], minsZ[idx],
+                                           maxsX[idx], maxsY[idx], maxsZ[idx], maxDistance );
+    }
+
+    int closestIdx = -1;
+    float closestDistance = INFINITY;
+    for( idx = 0; idx < boxCount; ++idx )
+    {
+        if( out_distances[idx] < closestDistance )
+        {
+            closestDistance = out_distances[idx];
+            closestIdx = idx;
+        }
+    }
+    return closestIdx;
+}
+
+int RaysToAABB3Batch( const float* startsX, const float* startsY, const float* startsZ,
+                      const float* directionsX, const float* directionsY,
+                      const float* directionsZ, int rayCount, const AABB3& bbox,
+                      float* out_distances, float maxDistance /*= INFINITY */ )
+{
+    int hitCount = 0;
+    int idx = 0;
+
+#if defined( ENGINE_SIMD_AVX )
+    {
+        __m256 ones = _mm256_set1_ps( 1.f );
+        __m256 minX = _mm256_set1_ps( bbox.mins.x );
+        __m256 minY = _mm256_set1_ps( bbox.mins.y );
+        __m256 minZ = _mm256_set1_ps( bbox.mins.z );
+        __m256 maxX = _mm256_set1_ps( bbox.maxs.x );
+        __m256 maxY = _mm256_set1_ps( bbox.maxs.y );
+        __m256 maxZ = _mm256_set1_ps( bbox.maxs.z );
+        __m256 maxDistances = _mm256_set1_ps( maxDistance );
+        __m256 infinities = _mm256_set1_ps( INFINITY );
+        for( ; idx + 8 <= rayCount; idx += 8 )
+        {
+            // division is exact like the scalar 1 / direction
+            __m256 entry = GetSlabEntry8(
+                _mm256_loadu_ps( startsX + idx ), _mm256_loadu_ps( startsY + idx ),
+                _mm256_loadu_ps( startsZ + idx ),
+                _mm256_div_ps( ones, _mm256_loadu_ps( directionsX + idx ) ),
+                _mm256_div_ps( ones, _mm256_loadu_ps( directionsY + idx ) ),
+                _mm256_div_ps( ones, _mm256_loadu_ps( directionsZ + idx ) ),
+                minX, minY, minZ, maxX, maxY, maxZ, maxDistances );
+            _mm256_storeu_ps( out_distances + idx, entry );
+            int hitBits = _mm256_movemask_ps( _mm256_cmp_ps( entry, infinities, _CMP_LT_OQ ) );
+            hitCount += CountSetBits( hitBits );
+        }
+    }
+#endif
+
+#if defined( ENGINE_SIMD_SSE )
+    {
+        __m128 ones = _mm_set1_ps( 1.f );
+        __m128 minX = _mm_set1_ps( bbox.mins.x );
+        __m128 minY = _mm_set1_ps( bbox.mins.y );
+        __m128 minZ = _mm_set1_ps( bbox.mins.z );
+        __m128 maxX = _mm_set1_ps( bbox.maxs.x );
+        __m128 maxY = _mm_set1_ps( bbox.maxs.y );
+        __m128 maxZ = _mm_set1_ps( bbox.maxs.z );
+        __m128 maxDistances = _mm_set1_ps( maxDistance );
+        __m128 infinities = _mm_set1_ps( INFINITY );
+        for( ; idx + 4 <= rayCount; idx += 4 )
+        {
+            __m128 entry = GetSlabEntry4(
+                _mm_loadu_ps( startsX + idx ), _mm_loadu_ps( startsY + idx ),
+                _mm_loadu_ps( startsZ + idx ),
+                _mm_div_ps( ones, _mm_loadu_ps( directionsX + idx ) ),
+                _mm_div_ps( ones, _mm_loadu_ps( directionsY + idx ) ),
+                _mm_div_ps( ones, _mm_loadu_ps( directionsZ + idx ) ),
+                minX, minY, minZ, maxX, maxY, maxZ, maxDistances );
+            _mm_storeu_ps( out_distances + idx, entry );
+            int hitBits = _mm_movemask_ps( _mm_cmplt_ps( entry, infinities ) );
+            hitCount += CountSetBits( hitBits );
+        }
+    }
+#endif
+
+    for( ; idx < rayCount; ++idx )
+    {
+        out_distances[idx] = GetSlabEntry( startsX[idx], startsY[idx], startsZ[idx],
+                                           1.f / directionsX[idx], 1.f / directionsY[idx],
+                                           1.f / directionsZ[idx],
+                                           bbox.mins.x, bbox.mins.y, bbox.mins.z,
+                                           bbox.maxs.x, bbox.maxs.y, bbox.maxs.z, maxDistance );
+        hitCount += out_distances[idx] < INFINITY;
+    }
+    return hitCount;
 }
 
+}
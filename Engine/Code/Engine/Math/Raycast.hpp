@@ -16,4 +16,21 @@ RaycastHit3 ToOBB3( const Ray3& ray, const OBB3& obb );
 //return the closest raycast, if both are the same, prefer ray1
 RaycastHit3 GetClosest( const RaycastHit3& hit1, const RaycastHit3& hit2 );
 
+// Slab tests over many boxes or rays, 8 at a time with AVX, 4 with SSE
+// Each hit and distance is the same ToAABB3 gives for that ray and box,
+// out_distances gets INFINITY for misses and for hits past maxDistance
+
+// One ray against boxes given as separate min and max arrays
+// Returns the index of the closest box hit, -1 if none
+int ToAABB3Batch( const Ray3& ray, const float* minsX, const float* minsY, const float* minsZ,
+                  const float* maxsX, const float* maxsY, const float* maxsZ, int boxCount,
+                  float* out_distances, float maxDistance = INFINITY );
+// Rays given as separate start and direction arrays against one box, directions are
+// used as they are, normalize them for distances like Ray3's
+// Returns how many rays hit
+int RaysToAABB3Batch( const float* startsX, const float* startsY, const float* startsZ,
+                      const float* directionsX, const float* directionsY,
+                      const float* directionsZ, int rayCount, const AABB3& bbox,
+                      float* out_distances, float maxDistance = INFINITY );
+
 };
@@ -0,0 +1,19 @@
+#pragma once
+#include "Game/EngineBuildPreferences.hpp"
+
+// Picks the widest instruction set the compiler is allowed to emit, turn it all off
+// with ENGINE_DISABLE_SIMD in EngineBuildPreferences.hpp
+// x64 always has SSE2, AVX needs /arch:AVX or -mavx
+#if !defined( ENGINE_DISABLE_SIMD )
+
+#if defined( _M_X64 ) || defined( __SSE2__ ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define ENGINE_SIMD_SSE
+#include <emmintrin.h>
+#endif
+
+#if defined( ENGINE_SIMD_SSE ) && defined( __AVX__ )
+#define ENGINE_SIMD_AVX
+#include <immintrin.h>
+#endif
+
+#endif // ENGINE_DISABLE_SIMD
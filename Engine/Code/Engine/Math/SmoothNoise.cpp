@@ -741,4 +741,309 @@ float Compute4dPerlin( float posX, float posY, float posZ, float posT, float sca
 	return totalNoise;
 }
 
+
+//-----------------------------------------------------------------------------------------------
+// Simplex corners only reach as far as (0.5 - distanceSquared) stays positive, which never
+//	crosses into a neighboring simplex, so the noise stays continuous (the 0.6 in some published
+//	versions gives small seams).  Falloff is raised to the 4th power, same as Ken Perlin's.
+//
+// Clamped instead of early-out; roughly half the corners are out of range, so a branch here
+//	mispredicts constantly.
+//
+template< typename VecType >
+float GetSimplexCornerContribution( const VecType& gradient, const VecType& displacement )
+{
+	float falloff = 0.5f - Dot( displacement, displacement );
+	falloff = falloff > 0.f ? falloff : 0.f;
+	falloff *= falloff;
+	return falloff * falloff * Dot( gradient, displacement );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Simplex noise is Perlin noise on a grid of simplices instead of squares/cubes/hypercubes.
+//
+// In 2D, the cells are triangles (3 corners instead of 4); gradients are the same as 2D Perlin.
+//
+float Compute2dSimplex( float posX, float posY, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed )
+{
+	const float OCTAVE_OFFSET = 0.636764989593174f; // Translation/bias to add to each octave
+	const float SKEW = 0.366025403784f;		// (sqrt(3)-1)/2, squashes pairs of triangles into unit squares
+	const float UNSKEW = 0.211324865405f;	// (3-sqrt(3))/6, stretches unit squares back into triangles
+	const Vec2 gradients[ 8 ] = // Normalized unit vectors in 8 quarter-cardinal directions
+	{
+		Vec2( +0.923879533f, +0.382683432f ), //  22.5 degrees (ENE)
+		Vec2( +0.382683432f, +0.923879533f ), //  67.5 degrees (NNE)
+		Vec2( -0.382683432f, +0.923879533f ), // 112.5 degrees (NNW)
+		Vec2( -0.923879533f, +0.382683432f ), // 157.5 degrees (WNW)
+		Vec2( -0.923879533f, -0.382683432f ), // 202.5 degrees (WSW)
+		Vec2( -0.382683432f, -0.923879533f ), // 247.5 degrees (SSW)
+		Vec2( +0.382683432f, -0.923879533f ), // 292.5 degrees (SSE)
+		Vec2( +0.923879533f, -0.382683432f )	 // 337.5 degrees (ESE)
+	};
+
+	float totalNoise = 0.f;
+	float totalAmplitude = 0.f;
+	float currentAmplitude = 1.f;
+	float invScale = (1.f / scale);
+	Vec2 currentPos( posX * invScale, posY * invScale );
+
+	for( unsigned int octaveNum = 0; octaveNum < numOctaves; ++ octaveNum )
+	{
+		// Skew into unit squares to find the first corner, then unskew back
+		float skew = (currentPos.x + currentPos.y) * SKEW;
+		Vec2 cellMins( floorf( currentPos.x + skew ), floorf( currentPos.y + skew ) );
+		int indexFirstX = (int) cellMins.x;
+		int indexFirstY = (int) cellMins.y;
+		float unskew = (cellMins.x + cellMins.y) * UNSKEW;
+		Vec2 displacementFromFirst( currentPos.x - (cellMins.x - unskew), currentPos.y - (cellMins.y - unskew) );
+
+		// Lower triangle steps east first, upper triangle steps north first
+		int stepX = displacementFromFirst.x > displacementFromFirst.y ? 1 : 0;
+		int stepY = 1 - stepX;
+		Vec2 displacementFromSecond( displacementFromFirst.x - (float) stepX + UNSKEW, displacementFromFirst.y - (float) stepY + UNSKEW );
+		Vec2 displacementFromThird( displacementFromFirst.x - 1.f + 2.f * UNSKEW, displacementFromFirst.y - 1.f + 2.f * UNSKEW );
+
+		unsigned int noiseFirst  = Get2dUint( indexFirstX, indexFirstY, seed );
+		unsigned int noiseSecond = Get2dUint( indexFirstX + stepX, indexFirstY + stepY, seed );
+		unsigned int noiseThird  = Get2dUint( indexFirstX + 1, indexFirstY + 1, seed );
+
+		// Sum each corner's falloff-weighted gradient dot (no blending needed)
+		float blendTotal = GetSimplexCornerContribution( gradients[ noiseFirst & 0x00000007 ], displacementFromFirst )
+			+ GetSimplexCornerContribution( gradients[ noiseSecond & 0x00000007 ], displacementFromSecond )
+			+ GetSimplexCornerContribution( gradients[ noiseThird & 0x00000007 ], displacementFromThird );
+		float noiseThisOctave = blendTotal * (1.f / 0.00999599154f); // 2D simplex is in [-.00999599154,.00999599154]; map to ~[-1,1]
+
+		// Accumulate results and prepare for next octave (if any)
+		totalNoise += noiseThisOctave * currentAmplitude;
+		totalAmplitude += currentAmplitude;
+		currentAmplitude *= octavePersistence;
+		currentPos *= octaveScale;
+		currentPos.x += OCTAVE_OFFSET; // Add "irrational" offset to de-align octave grids
+		currentPos.y += OCTAVE_OFFSET; // Add "irrational" offset to de-align octave grids
+		++ seed; // Eliminates octaves "echoing" each other (since each octave is uniquely seeded)
+	}
+
+	// Re-normalize total noise to within [-1,1] and fix octaves pulling us far away from limits
+	if( renormalize && totalAmplitude > 0.f )
+	{
+		totalNoise /= totalAmplitude;				// Amplitude exceeds 1.0 if octaves are used
+		totalNoise = (totalNoise * 0.5f) + 0.5f;	// Map to [0,1]
+		totalNoise = Easing::SmoothStep3( totalNoise );		// Push towards extents (octaves pull us away)
+		totalNoise = (totalNoise * 2.0f) - 1.f;		// Map back to [-1,1]
+	}
+
+	return totalNoise;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Simplex noise is Perlin noise on a grid of simplices instead of squares/cubes/hypercubes.
+//
+// In 3D, the cells are tetrahedra (4 corners instead of 8); gradients are the same as 3D Perlin.
+//
+float Compute3dSimplex( float posX, float posY, float posZ, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed )
+{
+	const float OCTAVE_OFFSET = 0.636764989593174f; // Translation/bias to add to each octave
+	const float SKEW = 0.333333333f;		// 1/3, squashes groups of 6 tetrahedra into unit cubes
+	const float UNSKEW = 0.166666667f;		// 1/6, stretches unit cubes back into tetrahedra
+	const float fSQRT_3_OVER_3 = 0.577350269189f;
+	const Vec3 gradients[ 8 ] = // Same cube corner directions as 3D Perlin
+	{
+		Vec3( +fSQRT_3_OVER_3, +fSQRT_3_OVER_3, +fSQRT_3_OVER_3 ),
+		Vec3( -fSQRT_3_OVER_3, +fSQRT_3_OVER_3, +fSQRT_3_OVER_3 ),
+		Vec3( +fSQRT_3_OVER_3, -fSQRT_3_OVER_3, +fSQRT_3_OVER_3 ),
+		Vec3( -fSQRT_3_OVER_3, -fSQRT_3_OVER_3, +fSQRT_3_OVER_3 ),
+		Vec3( +fSQRT_3_OVER_3, +fSQRT_3_OVER_3, -fSQRT_3_OVER_3 ),
+		Vec3( -fSQRT_3_OVER_3, +fSQRT_3_OVER_3, -fSQRT_3_OVER_3 ),
+		Vec3( +fSQRT_3_OVER_3, -fSQRT_3_OVER_3, -fSQRT_3_OVER_3 ),
+		Vec3( -fSQRT_3_OVER_3, -fSQRT_3_OVER_3, -fSQRT_3_OVER_3 )
+	};
+
+	float totalNoise = 0.f;
+	float totalAmplitude = 0.f;
+	float currentAmplitude = 1.f;
+	float invScale = (1.f / scale);
+	Vec3 currentPos( posX * invScale, posY * invScale, posZ * invScale );
+
+	for( unsigned int octaveNum = 0; octaveNum < numOctaves; ++ octaveNum )
+	{
+		// Skew into unit cubes to find the first corner, then unskew back
+		float skew = (currentPos.x + currentPos.y + currentPos.z) * SKEW;
+		Vec3 cellMins( floorf( currentPos.x + skew ), floorf( currentPos.y + skew ), floorf( currentPos.z + skew ) );
+		int indexFirstX = (int) cellMins.x;
+		int indexFirstY = (int) cellMins.y;
+		int indexFirstZ = (int) cellMins.z;
+		float unskew = (cellMins.x + cellMins.y + cellMins.z) * UNSKEW;
+		Vec3 displacementFromFirst( currentPos.x - (cellMins.x - unskew), currentPos.y - (cellMins.y - unskew), currentPos.z - (cellMins.z - unskew) );
+
+		// Rank the displacement components; the path to the last corner steps along the largest first
+		int greaterXY = displacementFromFirst.x > displacementFromFirst.y ? 1 : 0;
+		int greaterXZ = displacementFromFirst.x > displacementFromFirst.z ? 1 : 0;
+		int greaterYZ = displacementFromFirst.y > displacementFromFirst.z ? 1 : 0;
+		int rankX = greaterXY + greaterXZ;
+		int rankY = (1 - greaterXY) + greaterYZ;
+		int rankZ = (1 - greaterXZ) + (1 - greaterYZ);
+		int secondX = rankX >= 2 ? 1 : 0;
+		int secondY = rankY >= 2 ? 1 : 0;
+		int secondZ = rankZ >= 2 ? 1 : 0;
+		int thirdX  = rankX >= 1 ? 1 : 0;
+		int thirdY  = rankY >= 1 ? 1 : 0;
+		int thirdZ  = rankZ >= 1 ? 1 : 0;
+
+		Vec3 displacementFromSecond( displacementFromFirst.x - (float) secondX + UNSKEW, displacementFromFirst.y - (float) secondY + UNSKEW, displacementFromFirst.z - (float) secondZ + UNSKEW );
+		Vec3 displacementFromThird( displacementFromFirst.x - (float) thirdX + 2.f * UNSKEW, displacementFromFirst.y - (float) thirdY + 2.f * UNSKEW, displacementFromFirst.z - (float) thirdZ + 2.f * UNSKEW );
+		Vec3 displacementFromFourth( displacementFromFirst.x - 1.f + 3.f * UNSKEW, displacementFromFirst.y - 1.f + 3.f * UNSKEW, displacementFromFirst.z - 1.f + 3.f * UNSKEW );
+
+		unsigned int noiseFirst  = Get3dUint( indexFirstX, indexFirstY, indexFirstZ, seed );
+		unsigned int noiseSecond = Get3dUint( indexFirstX + secondX, indexFirstY + secondY, indexFirstZ + secondZ, seed );
+		unsigned int noiseThird  = Get3dUint( indexFirstX + thirdX, indexFirstY + thirdY, indexFirstZ + thirdZ, seed );
+		unsigned int noiseFourth = Get3dUint( indexFirstX + 1, indexFirstY + 1, indexFirstZ + 1, seed );
+
+		// Sum each corner's falloff-weighted gradient dot (no blending needed)
+		float blendTotal = GetSimplexCornerContribution( gradients[ noiseFirst & 0x00000007 ], displacementFromFirst )
+			+ GetSimplexCornerContribution( gradients[ noiseSecond & 0x00000007 ], displacementFromSecond )
+			+ GetSimplexCornerContribution( gradients[ noiseThird & 0x00000007 ], displacementFromThird )
+			+ GetSimplexCornerContribution( gradients[ noiseFourth & 0x00000007 ], displacementFromFourth );
+		float noiseThisOctave = blendTotal * (1.f / 0.00928906293f); // 3D simplex is in [-.00928906293,.00928906293]; map to ~[-1,1]
+
+		// Accumulate results and prepare for next octave (if any)
+		totalNoise += noiseThisOctave * currentAmplitude;
+		totalAmplitude += currentAmplitude;
+		currentAmplitude *= octavePersistence;
+		currentPos *= octaveScale;
+		currentPos.x += OCTAVE_OFFSET; // Add "irrational" offset to de-align octave grids
+		currentPos.y += OCTAVE_OFFSET; // Add "irrational" offset to de-align octave grids
+		currentPos.z += OCTAVE_OFFSET; // Add "irrational" offset to de-align octave grids
+		++ seed; // Eliminates octaves "echoing" each other (since each octave is uniquely seeded)
+	}
+
+	// Re-normalize total noise to within [-1,1] and fix octaves pulling us far away from limits
+	if( renormalize && totalAmplitude > 0.f )
+	{
+		totalNoise /= totalAmplitude;				// Amplitude exceeds 1.0 if octaves are used
+		totalNoise = (totalNoise * 0.5f) + 0.5f;	// Map to [0,1]
+		totalNoise = Easing::SmoothStep3( totalNoise );		// Push towards extents (octaves pull us away)
+		totalNoise = (totalNoise * 2.0f) - 1.f;		// Map back to [-1,1]
+	}
+
+	return totalNoise;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Simplex noise is Perlin noise on a grid of simplices instead of squares/cubes/hypercubes.
+//
+// In 4D, the cells are 5-cells (5 corners instead of 16); gradients are the same as 4D Perlin.
+//
+float Compute4dSimplex( float posX, float posY, float posZ, float posT, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed )
+{
+	const float OCTAVE_OFFSET = 0.636764989593174f; // Translation/bias to add to each octave
+	const float SKEW = 0.309016994375f;		// (sqrt(5)-1)/4, squashes groups of 24 5-cells into unit hypercubes
+	const float UNSKEW = 0.138196601125f;	// (5-sqrt(5))/20, stretches unit hypercubes back into 5-cells
+	const Vec4 gradients[ 16 ] = // Same hypercube corner directions as 4D Perlin
+	{
+		Vec4( +0.5f, +0.5f, +0.5f, +0.5f ),
+		Vec4( -0.5f, +0.5f, +0.5f, +0.5f ),
+		Vec4( +0.5f, -0.5f, +0.5f, +0.5f ),
+		Vec4( -0.5f, -0.5f, +0.5f, +0.5f ),
+		Vec4( +0.5f, +0.5f, -0.5f, +0.5f ),
+		Vec4( -0.5f, +0.5f, -0.5f, +0.5f ),
+		Vec4( +0.5f, -0.5f, -0.5f, +0.5f ),
+		Vec4( -0.5f, -0.5f, -0.5f, +0.5f ),
+		Vec4( +0.5f, +0.5f, +0.5f, -0.5f ),
+		Vec4( -0.5f, +0.5f, +0.5f, -0.5f ),
+		Vec4( +0.5f, -0.5f, +0.5f, -0.5f ),
+		Vec4( -0.5f, -0.5f, +0.5f, -0.5f ),
+		Vec4( +0.5f, +0.5f, -0.5f, -0.5f ),
+		Vec4( -0.5f, +0.5f, -0.5f, -0.5f ),
+		Vec4( +0.5f, -0.5f, -0.5f, -0.5f ),
+		Vec4( -0.5f, -0.5f, -0.5f, -0.5f )
+	};
+
+	float totalNoise = 0.f;
+	float totalAmplitude = 0.f;
+	float currentAmplitude = 1.f;
+	float invScale = (1.f / scale);
+	Vec4 currentPos( posX * invScale, posY * invScale, posZ * invScale, posT * invScale );
+
+	for( unsigned int octaveNum = 0; octaveNum < numOctaves; ++ octaveNum )
+	{
+		// Skew into unit hypercubes to find the first corner, then unskew back
+		float skew = (currentPos.x + currentPos.y + currentPos.z + currentPos.w) * SKEW;
+		Vec4 cellMins( floorf( currentPos.x + skew ), floorf( currentPos.y + skew ), floorf( currentPos.z + skew ), floorf( currentPos.w + skew ) );
+		int indexFirstX = (int) cellMins.x;
+		int indexFirstY = (int) cellMins.y;
+		int indexFirstZ = (int) cellMins.z;
+		int indexFirstT = (int) cellMins.w;
+		float unskew = (cellMins.x + cellMins.y + cellMins.z + cellMins.w) * UNSKEW;
+		Vec4 displacementFromFirst( currentPos.x - (cellMins.x - unskew), currentPos.y - (cellMins.y - unskew), currentPos.z - (cellMins.z - unskew), currentPos.w - (cellMins.w - unskew) );
+
+		// Rank the displacement components; the path to the last corner steps along the largest first
+		int greaterXY = displacementFromFirst.x > displacementFromFirst.y ? 1 : 0;
+		int greaterXZ = displacementFromFirst.x > displacementFromFirst.z ? 1 : 0;
+		int greaterXT = displacementFromFirst.x > displacementFromFirst.w ? 1 : 0;
+		int greaterYZ = displacementFromFirst.y > displacementFromFirst.z ? 1 : 0;
+		int greaterYT = displacementFromFirst.y > displacementFromFirst.w ? 1 : 0;
+		int greaterZT = displacementFromFirst.z > displacementFromFirst.w ? 1 : 0;
+		int rankX = greaterXY + greaterXZ + greaterXT;
+		int rankY = (1 - greaterXY) + greaterYZ + greaterYT;
+		int rankZ = (1 - greaterXZ) + (1 - greaterYZ) + greaterZT;
+		int rankT = (1 - greaterXT) + (1 - greaterYT) + (1 - greaterZT);
+		int secondX = rankX >= 3 ? 1 : 0;
+		int secondY = rankY >= 3 ? 1 : 0;
+		int secondZ = rankZ >= 3 ? 1 : 0;
+		int secondT = rankT >= 3 ? 1 : 0;
+		int thirdX  = rankX >= 2 ? 1 : 0;
+		int thirdY  = rankY >= 2 ? 1 : 0;
+		int thirdZ  = rankZ >= 2 ? 1 : 0;
+		int thirdT  = rankT >= 2 ? 1 : 0;
+		int fourthX = rankX >= 1 ? 1 : 0;
+		int fourthY = rankY >= 1 ? 1 : 0;
+		int fourthZ = rankZ >= 1 ? 1 : 0;
+		int fourthT = rankT >= 1 ? 1 : 0;
+
+		Vec4 displacementFromSecond( displacementFromFirst.x - (float) secondX + UNSKEW, displacementFromFirst.y - (float) secondY + UNSKEW, displacementFromFirst.z - (float) secondZ + UNSKEW, displacementFromFirst.w - (float) secondT + UNSKEW );
+		Vec4 displacementFromThird( displacementFromFirst.x - (float) thirdX + 2.f * UNSKEW, displacementFromFirst.y - (float) thirdY + 2.f * UNSKEW, displacementFromFirst.z - (float) thirdZ + 2.f * UNSKEW, displacementFromFirst.w - (float) thirdT + 2.f * UNSKEW );
+		Vec4 displacementFromFourth( displacementFromFirst.x - (float) fourthX + 3.f * UNSKEW, displacementFromFirst.y - (float) fourthY + 3.f * UNSKEW, displacementFromFirst.z - (float) fourthZ + 3.f * UNSKEW, displacementFromFirst.w - (float) fourthT + 3.f * UNSKEW );
+		Vec4 displacementFromFifth( displacementFromFirst.x - 1.f + 4.f * UNSKEW, displacementFromFirst.y - 1.f + 4.f * UNSKEW, displacementFromFirst.z - 1.f + 4.f * UNSKEW, displacementFromFirst.w - 1.f + 4.f * UNSKEW );
+
+		unsigned int noiseFirst  = Get4dUint( indexFirstX, indexFirstY, indexFirstZ, indexFirstT, seed );
+		unsigned int noiseSecond = Get4dUint( indexFirstX + secondX, indexFirstY + secondY, indexFirstZ + secondZ, indexFirstT + secondT, seed );
+		unsigned int noiseThird  = Get4dUint( indexFirstX + thirdX, indexFirstY + thirdY, indexFirstZ + thirdZ, indexFirstT + thirdT, seed );
+		unsigned int noiseFourth = Get4dUint( indexFirstX + fourthX, indexFirstY + fourthY, indexFirstZ + fourthZ, indexFirstT + fourthT, seed );
+		unsigned int noiseFifth  = Get4dUint( indexFirstX + 1, indexFirstY + 1, indexFirstZ + 1, indexFirstT + 1, seed );
+
+		// Sum each corner's falloff-weighted gradient dot (no blending needed)
+		float blendTotal = GetSimplexCornerContribution( gradients[ noiseFirst & 0x0000000F ], displacementFromFirst )
+			+ GetSimplexCornerContribution( gradients[ noiseSecond & 0x0000000F ], displacementFromSecond )
+			+ GetSimplexCornerContribution( gradients[ noiseThird & 0x0000000F ], displacementFromThird )
+			+ GetSimplexCornerContribution( gradients[ noiseFourth & 0x0000000F ], displacementFromFourth )
+			+ GetSimplexCornerContribution( gradients[ noiseFifth & 0x0000000F ], displacementFromFifth );
+		float noiseThisOctave = blendTotal * (1.f / 0.00919673505f); // 4D simplex is in [-.00919673505,.00919673505]; map to ~[-1,1]
+
+		// Accumulate results and prepare for next octave (if any)
+		totalNoise += noiseThisOctave * currentAmplitude;
+		totalAmplitude += currentAmplitude;
+		currentAmplitude *= octavePersistence;
+		currentPos *= octaveScale;
+		currentPos.x += OCTAVE_OFFSET; // Add "irrational" offset to de-align octave grids
+		currentPos.y += OCTAVE_OFFSET; // Add "irrational" offset to de-align octave grids
+		currentPos.z += OCTAVE_OFFSET; // Add "irrational" offset to de-align octave grids
+		currentPos.w += OCTAVE_OFFSET; // Add "irrational" offset to de-align octave grids
+		++ seed; // Eliminates octaves "echoing" each other (since each octave is uniquely seeded)
+	}
+
+	// Re-normalize total noise to within [-1,1] and fix octaves pulling us far away from limits
+	if( renormalize && totalAmplitude > 0.f )
+	{
+		totalNoise /= totalAmplitude;				// Amplitude exceeds 1.0 if octaves are used
+		totalNoise = (totalNoise * 0.5f) + 0.5f;	// Map to [0,1]
+		totalNoise = Easing::SmoothStep3( totalNoise );		// Push towards extents (octaves pull us away)
+		totalNoise = (totalNoise * 2.0f) - 1.f;		// Map back to [-1,1]
+	}
+
+	return totalNoise;
+}
+
 }
@@ -84,11 +84,19 @@ float Compute4dPerlin( float posX, float posY, float posZ, float posT, float sca
 //	Perlin noise, in that it is more organic-looking.  I'm not sure I like the look of it better,
 //	however; examples of cross-sectional 4D simplex noise look worse to me than 4D Perlin does.
 //
-// Also, Simplex noise is based on a regular simplex (2D triangle, 3D tetrahedron, 4-simplex/5-cell)
-//	grid, which is slightly more fiddly, so I haven't bothered writing my own yet.
+// Simplex noise is based on a regular simplex (2D triangle, 3D tetrahedron, 4-simplex/5-cell)
+//	grid, so each sample sums N+1 corners instead of Perlin's 2^N (5 instead of 16 in 4D), using
+//	the same seeding, octave offsets, and gradient sets as the Perlin functions above.
+//	1D simplex is identical to 1D Perlin, so there is no Compute1dSimplex.
 //
-// #todoEiserloh: Implement simplex noise in 2D, 3D, 4D (1D simplex is identical to 1D Perlin, I think?)
-// #todoEiserloh: Test actual simplex noise implementation in 2D/3D to compare speeds (branches vs. ops!)
+// <numOctaves>			Number of layers of noise added together
+// <octavePersistence>	Amplitude multiplier for each subsequent octave (each octave is quieter)
+// <octaveScale>		Frequency multiplier for each subsequent octave (each octave is busier)
+// <renormalize>		If true, uses nonlinear (SmoothStep3) renormalization to within [-1,1]
 //
+float Compute2dSimplex( float posX, float posY, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0 );
+float Compute3dSimplex( float posX, float posY, float posZ, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0 );
+float Compute4dSimplex( float posX, float posY, float posZ, float posT, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0 );
+
 
 }
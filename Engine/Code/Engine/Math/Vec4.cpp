@@ -75,7 +75,7 @@ void Vec4::operator*=( float uniformScale )
     x *= uniformScale;
     y *= uniformScale;
     z *= uniformScale;
-    z *= uniformScale;
+    w *= uniformScale;
 }
 
 const Vec4 Vec4::operator*( float uniformScale ) const
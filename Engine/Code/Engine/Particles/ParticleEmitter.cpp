@@ -52,6 +52,13 @@ void ParticleEmitter::Update()
         SetShouldDie( true );
 }
 
+UpdatePhase ParticleEmitter::GetUpdatePhase() const
+{
+    if( m_spawnRate > 0 )
+        return UpdatePhase::SERIAL;
+    return UpdatePhase::PARALLEL;
+}
+
 void ParticleEmitter::SpawnParticlesBasedOnTimer()
 {
     uint count = m_spawnTimer.PopAllLaps();
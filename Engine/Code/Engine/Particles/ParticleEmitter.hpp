@@ -17,6 +17,9 @@ public:
 
     virtual void PreRender( Camera* camera ) override;
     virtual void Update() override;
+    // Spawning reads the parent transform and runs the spawn callback,
+    // emitters that only simulate their particles can update in parallel
+    virtual UpdatePhase GetUpdatePhase() const override;
 
     void SpawnParticle();
     void SpawnParticles( uint count );
@@ -14,6 +14,7 @@
 #include "Engine/Renderer/Renderable.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/Profiler.hpp"
+#include "Engine/Math/MathUtils.hpp"
 void ForwardRenderingPath::Render( RenderSceneGraph* scene )
 {
     PROFILER_SCOPED();
@@ -63,9 +64,12 @@ void ForwardRenderingPath::RenderShadowMapForLight( Light* light )
     m_renderer->SetOverrideShader( ShaderPass::GetDepthOnlyShader() );
 
     auto& renderables = m_scene->GetRenderables();
-    for( auto renderable : renderables )
+    uint culledCount = CullRenderables( renderables, shadowCamera->GetVPMatrix() );
+    PROFILER_COUNT( ShadowCulled, culledCount );
+    for( uint renderableIdx = 0; renderableIdx < renderables.size(); ++renderableIdx )
     {
-        if( !renderable->GetMesh() )
+        Renderable* renderable = renderables[renderableIdx];
+        if( !renderable->GetMesh() || !m_isVisible[renderableIdx] )
             continue;
         uint meshCount = renderable->GetMesh()->GetSubMeshCount();
         // Loop sub-mesh/materials
@@ -98,12 +102,19 @@ void ForwardRenderingPath::RenderSceneForCamera( Camera* camera )
 
     std::vector<DrawCall> drawCalls;
 
+    auto& renderables = m_scene->GetRenderables();
+    uint culledCount = CullRenderables( renderables, camera->GetVPMatrix() );
+    PROFILER_COUNT( CameraCulled, culledCount );
+
     PROFILER_PUSH( GenerateDrawCalls );
     // Generate the draw calls
-    auto& renderables = m_scene->GetRenderables();
-    for( auto renderable : renderables )
+    for( uint renderableIdx = 0; renderableIdx < renderables.size(); ++renderableIdx )
     {
+        if( !m_isVisible[renderableIdx] )
+            continue;
+
         // setup draw call(s) for this renderable
+        Renderable* renderable = renderables[renderableIdx];
         uint meshCount = renderable->GetMesh()->GetSubMeshCount();
 
         // Loop sub-mesh/materials
@@ -250,6 +261,47 @@ void ForwardRenderingPath::EnableLightsForDrawCall( const DrawCall& drawCall )
     }
 }
 
+uint ForwardRenderingPath::CullRenderables( std::vector<Renderable*>& renderables,
+                                            const Mat4& viewProjection )
+{
+    PROFILER_SCOPED();
+    int renderableCount = (int) renderables.size();
+    m_boundsCentersX.resize( renderableCount );
+    m_boundsCentersY.resize( renderableCount );
+    m_boundsCentersZ.resize( renderableCount );
+    m_boundsRadii.resize( renderableCount );
+    m_isVisible.resize( renderableCount );
+
+    for( int renderableIdx = 0; renderableIdx < renderableCount; ++renderableIdx )
+    {
+        Renderable* renderable = renderables[renderableIdx];
+        Mesh* mesh = renderable->GetMesh();
+        AABB3 localBounds = mesh ? mesh->GetLocalBounds() : AABB3();
+        Vec3 center = Vec3::ZEROS;
+        float radius = INFINITY; // nothing to size the sphere by, never culled
+        if( localBounds.IsValid() && renderable->IsCullable() )
+        {
+            // sphere around the box, grown by the model's largest axis scale
+            const Mat4& model = renderable->GetModelMatrix();
+            float scaleSquared = Maxf( Maxf( Vec3( model.I ).GetLengthSquared(),
+                                             Vec3( model.J ).GetLengthSquared() ),
+                                       Vec3( model.K ).GetLengthSquared() );
+            center = model.TransformPosition( localBounds.GetCenter() );
+            radius = localBounds.GetDiagonal3D() * 0.5f * sqrtf( scaleSquared );
+        }
+        m_boundsCentersX[renderableIdx] = center.x;
+        m_boundsCentersY[renderableIdx] = center.y;
+        m_boundsCentersZ[renderableIdx] = center.z;
+        m_boundsRadii[renderableIdx] = radius;
+    }
+
+    Frustum frustum = Frustum::FromMatrixAABB3( viewProjection );
+    int visibleCount = frustum.CullSpheres( m_boundsCentersX.data(), m_boundsCentersY.data(),
+                                            m_boundsCentersZ.data(), m_boundsRadii.data(),
+                                            m_isVisible.data(), renderableCount );
+    return (uint) ( renderableCount - visibleCount );
+}
+
 void ForwardRenderingPath::UpdateShadowCamera( Light* light, Camera* mainCamera )
 {
     Vec4 pointInDistance = Vec4( 0.0f, 0.0f, 32.0f, 1.0f );
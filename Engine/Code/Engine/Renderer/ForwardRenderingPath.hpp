@@ -6,6 +6,7 @@ class Renderer;
 class RenderSceneGraph;
 class Camera;
 class Light;
+class Renderable;
 
 class ForwardRenderingPath
 {
@@ -24,6 +25,9 @@ private:
                                         int out_lightIndices[] );
     void SortDrawCalls( std::vector<DrawCall>& out_drawCalls );
     void EnableLightsForDrawCall( const DrawCall& drawCall );
+    // Sets m_isVisible for each renderable by its world bounding sphere against the
+    // frustum of viewProjection, returns how many were culled
+    uint CullRenderables( std::vector<Renderable*>& renderables, const Mat4& viewProjection );
 
 public:
     void UpdateShadowCamera( Light* light, Camera* mainCamera);
@@ -32,4 +36,11 @@ private:
     Renderer * m_renderer;
     RenderSceneGraph* m_scene;
 
+    // reused by every CullRenderables call, indexed like the renderables
+    std::vector<float> m_boundsCentersX;
+    std::vector<float> m_boundsCentersY;
+    std::vector<float> m_boundsCentersZ;
+    std::vector<float> m_boundsRadii;
+    std::vector<uchar> m_isVisible;
+
 };
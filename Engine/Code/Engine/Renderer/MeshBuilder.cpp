@@ -4,6 +4,7 @@
 #include "Engine/Math/IVec2.hpp"
 #include "Engine/Core/ContainerUtils.hpp"
 #include "Engine/Math/Mat4.hpp"
+#include "Engine/Math/Mat4Kernels.hpp"
 
 #include "ThirdParty/mikktspace/mikktspace.h"
 
@@ -351,29 +352,34 @@ uint MeshBuilder::GetIndexCount() const
 
 void MeshBuilder::TransformAllVerts( const Mat4& transform )
 {
+    if( m_verts.empty() )
+        return;
+
+    // each attribute is transformed in place across the whole vertex array
+    VertexBuilderData& first = m_verts[0];
+    int vertCount = (int) m_verts.size();
+    size_t stride = sizeof( VertexBuilderData );
+
     if( m_vertexLayout->HasAttribute( "POSITION" ) )
     {
-        for( auto& vert : m_verts )
-            vert.m_position = Vec3( transform * Vec4( vert.m_position, 1 ) );
+        Mat4Kernels::TransformPositionsStrided( transform.el, first.m_position.el, stride,
+                                                first.m_position.el, stride, vertCount );
     }
 
     if( m_vertexLayout->HasAttribute( "NORMAL" ) )
     {
-        for( auto& vert : m_verts )
-            vert.m_normal = Vec3( transform * Vec4( vert.m_normal, 0 ) );
+        // inverse transpose keeps normals perpendicular under non uniform scale
+        Mat4 normalTransform = transform.Inverse();
+        normalTransform.Transpose();
+        Mat4Kernels::TransformNormalsStrided( normalTransform.el, first.m_normal.el, stride,
+                                              first.m_normal.el, stride, vertCount );
     }
 
+    // w holds the bi-tangent sign and is left alone
     if( m_vertexLayout->HasAttribute( "TANGENT" ) )
     {
-        for( auto& vert : m_verts )
-        {
-            float sign = vert.m_tangent.w;
-            Vec4 tangent = vert.m_tangent;
-            tangent.w = 0;
-            tangent = transform * tangent;
-            tangent.w = sign;
-            vert.m_tangent = tangent;
-        }
+        Mat4Kernels::TransformDisplacementsStrided( transform.el, &first.m_tangent.x, stride,
+                                                    &first.m_tangent.x, stride, vertCount );
     }
 }
 
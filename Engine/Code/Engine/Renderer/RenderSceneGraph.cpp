@@ -3,6 +3,8 @@
 #include "Engine/Core/GameObject.hpp"
 #include "Engine/Renderer/Renderable.hpp"
 #include "Engine/Core/GameObjectManager.hpp"
+#include "Engine/Core/EntityRegistry.hpp"
+#include "Engine/Core/EntitySystems.hpp"
 
 RenderSceneGraph* RenderSceneGraph::s_default = nullptr;
 
@@ -18,6 +20,7 @@ RenderSceneGraph* RenderSceneGraph::GetDefault()
 RenderSceneGraph::RenderSceneGraph()
 {
     m_manager = GameObjectManager::GetDefault();
+    m_entities = EntityRegistry::GetDefault();
 }
 
 std::vector<GameObject*>& RenderSceneGraph::GetGameObjects()
@@ -37,12 +40,15 @@ std::vector<Renderable*>& RenderSceneGraph::GetRenderables()
         if( renderable )
             m_renderables.push_back( renderable );
     }
+    if( m_entities )
+        EntitySystems::GatherRenderables( m_entities, m_renderables );
     return m_renderables;
 }
 
 std::vector<GameObject*>& RenderSceneGraph::GetLights()
 {
-    return m_manager->GetObjectsOfType( "Light" );
+    static const GameObjectTypeId s_lightTypeId = GameObjectManager::RegisterType( "Light" );
+    return m_manager->GetObjectsOfType( s_lightTypeId );
 }
 
 void RenderSceneGraph::RemoveCamera( Camera* camera )
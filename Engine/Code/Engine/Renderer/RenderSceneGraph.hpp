@@ -6,6 +6,7 @@ class Camera;
 class GameObject;
 class Renderable;
 class GameObjectManager;
+class EntityRegistry;
 
 class RenderSceneGraph
 {
@@ -17,6 +18,7 @@ public:
     ~RenderSceneGraph() {};
 
     std::vector<GameObject*>& GetGameObjects();
+    // GameObject renderables followed by entity renderables
     std::vector<Renderable*>& GetRenderables();
     std::vector<GameObject*>& GetLights();
 
@@ -25,12 +27,15 @@ public:
     std::vector<Camera*>& GetCameras();
 
     void SetGameObjectManager( GameObjectManager* manager ) { m_manager = manager; };
+    // can be null to only draw GameObjects
+    void SetEntityRegistry( EntityRegistry* registry ) { m_entities = registry; };
 
 private:
 
     std::vector<Renderable*> m_renderables;
     static RenderSceneGraph* s_default;
     GameObjectManager* m_manager = nullptr;
+    EntityRegistry* m_entities = nullptr;
 
     std::vector<Camera*> m_cameras;
 
@@ -34,6 +34,10 @@ public:
     Mat4& GetModelMatrix() { return m_modelMatrix; };
     Vec3 GetPosition();
 
+    // off for renderables the shader places somewhere other than the model matrix, like the skybox
+    void SetCullable( bool isCullable ) { m_isCullable = isCullable; };
+    bool IsCullable() const { return m_isCullable; };
+
     void SetMaterial( uint matID, Material* mat );
     Material* GetMaterial( uint matID ) { return m_materials[matID]; };
     uint GetMaterialCount() { return (uint) m_materials.size(); };
@@ -65,6 +69,7 @@ private:
     void SetDirty();
     void ClearDirty();
     bool m_isDirty = true;
+    bool m_isCullable = true;
     // internal use, assumes program and vertex buffer and already bound
     // binds index buffer inside
     InputLayout CreateInputLayout( uint programHandle );
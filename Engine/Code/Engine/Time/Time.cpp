@@ -9,26 +9,55 @@
 
 
 
-double InitializeTime( LARGE_INTEGER& out_initialTime )
+struct PerformanceTimeBase
+{
+    LONGLONG initialCount;
+    double secondsPerCount;
+};
+
+PerformanceTimeBase InitializeTime()
 {
     LARGE_INTEGER countsPerSecond;
+    LARGE_INTEGER initialCount;
     QueryPerformanceFrequency( &countsPerSecond );
-    QueryPerformanceCounter( &out_initialTime );
-    return( 1.0 / static_cast<double>( countsPerSecond.QuadPart ) );
+    QueryPerformanceCounter( &initialCount );
+
+    PerformanceTimeBase timeBase;
+    timeBase.initialCount = initialCount.QuadPart;
+    timeBase.secondsPerCount = 1.0 / static_cast<double>( countsPerSecond.QuadPart );
+    return timeBase;
+}
+
+const PerformanceTimeBase& GetTimeBase()
+{
+    static PerformanceTimeBase s_timeBase = InitializeTime();
+    return s_timeBase;
 }
 
 
 
 double TimeUtils::GetCurrentTimeSeconds()
 {
-    static LARGE_INTEGER initialTime;
-    static double secondsPerCount = InitializeTime( initialTime );
+    return TicksToSeconds( GetCurrentTimeTicks() );
+}
+
+uint64 TimeUtils::GetCurrentTimeTicks()
+{
     LARGE_INTEGER currentCount;
     QueryPerformanceCounter( &currentCount );
-    LONGLONG elapsedCountsSinceInitialTime = currentCount.QuadPart - initialTime.QuadPart;
+    return static_cast<uint64>( currentCount.QuadPart );
+}
 
-    double currentSeconds = static_cast<double>( elapsedCountsSinceInitialTime ) * secondsPerCount;
-    return currentSeconds;
+double TimeUtils::TicksToSeconds( uint64 ticks )
+{
+    const PerformanceTimeBase& timeBase = GetTimeBase();
+    LONGLONG elapsedCountsSinceInitialTime = static_cast<LONGLONG>( ticks ) - timeBase.initialCount;
+    return static_cast<double>( elapsedCountsSinceInitialTime ) * timeBase.secondsPerCount;
+}
+
+double TimeUtils::GetSecondsPerTick()
+{
+    return GetTimeBase().secondsPerCount;
 }
 
 TimeUtils::SysTime TimeUtils::GetDateTime()
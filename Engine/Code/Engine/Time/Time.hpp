@@ -2,6 +2,7 @@
 // Time.hpp
 //
 #pragma once
+#include "Engine/Core/Types.hpp"
 
 namespace TimeUtils
 {
@@ -19,6 +20,13 @@ struct SysTime
 
 double GetCurrentTimeSeconds();
 
+// Raw performance counter, cheaper than seconds for hot paths that convert later
+uint64 GetCurrentTimeTicks();
+// Converts a GetCurrentTimeTicks value to the same time base as GetCurrentTimeSeconds
+double TicksToSeconds( uint64 ticks );
+// Length of one tick, for converting tick deltas that were saved to disk
+double GetSecondsPerTick();
+
 SysTime GetDateTime();
 
 
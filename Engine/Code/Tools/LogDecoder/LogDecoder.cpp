@@ -0,0 +1,49 @@
+// LogDecoder.cpp
+//
+// Turns a binary log written by Logger::AddBinaryFileHook back into text
+// Usage: LogDecoder <binaryLog> [textOut]    (prints to stdout without textOut)
+//
+// Only needs Engine/Core/LogFormat.cpp, e.g.
+// cl /EHsc /I..\.. LogDecoder.cpp ..\..\Engine\Core\LogFormat.cpp
+
+#include "Engine/Core/LogFormat.hpp"
+
+#include <stdio.h>
+
+
+int main( int argc, char** argv )
+{
+    if( argc < 2 )
+    {
+        fprintf( stderr, "Usage: %s <binaryLog> [textOut]\n", argv[0] );
+        return 1;
+    }
+
+    FILE* binaryLog = fopen( argv[1], "rb" );
+    if( nullptr == binaryLog )
+    {
+        fprintf( stderr, "Could not open %s\n", argv[1] );
+        return 1;
+    }
+
+    FILE* textOut = stdout;
+    if( argc > 2 )
+    {
+        textOut = fopen( argv[2], "w" );
+        if( nullptr == textOut )
+        {
+            fprintf( stderr, "Could not open %s\n", argv[2] );
+            fclose( binaryLog );
+            return 1;
+        }
+    }
+
+    bool succeeded = LogFormat::DecodeBinaryLog( binaryLog, textOut );
+    if( !succeeded )
+        fprintf( stderr, "%s is not a binary log or is truncated\n", argv[1] );
+
+    fclose( binaryLog );
+    if( textOut != stdout )
+        fclose( textOut );
+    return succeeded ? 0 : 1;
+}
@@ -15,6 +15,7 @@
 #include "Engine/Renderer/TextMeshBuilder.hpp"
 #include "Engine/Renderer/DebugRender.hpp"
 #include "Engine/Core/Logger.hpp"
+#include "Engine/Core/JobSystem.hpp"
 #include "Engine/IO/IOUtils.hpp"
 #include "Engine/Net/Net.hpp"
 
@@ -27,7 +28,24 @@ App::App()
 {
     Profiler::StartUp();
 
-    Logger::GetDefault()->StartUp();
+    // the main thread keeps core 0, with enough cores the logger gets the last
+    // core to itself so it never preempts simulation or render prep
+    uint coreCount = Thread::GetCoreCount();
+    uint64 loggerCore = 0;
+    uint64 workerCores = 0;
+    int workerCount = -1;
+    if( coreCount > 2 )
+    {
+        loggerCore = Thread::GetCoreBit( coreCount - 1 );
+        for( uint coreIdx = 1; coreIdx < coreCount - 1; ++coreIdx )
+            workerCores |= Thread::GetCoreBit( coreIdx );
+        workerCount = coreCount - 2;
+        Thread::ThreadSetCoreAffinity( Thread::GetCoreBit( 0 ) );
+    }
+    Thread::ThreadSetName( "Main" );
+    JobSystem::StartUp( workerCount, workerCores );
+
+    Logger::GetDefault()->StartUp( loggerCore );
     Logger::GetDefault()->AddFileHook( IOUtils::GetCurrentDir() + "/Logs/log.txt" );
 
     g_realtimeClock = new Clock();
@@ -64,6 +82,7 @@ App::App()
 App::~App()
 {
     Logger::GetDefault()->ShutDown();
+    JobSystem::ShutDown();
 
     Net::Shutdown();
 
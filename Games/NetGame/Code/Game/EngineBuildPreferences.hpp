@@ -10,3 +10,5 @@
 
 //#define ENGINE_DISABLE_AUDIO	// (If uncommented) Disables AudioSystem code and fmod linkage.
 #define PROFILING_ENABLED
+//#define PROFILE_ALLOCATIONS	// (If uncommented) Replaces global operator new to count allocations per profiler scope
+//#define ENGINE_DISABLE_SIMD	// (If uncommented) Mat4 and batch noise math use the scalar code instead of SSE/AVX
@@ -89,5 +89,7 @@ void GameState_Loading::MakeSkyBox()
     mat->SetDiffuse( cubemap );
     mat->SetShaderPass( 0, ShaderPass::GetSkyboxShader() );
     renderable->SetMaterial( 0, mat );
+    // drawn around the camera by the shader, its model matrix says nothing about where
+    renderable->SetCullable( false );
     skybox->SetRenderable( renderable );
 }
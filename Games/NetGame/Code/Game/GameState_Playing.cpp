@@ -44,6 +44,8 @@
 #include "Engine/Core/ShapeRulesetLoader.hpp"
 #include "Engine/Core/ThreadSafeQueue.hpp"
 #include "Engine/Core/Logger.hpp"
+#include "Engine/Core/EntityRegistry.hpp"
+#include "Engine/Core/EntitySystems.hpp"
 
 #include "Game/GameState_Playing.hpp"
 #include "Game/GameCommon.hpp"
@@ -87,6 +89,10 @@ void GameState_Playing::Update()
 
     g_gameObjectManager->DeleteDeadGameObjects();
 
+    // entities have no per object update, their passes run once the objects are done
+    EntityRegistry* entities = EntityRegistry::GetDefault();
+    EntitySystems::IntegratePhysics( entities, g_gameClock->GetDeltaSecondsF() );
+    EntitySystems::UpdateWorldMatrices( entities );
 }
 
 void GameState_Playing::Render() const
@@ -150,6 +156,9 @@ void GameState_Playing::ProcessInput()
 void GameState_Playing::SetRootGameObject( GameObject* go )
 {
     s_rootGameObject = go;
+    // rolls every frame, quaternions avoid the euler decompose and gimbal lock
+    if( go )
+        go->GetTransform().SetRotationMode( RotationMode::QUATERNION );
 }
 
 void GameState_Playing::MakeCamera()
@@ -8,6 +8,16 @@ RigidBody::RigidBody( std::string type )
 {
 }
 
+UpdatePhase RigidBody::GetUpdatePhase() const
+{
+    // moving a transform dirties its children and reading a world position
+    // regenerates the parent's cache, so only lone transforms can go wide
+    const Transform& trans = GetTransform();
+    if( trans.GetParent() || !trans.GetChildren().empty() )
+        return UpdatePhase::SERIAL;
+    return UpdatePhase::PARALLEL;
+}
+
 void RigidBody::Update()
 {
     GameObject::Update();
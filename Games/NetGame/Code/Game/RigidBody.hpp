@@ -8,6 +8,7 @@ public:
 	RigidBody(std::string type);
 	virtual ~RigidBody(){};
     virtual void Update() override;
+    virtual UpdatePhase GetUpdatePhase() const override;
 
     Vec3 m_velocity;
     float m_drag = 0.f;
@@ -1,15 +1,37 @@
 #pragma once
 #include <string>
 #include <functional>
+#include <string.h>
+#include <vector>
+#include <algorithm>
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Core/ErrorUtils.hpp"
 #include "Engine/Math/Trajectory.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/Console.hpp"
 #include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/IVec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Math/Vec4.hpp"
 #include "Engine/Core/StringUtils.hpp"
 #include "Engine/IO/IOUtils.hpp"
 #include "Engine/Math/Solver.hpp"
+#include "Engine/Math/Mat4Kernels.hpp"
+#include "Engine/Math/Raycast.hpp"
+#include "Engine/Math/Ray3.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/Random.hpp"
+#include "Engine/Math/NoiseBatch.hpp"
+#include "Engine/Math/SmoothNoise.hpp"
+#include "Engine/Time/Time.hpp"
+#include "Engine/Core/SpatialHashGrid.hpp"
+#include "Engine/Core/GameObject.hpp"
+#include "Engine/Core/GameObjectBVH.hpp"
+#include "Engine/Math/OBB3.hpp"
+#include "Engine/Core/Transform.hpp"
+#include "Engine/Core/TransformHierarchy.hpp"
+#include "Engine/Core/EntityRegistry.hpp"
+#include "Engine/Core/EntityComponents.hpp"
 
 #include "Game/GameCommon.hpp"
 
@@ -103,6 +125,743 @@ void IOTests()
 
 }
 
+// SIMD kernels must match the scalar ones bit for bit, Invert only needs to be close
+void MathKernelTests()
+{
+    constexpr int ITERATIONS = 1000;
+    constexpr int POINT_COUNT = 37; // not a multiple of the block size, covers the tail
+    int mismatches = 0;
+    float maxInverseError = 0.f;
+
+    for( int iteration = 0; iteration < ITERATIONS; ++iteration )
+    {
+        float lhs[16];
+        float rhs[16];
+        float vec[4];
+        float points[POINT_COUNT * 3];
+        for( int idx = 0; idx < 16; ++idx )
+        {
+            lhs[idx] = Random::FloatInRange( -10.f, 10.f );
+            rhs[idx] = Random::FloatInRange( -10.f, 10.f );
+        }
+        for( int idx = 0; idx < 4; ++idx )
+            vec[idx] = Random::FloatInRange( -10.f, 10.f );
+        for( int idx = 0; idx < POINT_COUNT * 3; ++idx )
+            points[idx] = Random::FloatInRange( -10.f, 10.f );
+
+        float scalarMat[16];
+        float simdMat[16];
+        Mat4Kernels::MultiplyScalar( lhs, rhs, scalarMat );
+        Mat4Kernels::Multiply( lhs, rhs, simdMat );
+        mismatches += memcmp( scalarMat, simdMat, sizeof( scalarMat ) ) != 0;
+
+        float scalarVec[4];
+        float simdVec[4];
+        Mat4Kernels::TransformScalar( lhs, vec, scalarVec );
+        Mat4Kernels::Transform( lhs, vec, simdVec );
+        mismatches += memcmp( scalarVec, simdVec, sizeof( scalarVec ) ) != 0;
+
+        float scalarPoints[POINT_COUNT * 3];
+        float simdPoints[POINT_COUNT * 3];
+        Mat4Kernels::TransformPositionsScalar( lhs, points, scalarPoints, POINT_COUNT );
+        Mat4Kernels::TransformPositions( lhs, points, simdPoints, POINT_COUNT );
+        mismatches += memcmp( scalarPoints, simdPoints, sizeof( scalarPoints ) ) != 0;
+        Mat4Kernels::TransformDisplacementsScalar( lhs, points, scalarPoints, POINT_COUNT );
+        Mat4Kernels::TransformDisplacements( lhs, points, simdPoints, POINT_COUNT );
+        mismatches += memcmp( scalarPoints, simdPoints, sizeof( scalarPoints ) ) != 0;
+
+        // points as every other Vec3, like normals inside a vertex struct
+        constexpr size_t STRIDE = sizeof( float ) * 6;
+        Mat4Kernels::TransformNormalsStridedScalar( lhs, points, STRIDE, scalarPoints, STRIDE,
+                                                    POINT_COUNT / 2 );
+        Mat4Kernels::TransformNormalsStrided( lhs, points, STRIDE, simdPoints, STRIDE,
+                                              POINT_COUNT / 2 );
+        for( int idx = 0; idx < POINT_COUNT / 2; ++idx )
+            mismatches += memcmp( &scalarPoints[idx * 6], &simdPoints[idx * 6], sizeof( float ) * 3 ) != 0;
+
+        // lhs * inverse should be identity
+        if( Mat4Kernels::Invert( lhs, simdMat ) )
+        {
+            Mat4Kernels::MultiplyScalar( lhs, simdMat, scalarMat );
+            for( int idx = 0; idx < 16; ++idx )
+            {
+                float expected = idx % 5 == 0 ? 1.f : 0.f;
+                maxInverseError = Maxf( maxInverseError, fabsf( scalarMat[idx] - expected ) );
+            }
+        }
+    }
+
+    g_console->Print( Stringf( "Mat4Kernels: %d mismatches, max inverse error %g",
+                               mismatches, maxInverseError ) );
+}
+
+// Batched slab tests against Raycast::ToAABB3 one box and one ray at a time
+void RaycastBatchTests()
+{
+    constexpr int ITERATIONS = 100;
+    constexpr int COUNT = 101; // not a multiple of the block size, covers the tail
+    float minsX[COUNT], minsY[COUNT], minsZ[COUNT];
+    float maxsX[COUNT], maxsY[COUNT], maxsZ[COUNT];
+    float startsX[COUNT], startsY[COUNT], startsZ[COUNT];
+    float directionsX[COUNT], directionsY[COUNT], directionsZ[COUNT];
+    float distances[COUNT];
+    int mismatches = 0;
+    int hitCount = 0;
+
+    auto getExpectedDistance = []( const Ray3& ray, const AABB3& bbox, float maxDistance )
+    {
+        RaycastHit3 hit = Raycast::ToAABB3( ray, bbox );
+        return hit.m_hit && hit.m_distance <= maxDistance ? hit.m_distance : INFINITY;
+    };
+
+    for( int iteration = 0; iteration < ITERATIONS; ++iteration )
+    {
+        float maxDistance = iteration % 2 == 0 ? INFINITY : 8.f;
+        // some rays have no z and start exactly on the max z face of the box, 0 * inf in the
+        // last slab of the test, spread over the SIMD lanes and the tail
+        bool hasOnFaceCases = iteration % 3 == 0;
+        AABB3 boxes[COUNT];
+        Ray3 rays[COUNT];
+        for( int idx = 0; idx < COUNT; ++idx )
+        {
+            bool isOnFace = hasOnFaceCases && idx % 3 == 1;
+            boxes[idx] = AABB3( Vec3( Random::FloatInRange( -10.f, 10.f ),
+                                      Random::FloatInRange( -10.f, 10.f ),
+                                      Random::FloatInRange( -10.f, 10.f ) ),
+                                Random::FloatInRange( 0.1f, 4.f ), Random::FloatInRange( 0.1f, 4.f ),
+                                Random::FloatInRange( 0.1f, 4.f ) );
+            if( isOnFace )
+            {
+                // max z face through the start of rays[0]
+                boxes[idx].mins.z += rays[0].start.z - boxes[idx].maxs.z;
+                boxes[idx].maxs.z = rays[0].start.z;
+            }
+            minsX[idx] = boxes[idx].mins.x;
+            minsY[idx] = boxes[idx].mins.y;
+            minsZ[idx] = boxes[idx].mins.z;
+            maxsX[idx] = boxes[idx].maxs.x;
+            maxsY[idx] = boxes[idx].maxs.y;
+            maxsZ[idx] = boxes[idx].maxs.z;
+
+            // some axis aligned directions to cover the infinite slabs
+            Vec3 direction( Random::FloatInRange( -1.f, 1.f ), Random::FloatInRange( -1.f, 1.f ),
+                            idx % 8 == 0 ? 0.f : Random::FloatInRange( -1.f, 1.f ) );
+            Vec3 start( Random::FloatInRange( -10.f, 10.f ), Random::FloatInRange( -10.f, 10.f ),
+                        Random::FloatInRange( -10.f, 10.f ) );
+            if( hasOnFaceCases && ( idx == 0 || isOnFace ) )
+                direction.z = 0.f;
+            if( isOnFace )
+                start.z = boxes[0].maxs.z; // max z face of boxes[0]
+            rays[idx] = Ray3( start, direction );
+            startsX[idx] = rays[idx].start.x;
+            startsY[idx] = rays[idx].start.y;
+            startsZ[idx] = rays[idx].start.z;
+            directionsX[idx] = rays[idx].direction.x;
+            directionsY[idx] = rays[idx].direction.y;
+            directionsZ[idx] = rays[idx].direction.z;
+        }
+
+        int closestIdx = Raycast::ToAABB3Batch( rays[0], minsX, minsY, minsZ, maxsX, maxsY,
+                                                maxsZ, COUNT, distances, maxDistance );
+        int expectedClosestIdx = -1;
+        float expectedClosest = INFINITY;
+        for( int idx = 0; idx < COUNT; ++idx )
+        {
+            float expected = getExpectedDistance( rays[0], boxes[idx], maxDistance );
+            mismatches += memcmp( &expected, &distances[idx], sizeof( float ) ) != 0;
+            if( expected < expectedClosest )
+            {
+                expectedClosest = expected;
+                expectedClosestIdx = idx;
+            }
+        }
+        mismatches += closestIdx != expectedClosestIdx;
+
+        int raysHit = Raycast::RaysToAABB3Batch( startsX, startsY, startsZ, directionsX,
+                                                 directionsY, directionsZ, COUNT, boxes[0],
+                                                 distances, maxDistance );
+        int expectedRaysHit = 0;
+        for( int idx = 0; idx < COUNT; ++idx )
+        {
+            float expected = getExpectedDistance( rays[idx], boxes[0], maxDistance );
+            mismatches += memcmp( &expected, &distances[idx], sizeof( float ) ) != 0;
+            expectedRaysHit += expected < INFINITY;
+        }
+        mismatches += raysHit != expectedRaysHit;
+        hitCount += raysHit;
+    }
+
+    g_console->Print( Stringf( "RaycastBatch: %d mismatches, %d ray hits", mismatches, hitCount ) );
+}
+
+// GameObjectBVH queries against testing every live object, with objects deleted and
+// moved after the build
+void GameObjectBVHTests()
+{
+    constexpr int OBJECT_COUNT = 500;
+    constexpr int QUERY_COUNT = 500;
+    // kept out of the default manager so the game never sees these objects
+    GameObjectManager manager;
+    GameObjects objects;
+    for( int idx = 0; idx < OBJECT_COUNT; ++idx )
+    {
+        GameObject* gameObject = GameObject::MakeCube( Vec3( Random::FloatInRange( 0.2f, 6.f ),
+                                                             Random::FloatInRange( 0.2f, 6.f ),
+                                                             Random::FloatInRange( 0.2f, 6.f ) ) );
+        gameObject->SetGameObjectManager( &manager );
+        gameObject->GetTransform().SetLocalPosition( Vec3( Random::FloatInRange( -50.f, 50.f ),
+                                                           Random::FloatInRange( -50.f, 50.f ),
+                                                           Random::FloatInRange( -50.f, 50.f ) ) );
+        gameObject->GetTransform().SetLocalEuler( Vec3( Random::RotationDegrees(),
+                                                        Random::RotationDegrees(),
+                                                        Random::RotationDegrees() ) );
+        objects.push_back( gameObject );
+    }
+
+    GameObjectBVH bvh;
+    bvh.Build( &manager, objects );
+
+    int mismatches = 0;
+    int hitCount = 0;
+    auto compareQueries = [&]()
+    {
+        for( int queryIdx = 0; queryIdx < QUERY_COUNT; ++queryIdx )
+        {
+            Vec3 start( Random::FloatInRange( -60.f, 60.f ), Random::FloatInRange( -60.f, 60.f ),
+                        Random::FloatInRange( -60.f, 60.f ) );
+            Ray3 ray( start, Vec3( Random::FloatMinusOneToOne(), Random::FloatMinusOneToOne(),
+                                   Random::FloatMinusOneToOne() ) );
+            float maxDistance = queryIdx % 3 == 0 ? 40.f : INFINITY;
+            Vec3 center( Random::FloatInRange( -50.f, 50.f ), Random::FloatInRange( -50.f, 50.f ),
+                         Random::FloatInRange( -50.f, 50.f ) );
+            float radius = Random::FloatInRange( 0.f, 10.f );
+            AABB3 bounds( center, radius, radius, radius );
+
+            RaycastHit3 expectedHit = RaycastHit3::NO_HIT;
+            int expectedInSphere = 0;
+            int expectedInBounds = 0;
+            for( GameObject* gameObject : objects )
+            {
+                if( nullptr == gameObject )
+                    continue;
+
+                OBB3 obb = gameObject->GetOBB3();
+                RaycastHit3 hit = Raycast::ToOBB3( ray, obb );
+                if( hit.m_hit && hit.m_distance <= maxDistance && hit.m_distance < expectedHit.m_distance )
+                {
+                    expectedHit = hit;
+                    expectedHit.m_gameObject = gameObject;
+                }
+
+                Vec3 localCenter = obb.GetWorldToLocal().TransformPosition( center );
+                const AABB3& localBounds = obb.GetAABB3();
+                Vec3 closest = Min( Max( localCenter, localBounds.mins ), localBounds.maxs );
+                expectedInSphere += Vec3::GetDistanceSquared( localCenter, closest ) <= radius * radius;
+
+                Vec3 corners[8];
+                localBounds.GetCorners( corners );
+                AABB3 worldBounds;
+                for( const Vec3& corner : corners )
+                    worldBounds.StretchToIncludePoint( obb.GetLocalToWorld().TransformPosition( corner ) );
+                expectedInBounds += AABB3::IsOverlap( bounds, worldBounds );
+            }
+
+            RaycastHit3 hit = bvh.RaycastClosest( ray, maxDistance );
+            mismatches += hit.m_hit != expectedHit.m_hit || hit.m_gameObject != expectedHit.m_gameObject
+                || ( hit.m_hit && hit.m_distance != expectedHit.m_distance );
+            mismatches += bvh.RaycastAny( ray, maxDistance ) != expectedHit.m_hit;
+            hitCount += hit.m_hit;
+
+            GameObjects found;
+            bvh.QuerySphere( center, radius, found );
+            mismatches += (int) found.size() != expectedInSphere;
+            found.clear();
+            bvh.QueryAABB3( bounds, found );
+            mismatches += (int) found.size() != expectedInBounds;
+        }
+    };
+
+    compareQueries();
+
+    // deleted objects must be skipped before the next Refit too
+    for( int idx = 0; idx < OBJECT_COUNT; idx += 5 )
+    {
+        delete objects[idx];
+        objects[idx] = nullptr;
+    }
+    compareQueries();
+
+    for( int idx = 1; idx < OBJECT_COUNT; idx += 3 )
+    {
+        if( objects[idx] )
+            objects[idx]->GetTransform().SetLocalPosition( Vec3( Random::FloatInRange( -50.f, 50.f ),
+                                                                 Random::FloatInRange( -50.f, 50.f ),
+                                                                 Random::FloatInRange( -50.f, 50.f ) ) );
+    }
+    bvh.Refit();
+    compareQueries();
+
+    for( GameObject* gameObject : objects )
+        delete gameObject;
+
+    g_console->Print( Stringf( "GameObjectBVH: %d mismatches, %d ray hits", mismatches, hitCount ) );
+}
+
+// Incremental grid changes and queries against checking every object
+void SpatialHashGridTests()
+{
+    constexpr uint SLOT_COUNT = 2000;
+    constexpr int ITERATIONS = 50;
+    constexpr int CHANGES_PER_ITERATION = 500;
+    struct Object
+    {
+        GameObjectHandle m_handle;
+        bool m_inGrid = false;
+        Vec3 m_center;
+        float m_radius = 0.f;
+    };
+    std::vector<Object> objects( SLOT_COUNT );
+    for( uint slotIdx = 0; slotIdx < SLOT_COUNT; ++slotIdx )
+        objects[slotIdx].m_handle.m_slotIdx = slotIdx;
+
+    auto getRandomPoint = []()
+    {
+        return Vec3( Random::FloatInRange( -50.f, 50.f ), Random::FloatInRange( -50.f, 50.f ),
+                     Random::FloatInRange( -50.f, 50.f ) );
+    };
+    auto sortHandles = []( std::vector<GameObjectHandle>& handles )
+    {
+        std::sort( handles.begin(), handles.end(),
+                   []( const GameObjectHandle& a, const GameObjectHandle& b )
+                   {
+                       return a.m_slotIdx < b.m_slotIdx;
+                   } );
+    };
+
+    SpatialHashGrid grid( 4.f );
+    std::vector<GameObjectHandle> found;
+    std::vector<GameObjectHandle> expected;
+    int mismatches = 0;
+    size_t foundCount = 0;
+    for( int iteration = 0; iteration < ITERATIONS; ++iteration )
+    {
+        for( int changeIdx = 0; changeIdx < CHANGES_PER_ITERATION; ++changeIdx )
+        {
+            Object& object = objects[Random::IntLessThan( SLOT_COUNT )];
+            if( object.m_inGrid && Random::CheckChance( 0.2f ) )
+            {
+                grid.Remove( object.m_handle );
+                object.m_inGrid = false;
+                continue;
+            }
+
+            // new generations leave the old handle behind without a Remove
+            if( !object.m_inGrid || Random::CheckChance( 0.1f ) )
+                ++object.m_handle.m_generation;
+            object.m_center = object.m_inGrid && Random::CheckChance( 0.5f )
+                ? object.m_center + Vec3( Random::FloatMinusOneToOne(), Random::FloatMinusOneToOne(),
+                                          Random::FloatMinusOneToOne() )
+                : getRandomPoint();
+            object.m_radius = Random::CheckChance( 0.3f ) ? 0.f : Random::FloatInRange( 0.f, 1.5f );
+            grid.Move( object.m_handle, object.m_center, object.m_radius );
+            object.m_inGrid = true;
+        }
+        if( iteration == ITERATIONS / 2 )
+            grid.SetCellSize( 2.5f );
+
+        uint inGridCount = 0;
+        for( const Object& object : objects )
+        {
+            inGridCount += object.m_inGrid;
+            mismatches += grid.Contains( object.m_handle ) != object.m_inGrid;
+        }
+        mismatches += grid.GetObjectCount() != inGridCount;
+
+        Vec3 center = getRandomPoint();
+        float radius = Random::FloatInRange( 0.f, iteration % 10 == 0 ? 60.f : 8.f );
+        AABB3 bounds( center, Random::FloatInRange( 0.f, 10.f ), Random::FloatInRange( 0.f, 10.f ),
+                      Random::FloatInRange( 0.f, 10.f ) );
+
+        found.clear();
+        expected.clear();
+        grid.QueryRadius( center, radius, found );
+        for( const Object& object : objects )
+        {
+            float maxDistance = radius + object.m_radius;
+            if( object.m_inGrid
+                && Vec3::GetDistanceSquared( center, object.m_center ) <= maxDistance * maxDistance )
+                expected.push_back( object.m_handle );
+        }
+        sortHandles( found );
+        mismatches += found != expected;
+        foundCount += found.size();
+
+        found.clear();
+        expected.clear();
+        grid.QueryAABB3( bounds, found );
+        for( const Object& object : objects )
+        {
+            Vec3 closest = Min( Max( object.m_center, bounds.mins ), bounds.maxs );
+            if( object.m_inGrid && Vec3::GetDistanceSquared( object.m_center, closest )
+                                   <= object.m_radius * object.m_radius )
+                expected.push_back( object.m_handle );
+        }
+        sortHandles( found );
+        mismatches += found != expected;
+        foundCount += found.size();
+
+        uint nearestCount = (uint) Random::IntInRange( 1, 20 );
+        float maxDistance = iteration % 3 == 0 ? 5.f : INFINITY;
+        found.clear();
+        expected.clear();
+        grid.QueryNearest( center, nearestCount, found, maxDistance );
+        for( const Object& object : objects )
+        {
+            if( object.m_inGrid && Vec3::GetDistanceSquared( center, object.m_center )
+                                   <= maxDistance * maxDistance )
+                expected.push_back( object.m_handle );
+        }
+        std::sort( expected.begin(), expected.end(),
+                   [&]( const GameObjectHandle& a, const GameObjectHandle& b )
+                   {
+                       return Vec3::GetDistanceSquared( center, objects[a.m_slotIdx].m_center )
+                           < Vec3::GetDistanceSquared( center, objects[b.m_slotIdx].m_center );
+                   } );
+        if( expected.size() > nearestCount )
+            expected.resize( nearestCount );
+        mismatches += found != expected;
+        foundCount += found.size();
+    }
+
+    g_console->Print( Stringf( "SpatialHashGrid: %d mismatches, %u found", mismatches,
+                               (uint) foundCount ) );
+}
+
+// TransformHierarchy against a Transform tree, same changes applied to both
+void TransformHierarchyTests()
+{
+    constexpr int NODE_COUNT = 300;
+    constexpr int REPARENT_COUNT = 100;
+    constexpr int DESTROY_COUNT = 50;
+    TransformHierarchy hierarchy;
+    std::vector<Transform*> transforms( NODE_COUNT );
+    std::vector<TransformNodeId> nodes( NODE_COUNT );
+
+    auto setRandomLocal = [&]( int idx, float scale )
+    {
+        Vec3 position( Random::FloatInRange( -10.f, 10.f ), Random::FloatInRange( -10.f, 10.f ),
+                       Random::FloatInRange( -10.f, 10.f ) );
+        Vec3 euler( Random::FloatInRange( -180.f, 180.f ), Random::FloatInRange( -80.f, 80.f ),
+                    Random::FloatInRange( -180.f, 180.f ) );
+        transforms[idx]->SetLocalPosition( position );
+        transforms[idx]->SetLocalEuler( euler );
+        transforms[idx]->SetLocalScale( Vec3( scale, scale, scale ) );
+        if( idx % 2 == 0 )
+        {
+            hierarchy.SetLocalSRT( nodes[idx], Vec3( scale, scale, scale ), euler, position );
+        }
+        else
+        {
+            hierarchy.SetLocalPosition( nodes[idx], position );
+            hierarchy.SetLocalEuler( nodes[idx], euler );
+            hierarchy.SetLocalScale( nodes[idx], Vec3( scale, scale, scale ) );
+        }
+    };
+    auto getRandomAliveIdx = [&]()
+    {
+        int idx = Random::IntLessThan( NODE_COUNT );
+        while( nullptr == transforms[idx] )
+            idx = ( idx + 1 ) % NODE_COUNT;
+        return idx;
+    };
+    auto getMaxError = [&]()
+    {
+        hierarchy.UpdateWorldMatrices();
+        float maxError = 0.f;
+        for( int idx = 0; idx < NODE_COUNT; ++idx )
+        {
+            if( nullptr == transforms[idx] )
+                continue;
+            const Mat4& expected = transforms[idx]->GetLocalToWorld();
+            const Mat4& actual = hierarchy.GetLocalToWorld( nodes[idx] );
+            for( int elIdx = 0; elIdx < 16; ++elIdx )
+                maxError = Maxf( maxError, fabsf( expected.el[elIdx] - actual.el[elIdx] ) );
+        }
+        return maxError;
+    };
+
+    // earlier nodes as parents so the tree has a mix of depths
+    for( int idx = 0; idx < NODE_COUNT; ++idx )
+    {
+        int parentIdx = idx > 0 && Random::CheckChance( 0.8f ) ? Random::IntLessThan( idx ) : -1;
+        transforms[idx] = new Transform();
+        nodes[idx] = hierarchy.CreateNode( parentIdx >= 0 ? nodes[parentIdx]
+                                                          : TransformHierarchy::INVALID_NODE );
+        if( parentIdx >= 0 )
+            transforms[idx]->SetParent( transforms[parentIdx] );
+        setRandomLocal( idx, Random::FloatInRange( 0.8f, 1.25f ) );
+    }
+    float maxError = getMaxError();
+
+    for( int reparentIdx = 0; reparentIdx < REPARENT_COUNT; ++reparentIdx )
+    {
+        int idx = getRandomAliveIdx();
+        int parentIdx = Random::CheckChance( 0.1f ) ? -1 : getRandomAliveIdx();
+        if( parentIdx >= 0 )
+        {
+            // skip moves under the node's own subtree
+            bool isCycle = false;
+            for( TransformNodeId ancestor = nodes[parentIdx];
+                 ancestor != TransformHierarchy::INVALID_NODE && !isCycle;
+                 ancestor = hierarchy.GetParent( ancestor ) )
+            {
+                isCycle = ancestor == nodes[idx];
+            }
+            if( isCycle )
+                continue;
+        }
+        transforms[idx]->SetParent( parentIdx >= 0 ? transforms[parentIdx] : nullptr );
+        hierarchy.SetParent( nodes[idx], parentIdx >= 0 ? nodes[parentIdx]
+                                                        : TransformHierarchy::INVALID_NODE );
+        if( Random::CheckChance( 0.5f ) )
+            setRandomLocal( getRandomAliveIdx(), Random::FloatInRange( 0.8f, 1.25f ) );
+    }
+    maxError = Maxf( maxError, getMaxError() );
+
+    // Transform keeps the local scale of orphaned children instead of the world one,
+    // so destroy with unit scales where both agree
+    for( int idx = 0; idx < NODE_COUNT; ++idx )
+        setRandomLocal( idx, 1.f );
+    maxError = Maxf( maxError, getMaxError() );
+    for( int destroyIdx = 0; destroyIdx < DESTROY_COUNT; ++destroyIdx )
+    {
+        int idx = getRandomAliveIdx();
+        delete transforms[idx];
+        transforms[idx] = nullptr;
+        hierarchy.DestroyNode( nodes[idx] );
+    }
+    maxError = Maxf( maxError, getMaxError() );
+
+    for( int changeIdx = 0; changeIdx < NODE_COUNT / 4; ++changeIdx )
+        setRandomLocal( getRandomAliveIdx(), 1.f );
+    maxError = Maxf( maxError, getMaxError() );
+
+    for( Transform* transform : transforms )
+        delete transform;
+
+    g_console->Print( Stringf( "TransformHierarchy: max world matrix error %g, %u nodes",
+                               maxError, hierarchy.GetNodeCount() ) );
+}
+
+// EntityRegistry against a plain list of which entities are alive and what they hold
+void EntityRegistryTests()
+{
+    constexpr int ENTITY_COUNT = 1000;
+    EntityRegistry registry;
+    std::vector<Entity> entities( ENTITY_COUNT );
+    std::vector<bool> isAlive( ENTITY_COUNT, true );
+    int errors = 0;
+
+    for( int idx = 0; idx < ENTITY_COUNT; ++idx )
+    {
+        entities[idx] = registry.CreateEntity();
+        TransformComponent transform;
+        transform.m_position.x = (float) idx;
+        registry.AddComponent( entities[idx], transform );
+        if( idx % 2 == 0 )
+            registry.AddComponent( entities[idx], PhysicsComponent() );
+    }
+
+    // every component has to stay with its entity after the last one is swapped into its place
+    auto checkPools = [&]()
+    {
+        ComponentPool<TransformComponent>& transforms = registry.GetPool<TransformComponent>();
+        int expectedCount = 0;
+        for( int idx = 0; idx < ENTITY_COUNT; ++idx )
+        {
+            if( !isAlive[idx] )
+            {
+                errors += registry.IsAlive( entities[idx] );
+                errors += nullptr != registry.FindComponent<TransformComponent>( entities[idx] );
+                continue;
+            }
+            ++expectedCount;
+            TransformComponent* transform = registry.FindComponent<TransformComponent>( entities[idx] );
+            errors += nullptr == transform || transform->m_position.x != (float) idx;
+            errors += registry.HasComponent<PhysicsComponent>( entities[idx] ) != ( idx % 2 == 0 );
+        }
+        errors += (int) transforms.GetSize() != expectedCount;
+        errors += (int) registry.GetAliveCount() != expectedCount;
+        for( uint denseIdx = 0; denseIdx < transforms.GetSize(); ++denseIdx )
+        {
+            uint entityIdx = transforms.GetEntityIdx( denseIdx );
+            errors += &transforms.GetAt( denseIdx ) != transforms.Find( entityIdx );
+        }
+
+        std::vector<int> visits( ENTITY_COUNT, 0 );
+        registry.ForEach<PhysicsComponent, TransformComponent>(
+            [&]( Entity entity, PhysicsComponent&, TransformComponent& transform )
+        {
+            int idx = (int) transform.m_position.x;
+            errors += entities[idx] != entity;
+            ++visits[idx];
+        } );
+        for( int idx = 0; idx < ENTITY_COUNT; ++idx )
+            errors += visits[idx] != ( isAlive[idx] && idx % 2 == 0 ? 1 : 0 );
+    };
+    checkPools();
+
+    // removes from the middle of the pools
+    for( int idx = 0; idx < ENTITY_COUNT; idx += 3 )
+    {
+        registry.DestroyEntity( entities[idx] );
+        isAlive[idx] = false;
+    }
+    registry.DestroyEntity( entities[0] ); // already dead, no-op
+    checkPools();
+
+    // dead indices come back with a new generation, the old handles stay dead
+    for( int idx = 0; idx < ENTITY_COUNT; idx += 3 )
+    {
+        Entity oldEntity = entities[idx];
+        entities[idx] = registry.CreateEntity();
+        errors += entities[idx] == oldEntity || registry.IsAlive( oldEntity );
+        errors += entities[idx].m_generation == 0;
+        TransformComponent transform;
+        transform.m_position.x = (float) idx;
+        registry.AddComponent( entities[idx], transform );
+        if( idx % 2 == 0 )
+            registry.AddComponent( entities[idx], PhysicsComponent() );
+        isAlive[idx] = true;
+    }
+    checkPools();
+
+    g_console->Print( Stringf( "EntityRegistry: %d errors, %u alive", errors,
+                               registry.GetAliveCount() ) );
+}
+
+void NoiseBatchTests()
+{
+    const IVec2 dimensions( 255, 255 ); // odd width covers the tail
+    const Vec2 mins( -100.5f, 42.25f );
+    const Vec2 spacing( 0.75f, 0.5f );
+    const float scale = 20.f;
+    const unsigned int numOctaves = 6;
+    std::vector<float> batchNoise( dimensions.x * dimensions.y );
+    std::vector<float> singleNoise( dimensions.x * dimensions.y );
+
+    double startSeconds = GetCurrentTimeSeconds();
+    Noise::Compute2dPerlinGrid( batchNoise.data(), dimensions, mins, spacing, scale, numOctaves );
+    double batchSeconds = GetCurrentTimeSeconds() - startSeconds;
+
+    startSeconds = GetCurrentTimeSeconds();
+    for( int y = 0; y < dimensions.y; ++y )
+    {
+        for( int x = 0; x < dimensions.x; ++x )
+        {
+            singleNoise[IVec2::CoordsToIndex( x, y, dimensions.x )] = Noise::Compute2dPerlin(
+                mins.x + spacing.x * (float) x, mins.y + spacing.y * (float) y, scale, numOctaves );
+        }
+    }
+    double singleSeconds = GetCurrentTimeSeconds() - startSeconds;
+
+    int mismatches = 0;
+    for( size_t idx = 0; idx < batchNoise.size(); ++idx )
+        mismatches += batchNoise[idx] != singleNoise[idx];
+
+    g_console->Print( Stringf( "NoiseBatch: %d mismatches, perlin grid %.2fms, single %.2fms",
+                               mismatches, batchSeconds * 1000.0, singleSeconds * 1000.0 ) );
+}
+
+// Per sample cost of every noise type and dimension, plus the simplex batches
+// which are also checked against the single sample simplex functions
+void NoiseBenchmarkTests()
+{
+    constexpr int SAMPLE_COUNT = 50003; // not a multiple of the block size, covers the tail
+    const float scale = 20.f;
+    const unsigned int numOctaves = 4;
+    std::vector<Vec4> positions( SAMPLE_COUNT );
+    std::vector<Vec3> positions3d( SAMPLE_COUNT );
+    std::vector<Vec2> positions2d( SAMPLE_COUNT );
+    for( int idx = 0; idx < SAMPLE_COUNT; ++idx )
+    {
+        Vec4& pos = positions[idx];
+        pos = Vec4( Random::FloatInRange( -1000.f, 1000.f ), Random::FloatInRange( -1000.f, 1000.f ),
+                    Random::FloatInRange( -1000.f, 1000.f ), Random::FloatInRange( -1000.f, 1000.f ) );
+        positions3d[idx] = Vec3( pos.x, pos.y, pos.z );
+        positions2d[idx] = Vec2( pos.x, pos.y );
+    }
+
+    std::vector<float> batchNoise( SAMPLE_COUNT );
+    std::vector<float> singleNoise( SAMPLE_COUNT );
+    double nanosPerSample = 1e9 / (double) SAMPLE_COUNT;
+    auto timeSamples = [&]( const std::function<float( const Vec4& )>& noiseFunc )
+    {
+        double startSeconds = GetCurrentTimeSeconds();
+        for( int idx = 0; idx < SAMPLE_COUNT; ++idx )
+            singleNoise[idx] = noiseFunc( positions[idx] );
+        double elapsed = GetCurrentTimeSeconds() - startSeconds;
+        return elapsed * nanosPerSample;
+    };
+    auto countMismatches = [&]()
+    {
+        int mismatches = 0;
+        for( int idx = 0; idx < SAMPLE_COUNT; ++idx )
+            mismatches += batchNoise[idx] != singleNoise[idx];
+        return mismatches;
+    };
+
+    for( int dimensions = 2; dimensions <= 4; ++dimensions )
+    {
+        double fractalNanos = 0.0;
+        double perlinNanos = 0.0;
+        double simplexNanos = 0.0;
+        double startSeconds = 0.0;
+        if( dimensions == 2 )
+        {
+            fractalNanos = timeSamples( [&]( const Vec4& pos ) {
+                return Noise::Compute2dFractal( pos.x, pos.y, scale, numOctaves ); } );
+            perlinNanos = timeSamples( [&]( const Vec4& pos ) {
+                return Noise::Compute2dPerlin( pos.x, pos.y, scale, numOctaves ); } );
+            simplexNanos = timeSamples( [&]( const Vec4& pos ) {
+                return Noise::Compute2dSimplex( pos.x, pos.y, scale, numOctaves ); } );
+            startSeconds = GetCurrentTimeSeconds();
+            Noise::Compute2dSimplexBatch( positions2d.data(), batchNoise.data(), SAMPLE_COUNT,
+                                          scale, numOctaves );
+        }
+        else if( dimensions == 3 )
+        {
+            fractalNanos = timeSamples( [&]( const Vec4& pos ) {
+                return Noise::Compute3dFractal( pos.x, pos.y, pos.z, scale, numOctaves ); } );
+            perlinNanos = timeSamples( [&]( const Vec4& pos ) {
+                return Noise::Compute3dPerlin( pos.x, pos.y, pos.z, scale, numOctaves ); } );
+            simplexNanos = timeSamples( [&]( const Vec4& pos ) {
+                return Noise::Compute3dSimplex( pos.x, pos.y, pos.z, scale, numOctaves ); } );
+            startSeconds = GetCurrentTimeSeconds();
+            Noise::Compute3dSimplexBatch( positions3d.data(), batchNoise.data(), SAMPLE_COUNT,
+                                          scale, numOctaves );
+        }
+        else
+        {
+            fractalNanos = timeSamples( [&]( const Vec4& pos ) {
+                return Noise::Compute4dFractal( pos.x, pos.y, pos.z, pos.w, scale, numOctaves ); } );
+            perlinNanos = timeSamples( [&]( const Vec4& pos ) {
+                return Noise::Compute4dPerlin( pos.x, pos.y, pos.z, pos.w, scale, numOctaves ); } );
+            simplexNanos = timeSamples( [&]( const Vec4& pos ) {
+                return Noise::Compute4dSimplex( pos.x, pos.y, pos.z, pos.w, scale, numOctaves ); } );
+            startSeconds = GetCurrentTimeSeconds();
+            Noise::Compute4dSimplexBatch( positions.data(), batchNoise.data(), SAMPLE_COUNT,
+                                          scale, numOctaves );
+        }
+        double batchNanos = ( GetCurrentTimeSeconds() - startSeconds ) * nanosPerSample;
+
+        g_console->Print( Stringf( "%dD noise ns/sample: fractal %.1f, perlin %.1f, simplex %.1f, "
+                                   "simplex batch %.1f (%d mismatches)", dimensions,
+                                   fractalNanos, perlinNanos, simplexNanos, batchNanos,
+                                   countMismatches() ) );
+    }
+}
+
 void RunTests()
 {
     SolverTests();
@@ -110,6 +869,14 @@ void RunTests()
     StringTests();
 
     IOTests();
+    MathKernelTests();
+    RaycastBatchTests();
+    GameObjectBVHTests();
+    SpatialHashGridTests();
+    TransformHierarchyTests();
+    EntityRegistryTests();
+    NoiseBatchTests();
+    NoiseBenchmarkTests();
 };
 
 // each update test is responsible of fetching its own clock